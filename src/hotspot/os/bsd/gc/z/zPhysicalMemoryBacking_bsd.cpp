@@ -179,3 +179,12 @@ void ZPhysicalMemoryBacking::unmap(uintptr_t addr, size_t size) const {
     fatal("Failed to map memory (%s)", err.to_string());
   }
 }
+
+void ZPhysicalMemoryBacking::collapse(uintptr_t addr, size_t size, uintptr_t offset) const {
+  // Transparent huge pages are not supported on this platform
+}
+
+bool ZPhysicalMemoryBacking::is_huge(uintptr_t offset, size_t size) const {
+  // Huge page backing is not tracked on this platform
+  return false;
+}
@@ -43,6 +43,9 @@ public:
 
   void map(uintptr_t addr, size_t size, uintptr_t offset) const;
   void unmap(uintptr_t addr, size_t size) const;
+
+  void collapse(uintptr_t addr, size_t size, uintptr_t offset) const;
+  bool is_huge(uintptr_t offset, size_t size) const;
 };
 
 #endif // OS_BSD_GC_Z_ZPHYSICALMEMORYBACKING_BSD_HPP
@@ -23,6 +23,7 @@
 
 #include "precompiled.hpp"
 #include "gc/shared/gcLogPrecious.hpp"
+#include "gc/shared/gc_globals.hpp"
 #include "gc/z/zArray.inline.hpp"
 #include "gc/z/zErrno.hpp"
 #include "gc/z/zGlobals.hpp"
@@ -30,8 +31,10 @@
 #include "gc/z/zMountPoint_linux.hpp"
 #include "gc/z/zNUMA.inline.hpp"
 #include "gc/z/zPhysicalMemoryBacking_linux.hpp"
+#include "gc/z/zStat.hpp"
 #include "gc/z/zSyscall_linux.hpp"
 #include "logging/log.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/init.hpp"
 #include "runtime/os.hpp"
 #include "runtime/safefetch.hpp"
@@ -76,6 +79,11 @@
 #define FALLOC_FL_PUNCH_HOLE             0x02
 #endif
 
+// madvise(2) flags
+#ifndef MADV_COLLAPSE
+#define MADV_COLLAPSE                    25
+#endif
+
 // Filesystem types, see statfs(2)
 #ifndef TMPFS_MAGIC
 #define TMPFS_MAGIC                      0x01021994
@@ -111,15 +119,27 @@ static const char* z_preferred_hugetlbfs_mountpoints[] = {
   NULL
 };
 
+static const ZStatCounter ZCounterHugePageCollapse("Memory", "Huge Page Collapse", ZStatUnitBytesPerSecond);
+static const ZStatCounter ZCounterHugePageCollapseFailed("Memory", "Huge Page Collapse Failed", ZStatUnitOpsPerSecond);
+
+// Collapsing is done synchronously when memory is mapped, which is on the
+// page allocation path, so the amount of memory collapsed per second is limited.
+static const size_t z_collapse_max_bytes_per_second = 64 * M;
+
 static int z_fallocate_hugetlbfs_attempts = 3;
 static bool z_fallocate_supported = true;
+static volatile bool z_collapse_supported = true;
+static volatile jlong z_collapse_second = 0;
+static volatile size_t z_collapse_budget = 0;
 
 ZPhysicalMemoryBacking::ZPhysicalMemoryBacking(size_t max_capacity) :
     _fd(-1),
     _filesystem(0),
     _block_size(0),
     _available(0),
-    _initialized(false) {
+    _initialized(false),
+    _huge(ZLargePages::is_transparent() ? max_capacity >> ZGranuleSizeShift : 0, mtGC),
+    _collapse_failed(ZLargePages::is_transparent() ? max_capacity >> ZGranuleSizeShift : 0, mtGC) {
 
   // Create backing file
   _fd = create_fd(ZFILENAME_HEAP);
@@ -195,6 +215,14 @@ ZPhysicalMemoryBacking::ZPhysicalMemoryBacking(size_t max_capacity) :
     return;
   }
 
+  // Collapsing is done one granule at a time, which only works
+  // if a transparent huge page is exactly one granule.
+  if (ZLargePages::is_transparent() && ZHugePageCollapse && os::large_page_size() != ZGranuleSize) {
+    log_info_p(gc, init)("Huge Page Collapse: Disabled (huge page size " SIZE_FORMAT "M, granule size " SIZE_FORMAT "M)",
+                         os::large_page_size() / M, ZGranuleSize / M);
+    Atomic::store(&z_collapse_supported, false);
+  }
+
   // Successfully initialized
   _initialized = true;
 }
@@ -701,15 +729,114 @@ size_t ZPhysicalMemoryBacking::uncommit(size_t offset, size_t length) const {
     return 0;
   }
 
+  if (ZLargePages::is_transparent()) {
+    // Memory committed here later might not be backed by huge pages,
+    // and is worth another attempt to collapse it
+    const size_t start = offset >> ZGranuleSizeShift;
+    const size_t end = (offset + length) >> ZGranuleSizeShift;
+    _huge.par_at_put_range(start, end, false);
+    _collapse_failed.par_at_put_range(start, end, false);
+  }
+
   return length;
 }
 
+static bool z_collapse_claim_budget() {
+  // Refill the budget once per second
+  const jlong second = os::javaTimeNanos() / NANOSECS_PER_SEC;
+  const jlong prev_second = Atomic::load(&z_collapse_second);
+  if (prev_second != second && Atomic::cmpxchg(&z_collapse_second, prev_second, second) == prev_second) {
+    Atomic::store(&z_collapse_budget, z_collapse_max_bytes_per_second);
+  }
+
+  // Claim one granule
+  size_t budget = Atomic::load(&z_collapse_budget);
+  while (budget >= ZGranuleSize) {
+    const size_t prev_budget = Atomic::cmpxchg(&z_collapse_budget, budget, budget - ZGranuleSize);
+    if (prev_budget == budget) {
+      return true;
+    }
+
+    budget = prev_budget;
+  }
+
+  // Budget exhausted
+  return false;
+}
+
+void ZPhysicalMemoryBacking::collapse(uintptr_t addr, size_t size, uintptr_t offset) const {
+  assert(ZLargePages::is_transparent(), "Should be enabled");
+
+  if (!ZHugePageCollapse || !Atomic::load(&z_collapse_supported)) {
+    return;
+  }
+
+  // Collapse granules that are not yet backed by huge pages now, rather
+  // than leaving it to khugepaged, which might take a long time to get
+  // to them. Granules that failed to collapse are left to khugepaged
+  // until they are uncommitted.
+  for (size_t i = 0; i < size; i += ZGranuleSize) {
+    const size_t index = (offset + i) >> ZGranuleSizeShift;
+    if (_huge.at(index) || _collapse_failed.at(index)) {
+      // Already backed by a huge page, or failed before
+      continue;
+    }
+
+    if (!z_collapse_claim_budget()) {
+      // Rate limited
+      return;
+    }
+
+    if (madvise((void*)(addr + i), ZGranuleSize, MADV_COLLAPSE) == -1) {
+      ZErrno err;
+      if (err == EINVAL) {
+        // Not supported by kernel
+        if (Atomic::cmpxchg(&z_collapse_supported, true, false)) {
+          log_info_p(gc)("Huge Page Collapse: Not supported by kernel (%s)", err.to_string());
+        }
+        return;
+      }
+
+      // Could not collapse, for example because memory is too fragmented.
+      // The granule is left backed by small pages.
+      _collapse_failed.par_set_bit(index);
+      ZStatInc(ZCounterHugePageCollapseFailed);
+      continue;
+    }
+
+    _huge.par_set_bit(index);
+    ZStatInc(ZCounterHugePageCollapse, ZGranuleSize);
+  }
+}
+
+bool ZPhysicalMemoryBacking::is_huge(uintptr_t offset, size_t size) const {
+  if (ZLargePages::is_explicit()) {
+    // Always backed by huge pages
+    return true;
+  }
+
+  if (!ZLargePages::is_transparent()) {
+    // Never backed by huge pages
+    return false;
+  }
+
+  const size_t start = offset >> ZGranuleSizeShift;
+  const size_t end = (offset + size) >> ZGranuleSizeShift;
+  return _huge.get_next_zero_offset(start, end) == end;
+}
+
 void ZPhysicalMemoryBacking::map(uintptr_t addr, size_t size, uintptr_t offset) const {
   const void* const res = mmap((void*)addr, size, PROT_READ|PROT_WRITE, MAP_FIXED|MAP_SHARED, _fd, offset);
   if (res == MAP_FAILED) {
     ZErrno err;
     fatal("Failed to map memory (%s)", err.to_string());
   }
+
+  if (ZLargePages::is_transparent()) {
+    // Advise the mapping to use transparent huge pages, which
+    // allows the kernel to map the memory using huge pages
+    os::realign_memory((char*)addr, size, os::large_page_size());
+  }
 }
 
 void ZPhysicalMemoryBacking::unmap(uintptr_t addr, size_t size) const {
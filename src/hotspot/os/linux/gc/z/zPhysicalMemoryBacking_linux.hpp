@@ -24,6 +24,8 @@
 #ifndef OS_LINUX_GC_Z_ZPHYSICALMEMORYBACKING_LINUX_HPP
 #define OS_LINUX_GC_Z_ZPHYSICALMEMORYBACKING_LINUX_HPP
 
+#include "utilities/bitMap.hpp"
+
 class ZErrno;
 
 class ZPhysicalMemoryBacking {
@@ -35,6 +37,11 @@ private:
   size_t   _available;
   bool     _initialized;
 
+  // Granules known to be backed by transparent huge pages, and
+  // granules that could not be collapsed into huge pages
+  mutable CHeapBitMap _huge;
+  mutable CHeapBitMap _collapse_failed;
+
   void warn_available_space(size_t max_capacity) const;
   void warn_max_map_count(size_t max_capacity) const;
 
@@ -72,6 +79,9 @@ public:
 
   void map(uintptr_t addr, size_t size, uintptr_t offset) const;
   void unmap(uintptr_t addr, size_t size) const;
+
+  void collapse(uintptr_t addr, size_t size, uintptr_t offset) const;
+  bool is_huge(uintptr_t offset, size_t size) const;
 };
 
 #endif // OS_LINUX_GC_Z_ZPHYSICALMEMORYBACKING_LINUX_HPP
@@ -250,3 +250,12 @@ void ZPhysicalMemoryBacking::unmap(uintptr_t addr, size_t size) const {
 
   _impl->unmap(addr, size);
 }
+
+void ZPhysicalMemoryBacking::collapse(uintptr_t addr, size_t size, uintptr_t offset) const {
+  // Transparent huge pages are not supported on this platform
+}
+
+bool ZPhysicalMemoryBacking::is_huge(uintptr_t offset, size_t size) const {
+  // Large pages are locked and always backed by huge pages
+  return ZLargePages::is_enabled();
+}
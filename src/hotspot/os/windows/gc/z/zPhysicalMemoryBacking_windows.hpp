@@ -46,6 +46,9 @@ public:
 
   void map(uintptr_t addr, size_t size, size_t offset) const;
   void unmap(uintptr_t addr, size_t size) const;
+
+  void collapse(uintptr_t addr, size_t size, uintptr_t offset) const;
+  bool is_huge(uintptr_t offset, size_t size) const;
 };
 
 #endif // OS_WINDOWS_GC_Z_ZPHYSICALMEMORYBACKING_WINDOWS_HPP
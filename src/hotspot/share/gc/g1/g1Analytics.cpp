@@ -94,6 +94,7 @@ G1Analytics::G1Analytics(const G1Predictions* predictor) :
     _pending_cards_seq(new TruncatedSeq(TruncatedSeqLength)),
     _rs_length_seq(new TruncatedSeq(TruncatedSeqLength)),
     _cost_per_byte_ms_during_cm_seq(new TruncatedSeq(TruncatedSeqLength)),
+    _live_bytes_after_young_gc_seq(new TruncatedSeq(TruncatedSeqLength)),
     _recent_prev_end_times_for_all_gcs_sec(new TruncatedSeq(NumPrevPausesForHeuristics)),
     _long_term_pause_time_ratio(0.0),
     _short_term_pause_time_ratio(0.0) {
@@ -225,6 +226,10 @@ void G1Analytics::report_rs_length(double rs_length) {
   _rs_length_seq->add(rs_length);
 }
 
+void G1Analytics::report_live_bytes_after_young_gc(double live_bytes) {
+  _live_bytes_after_young_gc_seq->add(live_bytes);
+}
+
 double G1Analytics::predict_alloc_rate_ms() const {
   return predict_zero_bounded(_alloc_rate_ms_seq);
 }
@@ -309,6 +314,22 @@ size_t G1Analytics::predict_pending_cards() const {
   return predict_size(_pending_cards_seq);
 }
 
+size_t G1Analytics::predict_live_bytes_after_young_gc() const {
+  double prediction = predict_zero_bounded(_live_bytes_after_young_gc_seq);
+  if (enough_samples_available(_live_bytes_after_young_gc_seq)) {
+    prediction = MAX2(prediction, _live_bytes_after_young_gc_seq->predict_next());
+  }
+  return (size_t)prediction;
+}
+
+int G1Analytics::num_live_bytes_after_young_gc() const {
+  return _live_bytes_after_young_gc_seq->num();
+}
+
+double G1Analytics::recent_avg_pause_time_ms() const {
+  return _recent_gc_times_ms->avg();
+}
+
 double G1Analytics::oldest_known_gc_end_time_sec() const {
   return _recent_prev_end_times_for_all_gcs_sec->oldest();
 }
@@ -72,6 +72,9 @@ class G1Analytics: public CHeapObj<mtGC> {
 
   TruncatedSeq* _cost_per_byte_ms_during_cm_seq;
 
+  // Heap occupancy in bytes directly after young-only and mixed gcs.
+  TruncatedSeq* _live_bytes_after_young_gc_seq;
+
   // Statistics kept per GC stoppage, pause or full.
   TruncatedSeq* _recent_prev_end_times_for_all_gcs_sec;
 
@@ -133,6 +136,7 @@ public:
   void report_constant_other_time_ms(double constant_other_time_ms);
   void report_pending_cards(double pending_cards);
   void report_rs_length(double rs_length);
+  void report_live_bytes_after_young_gc(double live_bytes);
 
   double predict_alloc_rate_ms() const;
   int num_alloc_rate_ms() const;
@@ -165,6 +169,15 @@ public:
   size_t predict_rs_length() const;
   size_t predict_pending_cards() const;
 
+  // Predicted heap occupancy after the next young gc. Takes the larger of the
+  // regular prediction and the linear trend of the recorded samples so that a
+  // growing live set is anticipated.
+  size_t predict_live_bytes_after_young_gc() const;
+  int num_live_bytes_after_young_gc() const;
+
+  // Average duration of the recently recorded gc pauses.
+  double recent_avg_pause_time_ms() const;
+
   // Add a new GC of the given duration and end time to the record.
   void update_recent_gc_times(double end_time_sec, double elapsed_ms);
   void compute_pause_time_ratios(double end_time_sec, double pause_time_ms);
@@ -402,6 +402,18 @@ void G1BlockOffsetTablePart::print_on(outputStream* out) {
 }
 #endif // !PRODUCT
 
+void G1BlockOffsetTablePart::update_for_block(HeapWord* blk_start, HeapWord* blk_end) {
+  size_t index = _bot->index_for(blk_start);
+  HeapWord* threshold = _bot->address_for_index_raw(index);
+  if (threshold < blk_start) {
+    index++;
+    threshold += BOTConstants::N_words;
+  }
+  if (blk_end > threshold) {
+    alloc_block_work(&threshold, &index, blk_start, blk_end);
+  }
+}
+
 HeapWord* G1BlockOffsetTablePart::initialize_threshold_raw() {
   _next_offset_index = _bot->index_for_raw(_hr->bottom());
   _next_offset_index++;
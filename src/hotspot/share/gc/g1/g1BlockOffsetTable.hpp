@@ -225,6 +225,11 @@ public:
     alloc_block(blk, blk+size);
   }
 
+  // Update the table for the block [blk_start, blk_end) without using or
+  // changing the allocation threshold. The entries for disjoint blocks may be
+  // updated in parallel.
+  void update_for_block(HeapWord* blk_start, HeapWord* blk_end);
+
   void set_for_starts_humongous(HeapWord* obj_top, size_t fill_size);
   void set_object_can_span(bool can_span) NOT_DEBUG_RETURN;
 
@@ -50,6 +50,19 @@ class G1CardTable : public CardTable {
 
   G1CardTableChangedListener _listener;
 
+  // Number of words of cards examined at once when skipping over uninteresting
+  // cards in the card search functions.
+  static const size_t CardSearchWordsPerStep = 4;
+
+  // Returns the offset in memory order of the first card in the given word of
+  // cards that has any of its bits set.
+  static inline size_t first_marked_card_in_word(size_t value);
+
+  // Whether the given card must be scanned during evacuation.
+  static bool is_card_to_scan(CardValue value) {
+    return (value & g1_card_already_scanned) == 0;
+  }
+
 public:
   enum G1CardValues {
     g1_young_gen = CT_MR_BS_last_reserved << 1,
@@ -107,6 +120,13 @@ public:
   // Change the given range of dirty cards to "which". All of these cards must be Dirty.
   inline void change_dirty_cards_to(size_t start_card_index, size_t num_cards, CardValue which);
 
+  // Returns the index of the first Dirty card in [start_card_index, end_card_index),
+  // or end_card_index if there is none. Examines a word of cards at a time.
+  inline size_t find_first_dirty_card(size_t start_card_index, size_t end_card_index) const;
+  // Returns the index of the first card that is not Dirty in [start_card_index,
+  // end_card_index), or end_card_index if there is none.
+  inline size_t find_first_non_dirty_card(size_t start_card_index, size_t end_card_index) const;
+
   inline uint region_idx_for(CardValue* p);
 
   static size_t compute_size(size_t mem_region_size_in_words) {
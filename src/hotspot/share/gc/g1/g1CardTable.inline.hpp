@@ -28,6 +28,10 @@
 #include "gc/g1/g1CardTable.hpp"
 
 #include "gc/g1/heapRegion.hpp"
+#include "gc/shared/memset_with_concurrent_readers.hpp"
+#include "utilities/align.hpp"
+#include "utilities/count_leading_zeros.hpp"
+#include "utilities/count_trailing_zeros.hpp"
 
 inline uint G1CardTable::region_idx_for(CardValue* p) {
   size_t const card_idx = pointer_delta(p, _byte_map, sizeof(CardValue));
@@ -53,6 +57,16 @@ inline size_t G1CardTable::mark_region_dirty(size_t start_card_index, size_t num
 
   size_t* cur_word = (size_t*)&_byte_map[start_card_index];
   size_t* const end_word_map = cur_word + num_chunks;
+  // Most of the area is expected to be Clean; dirty multiple words at once.
+  while (pointer_delta(end_word_map, cur_word, sizeof(size_t)) >= CardSearchWordsPerStep) {
+    if ((cur_word[0] & cur_word[1] & cur_word[2] & cur_word[3]) != WordAllClean) {
+      break;
+    }
+    STATIC_ASSERT(CardSearchWordsPerStep == 4);
+    cur_word[0] = cur_word[1] = cur_word[2] = cur_word[3] = WordAllDirty;
+    result += CardSearchWordsPerStep * sizeof(size_t);
+    cur_word += CardSearchWordsPerStep;
+  }
   while (cur_word < end_word_map) {
     size_t value = *cur_word;
     if (value == WordAllClean) {
@@ -80,13 +94,101 @@ inline size_t G1CardTable::mark_region_dirty(size_t start_card_index, size_t num
 
 inline void G1CardTable::change_dirty_cards_to(size_t start_card_index, size_t num_cards, CardValue which) {
   CardValue* start = &_byte_map[start_card_index];
+#ifdef ASSERT
   CardValue* const end = start + num_cards;
-  while (start < end) {
-    CardValue value = *start;
+  for (CardValue* cur = start; cur < end; cur++) {
+    CardValue value = *cur;
     assert(value == dirty_card_val(),
-           "Must have been dirty %d start " PTR_FORMAT " " PTR_FORMAT, value, p2i(start), p2i(end));
-    *start++ = which;
+           "Must have been dirty %d start " PTR_FORMAT " " PTR_FORMAT, value, p2i(cur), p2i(end));
+  }
+#endif
+  memset_with_concurrent_readers(start, which, num_cards);
+}
+
+inline size_t G1CardTable::first_marked_card_in_word(size_t value) {
+  assert(value != 0, "Must have a marked card");
+#ifdef VM_LITTLE_ENDIAN
+  return count_trailing_zeros(value) / BitsPerByte;
+#else
+  return count_leading_zeros(value) / BitsPerByte;
+#endif
+}
+
+inline size_t G1CardTable::find_first_dirty_card(size_t start_card_index, size_t end_card_index) const {
+  assert(start_card_index <= end_card_index, "precondition");
+  size_t cur = start_card_index;
+
+  while (cur < end_card_index && !is_aligned(&_byte_map[cur], sizeof(size_t))) {
+    if (is_card_to_scan(_byte_map[cur])) {
+      return cur;
+    }
+    cur++;
+  }
+
+  // A word of cards contains a Dirty card if any of its cards has the
+  // already scanned bit cleared. Skip over multiple words without Dirty cards
+  // at once, then locate the card within the word.
+  size_t const cards_per_step = CardSearchWordsPerStep * sizeof(size_t);
+  while (end_card_index - cur >= cards_per_step) {
+    const size_t* words = (const size_t*)&_byte_map[cur];
+    if ((~(words[0] & words[1] & words[2] & words[3]) & WordAlreadyScanned) != 0) {
+      break;
+    }
+    cur += cards_per_step;
+  }
+  while (end_card_index - cur >= sizeof(size_t)) {
+    size_t const to_scan = ~*(const size_t*)&_byte_map[cur] & WordAlreadyScanned;
+    if (to_scan != 0) {
+      return cur + first_marked_card_in_word(to_scan);
+    }
+    cur += sizeof(size_t);
+  }
+
+  while (cur < end_card_index) {
+    if (is_card_to_scan(_byte_map[cur])) {
+      return cur;
+    }
+    cur++;
+  }
+  return end_card_index;
+}
+
+inline size_t G1CardTable::find_first_non_dirty_card(size_t start_card_index, size_t end_card_index) const {
+  assert(start_card_index <= end_card_index, "precondition");
+  size_t cur = start_card_index;
+
+  while (cur < end_card_index && !is_aligned(&_byte_map[cur], sizeof(size_t))) {
+    if (!is_card_to_scan(_byte_map[cur])) {
+      return cur;
+    }
+    cur++;
+  }
+
+  // A word of cards contains a non-Dirty card if any of its cards has the
+  // already scanned bit set.
+  size_t const cards_per_step = CardSearchWordsPerStep * sizeof(size_t);
+  while (end_card_index - cur >= cards_per_step) {
+    const size_t* words = (const size_t*)&_byte_map[cur];
+    if (((words[0] | words[1] | words[2] | words[3]) & WordAlreadyScanned) != 0) {
+      break;
+    }
+    cur += cards_per_step;
+  }
+  while (end_card_index - cur >= sizeof(size_t)) {
+    size_t const scanned = *(const size_t*)&_byte_map[cur] & WordAlreadyScanned;
+    if (scanned != 0) {
+      return cur + first_marked_card_in_word(scanned);
+    }
+    cur += sizeof(size_t);
+  }
+
+  while (cur < end_card_index) {
+    if (!is_card_to_scan(_byte_map[cur])) {
+      return cur;
+    }
+    cur++;
   }
+  return end_card_index;
 }
 
 #endif /* SHARE_GC_G1_G1CARDTABLE_INLINE_HPP */
@@ -97,6 +97,7 @@
 #include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
 #include "oops/access.inline.hpp"
+#include "oops/arrayOop.hpp"
 #include "oops/compressedOops.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/atomic.hpp"
@@ -110,6 +111,7 @@
 #include "utilities/autoRestore.hpp"
 #include "utilities/bitMap.inline.hpp"
 #include "utilities/globalDefinitions.hpp"
+#include "utilities/spinYield.hpp"
 #include "utilities/stack.inline.hpp"
 
 size_t G1CollectedHeap::_humongous_object_threshold_in_words = 0;
@@ -188,6 +190,31 @@ HeapRegion* G1CollectedHeap::new_region(size_t word_size,
   return res;
 }
 
+void G1CollectedHeap::release_humongous_tail_memory(HeapRegion* last_hr, HeapWord* obj_top) {
+  // The tail of the last region is covered by a single filler array whose
+  // contents are never read, so the pages backing its body can be given back
+  // to the operating system. They are transparently faulted in again once
+  // the region is reused. Freeing maps anonymous memory over the range, so
+  // leave file-backed heaps (AllocateHeapAt) alone.
+  if (UseLargePages || AlwaysPreTouch || AllocateHeapAt != NULL) {
+    return;
+  }
+  assert(pointer_delta(last_hr->end(), obj_top) <= filler_array_max_size(),
+         "tail must be covered by a single filler object");
+
+  // Keep the complete header of the filler array, including its length,
+  // below the first released page. Its size depends on the compressed
+  // class pointers setting.
+  size_t page_size = os::vm_page_size();
+  char* start = align_up((char*)(obj_top + arrayOopDesc::header_size(T_INT)), page_size);
+  char* end = align_down((char*)last_hr->end(), page_size);
+  if (start < end) {
+    size_t size = pointer_delta(end, start, sizeof(char));
+    os::free_memory(start, size, page_size);
+    _numa->request_memory_on_node(start, size, last_hr->hrm_index());
+  }
+}
+
 HeapWord*
 G1CollectedHeap::humongous_obj_allocate_initialize_regions(HeapRegion* first_hr,
                                                            uint num_regions,
@@ -243,6 +270,9 @@ G1CollectedHeap::humongous_obj_allocate_initialize_regions(HeapRegion* first_hr,
 
   if (word_fill_size >= min_fill_size()) {
     fill_with_objects(obj_top, word_fill_size);
+    if (G1ReduceHumongousWaste) {
+      release_humongous_tail_memory(region_at(last), obj_top);
+    }
   } else if (word_fill_size > 0) {
     // We have space to fill, but we cannot fit an object there.
     words_not_fillable = word_fill_size;
@@ -1359,6 +1389,10 @@ void G1CollectedHeap::shrink(size_t shrink_bytes) {
   // below will make sure of that and do any remaining clean up.
   _allocator->abandon_gc_alloc_regions();
 
+  shrink_free_regions(shrink_bytes);
+}
+
+void G1CollectedHeap::shrink_free_regions(size_t shrink_bytes) {
   // Instead of tearing down / rebuilding the free lists here, we
   // could instead use the remove_all_pending() method on free_list to
   // remove only the ones that we need to remove.
@@ -1477,6 +1511,7 @@ G1CollectedHeap::G1CollectedHeap() :
   _cr(NULL),
   _task_queues(NULL),
   _num_regions_failed_evacuation(0),
+  _evacuation_alloc_failed(false),
   _regions_failed_evacuation(NULL),
   _evacuation_failed_info_array(NULL),
   _preserved_marks_set(true /* in_c_heap */),
@@ -1770,7 +1805,7 @@ jint G1CollectedHeap::initialize() {
 
   _collection_set.initialize(max_reserved_regions());
 
-  _regions_failed_evacuation = NEW_C_HEAP_ARRAY(volatile bool, max_regions(), mtGC);
+  _regions_failed_evacuation = NEW_C_HEAP_ARRAY(volatile uint8_t, max_regions(), mtGC);
 
   G1InitLogger::print();
 
@@ -2366,6 +2401,21 @@ bool G1CollectedHeap::supports_concurrent_gc_breakpoints() const {
   return true;
 }
 
+bool G1CollectedHeap::supports_object_pinning() const {
+  return G1UseRegionPinning;
+}
+
+oop G1CollectedHeap::pin_object(JavaThread* thread, oop obj) {
+  assert(G1UseRegionPinning, "must be");
+  heap_region_containing(obj)->increment_pinned_object_count();
+  return obj;
+}
+
+void G1CollectedHeap::unpin_object(JavaThread* thread, oop obj) {
+  assert(G1UseRegionPinning, "must be");
+  heap_region_containing(obj)->decrement_pinned_object_count();
+}
+
 bool G1CollectedHeap::is_archived_object(oop object) const {
   return object != NULL && heap_region_containing(object)->is_archive();
 }
@@ -2618,6 +2668,7 @@ void G1CollectedHeap::gc_epilogue(bool full) {
   Universe::heap()->update_capacity_and_used_at_gc();
 
   // Print NUMA statistics.
+  _numa->update_occupancy_statistics();
   _numa->print_statistics();
 
   _collection_pause_end = Ticks::now();
@@ -2852,16 +2903,33 @@ void G1CollectedHeap::verify_after_young_collection(G1HeapVerifier::G1VerifyType
   verify_numa_regions("GC End");
 }
 
-void G1CollectedHeap::expand_heap_after_young_collection(){
-  size_t expand_bytes = _heap_sizing_policy->young_collection_expansion_amount();
-  if (expand_bytes > 0) {
+void G1CollectedHeap::resize_heap_after_young_collection() {
+  bool should_expand;
+  size_t resize_bytes = _heap_sizing_policy->young_collection_resize_amount(should_expand);
+  if (resize_bytes == 0) {
+    return;
+  }
+
+  if (should_expand) {
     // No need for an ergo logging here,
     // expansion_amount() does this when it returns a value > 0.
     double expand_ms = 0.0;
-    if (!expand(expand_bytes, _workers, &expand_ms)) {
+    if (!expand(resize_bytes, _workers, &expand_ms)) {
       // We failed to expand the heap. Cannot do anything about it.
     }
     phase_times()->record_expand_heap_time(expand_ms);
+  } else if (!collector_state()->in_concurrent_start_gc() &&
+             !collector_state()->mark_or_rebuild_in_progress()) {
+    // Do not shrink in the pause that starts concurrent marking, or while
+    // concurrent marking or remembered set rebuilding may still look at the
+    // regions; Remark resizes the heap for these anyway. The former is not
+    // yet covered by mark_or_rebuild_in_progress(), which is only set at the
+    // end of the pause. The removed regions are uncommitted concurrently, in
+    // bounded batches, by the G1UncommitRegionTask.
+    Ticks start = Ticks::now();
+    shrink_free_regions(resize_bytes);
+    uncommit_regions_if_necessary();
+    phase_times()->record_shrink_heap_time((Ticks::now() - start).seconds() * MILLIUNITS);
   }
 }
 
@@ -3023,7 +3091,7 @@ void G1CollectedHeap::do_collection_pause_at_safepoint_helper(double target_paus
 
         _allocator->init_mutator_alloc_regions();
 
-        expand_heap_after_young_collection();
+        resize_heap_after_young_collection();
 
         // Refine the type of a concurrent mark operation now that we did the
         // evacuation, eventually aborting it.
@@ -3044,8 +3112,10 @@ void G1CollectedHeap::do_collection_pause_at_safepoint_helper(double target_paus
     }
 
     // Print the remainder of the GC log output.
-    if (evacuation_failed()) {
+    if (evacuation_alloc_failed()) {
       log_info(gc)("To-space exhausted");
+    } else if (evacuation_failed()) {
+      log_info(gc)("Retained %u regions with pinned objects", num_regions_failed_evacuation());
     }
 
     policy()->print_phases();
@@ -3089,6 +3159,25 @@ void G1CollectedHeap::preserve_mark_during_evac_failure(uint worker_id, oop obj,
   _preserved_marks_set.get(worker_id)->push_if_necessary(obj, m);
 }
 
+void G1CollectedHeap::record_evac_failure_object(oop obj) {
+  _cm->par_mark_in_prev_bitmap(obj);
+}
+
+void G1CollectedHeap::prepare_region_for_evac_failure(HeapRegion* hr) {
+  // Old regions have marks below PTAMS, some of which may belong to objects
+  // that were evacuated successfully. Young regions may still have marks
+  // from a previous use of the region, as the prev bitmap is not cleared
+  // when a region is freed. Clear the whole region.
+  _cm->clear_range_in_prev_bitmap(MemRegion(hr->bottom(), hr->end()));
+}
+
+void G1CollectedHeap::wait_for_region_evac_failure_prepared(uint region_idx) {
+  SpinYield spin_yield;
+  while (Atomic::load_acquire(&_regions_failed_evacuation[region_idx]) != RegionEvacFailed) {
+    spin_yield.wait();
+  }
+}
+
 bool G1ParEvacuateFollowersClosure::offer_termination() {
   EventGCPhaseParallel event;
   G1ParScanThreadState* const pss = par_scan_state();
@@ -3116,6 +3205,10 @@ void G1CollectedHeap::complete_cleaning(BoolObjectClosure* is_alive,
   uint num_workers = workers()->active_workers();
   G1ParallelCleaningTask unlink_task(is_alive, num_workers, class_unloading_occurred);
   workers()->run_task(&unlink_task);
+
+  if (class_unloading_occurred && policy()->pretenure_table() != NULL) {
+    policy()->pretenure_table()->remove_unloaded_klasses();
+  }
 }
 
 // Weak Reference Processing support
@@ -3368,6 +3461,10 @@ class G1PrepareEvacuationTask : public AbstractGangTask {
       if (!region->rem_set()->is_complete()) {
         return false;
       }
+      // Objects pinned by JNI critical sections are in use by native code.
+      if (region->has_pinned_objects()) {
+        return false;
+      }
       // Candidate selection must satisfy the following constraints
       // while concurrent marking is in progress:
       //
@@ -3495,8 +3592,9 @@ void G1CollectedHeap::pre_evacuate_collection_set(G1EvacuationInfo& evacuation_i
 
   _expand_heap_after_alloc_failure = true;
   Atomic::store(&_num_regions_failed_evacuation, 0u);
+  Atomic::store(&_evacuation_alloc_failed, false);
 
-  memset((void*)_regions_failed_evacuation, false, sizeof(bool) * max_regions());
+  memset((void*)_regions_failed_evacuation, RegionEvacSucceeded, sizeof(uint8_t) * max_regions());
 
   // Disable the hot card cache.
   _hot_card_cache->reset_hot_cache_claimed_index();
@@ -3726,7 +3824,7 @@ void G1CollectedHeap::evacuate_next_optional_regions(G1ParScanThreadStateSet* pe
 void G1CollectedHeap::evacuate_optional_collection_set(G1ParScanThreadStateSet* per_thread_states) {
   const double gc_start_time_ms = phase_times()->cur_collection_start_sec() * 1000.0;
 
-  while (!evacuation_failed() && _collection_set.optional_region_length() > 0) {
+  while (!evacuation_alloc_failed() && _collection_set.optional_region_length() > 0) {
 
     double time_used_ms = os::elapsedTime() * 1000.0 - gc_start_time_ms;
     double time_left_ms = MaxGCPauseMillis - time_used_ms;
@@ -3789,6 +3887,7 @@ void G1CollectedHeap::post_evacuate_collection_set(G1EvacuationInfo& evacuation_
   evacuation_info.set_bytes_used(_bytes_used_during_gc);
 
   policy()->print_age_table();
+  policy()->update_pretenure_decisions();
 }
 
 void G1CollectedHeap::record_obj_copy_mem_stats() {
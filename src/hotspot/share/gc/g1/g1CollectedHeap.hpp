@@ -422,6 +422,10 @@ private:
                                                       uint num_regions,
                                                       size_t word_size);
 
+  // Give the memory backing the body of the filler object after obj_top in
+  // the last region of a humongous object back to the operating system.
+  void release_humongous_tail_memory(HeapRegion* last_hr, HeapWord* obj_top);
+
   // Attempt to allocate a humongous object of the given size. Return
   // NULL if unsuccessful.
   HeapWord* humongous_obj_allocate(size_t word_size);
@@ -756,6 +760,9 @@ private:
   // (Rounds down to a HeapRegion boundary.)
   void shrink(size_t shrink_bytes);
   void shrink_helper(size_t expand_bytes);
+  // Shrink the heap by removing free regions only, keeping any GC alloc
+  // regions. Used at the end of young collections.
+  void shrink_free_regions(size_t shrink_bytes);
 
   #if TASKQUEUE_STATS
   static void print_taskqueue_stats_hdr(outputStream* const st);
@@ -830,7 +837,7 @@ public:
                                     G1RedirtyCardsQueueSet* rdcqs,
                                     G1ParScanThreadStateSet* pss);
 
-  void expand_heap_after_young_collection();
+  void resize_heap_after_young_collection();
   // Update object copying statistics.
   void record_obj_copy_mem_stats();
 
@@ -867,8 +874,22 @@ public:
 
   // Number of regions evacuation failed in the current collection.
   volatile uint _num_regions_failed_evacuation;
+  // Whether evacuation failed in the current collection because of running
+  // out of space, as opposed to failing only for regions with pinned objects.
+  volatile bool _evacuation_alloc_failed;
   // Records for every region on the heap whether evacuation failed for it.
-  volatile bool* _regions_failed_evacuation;
+  // The first thread encountering an evacuation failure in a region prepares
+  // it for recording the objects that failed evacuation; other threads failing
+  // evacuation in the same region wait until it is done.
+  static const uint8_t RegionEvacSucceeded = 0;
+  static const uint8_t RegionEvacFailurePreparing = 1;
+  static const uint8_t RegionEvacFailed = 2;
+  volatile uint8_t* _regions_failed_evacuation;
+
+  // Clear stale marks from the prev bitmap of the given region, so that it
+  // can be used to record the objects failing evacuation.
+  void prepare_region_for_evac_failure(HeapRegion* hr);
+  void wait_for_region_evac_failure_prepared(uint region_idx);
 
   EvacuationFailedInfo* _evacuation_failed_info_array;
 
@@ -877,6 +898,9 @@ public:
   // Preserve the mark of "obj", if necessary, in preparation for its mark
   // word being overwritten with a self-forwarding-pointer.
   void preserve_mark_during_evac_failure(uint worker_id, oop obj, markWord m);
+  // Record "obj" as failed to evacuate in the prev bitmap of its region. Post
+  // evacuation only visits these objects instead of walking the whole region.
+  void record_evac_failure_object(oop obj);
 
 #ifndef PRODUCT
   // Support for forcing evacuation failures. Analogous to
@@ -1152,6 +1176,10 @@ public:
   inline bool evacuation_failed(uint region_idx) const;
 
   inline uint num_regions_failed_evacuation() const;
+  // True iff an evacuation failed in the most-recent collection because there
+  // was not enough space to copy an object to.
+  inline bool evacuation_alloc_failed() const;
+  inline void set_evacuation_alloc_failed();
   // Notify that the garbage collection encountered an evacuation failure in the
   // given region. Returns whether this has been the first occurrence of an evacuation
   // failure in that region.
@@ -1441,6 +1469,11 @@ public:
   // WhiteBox testing support.
   virtual bool supports_concurrent_gc_breakpoints() const;
 
+  // Support for pinning the region containing an object in JNI critical sections.
+  virtual bool supports_object_pinning() const;
+  virtual oop pin_object(JavaThread* thread, oop obj);
+  virtual void unpin_object(JavaThread* thread, oop obj);
+
   virtual WorkGang* safepoint_workers() { return _workers; }
 
   virtual bool is_archived_object(oop object) const;
@@ -197,22 +197,40 @@ bool G1CollectedHeap::evacuation_failed() const {
 bool G1CollectedHeap::evacuation_failed(uint region_idx) const {
   assert(region_idx < max_regions(), "Invalid region index %u", region_idx);
 
-  return Atomic::load(&_regions_failed_evacuation[region_idx]);
+  return Atomic::load(&_regions_failed_evacuation[region_idx]) != RegionEvacSucceeded;
 }
 
 uint G1CollectedHeap::num_regions_failed_evacuation() const {
   return Atomic::load(&_num_regions_failed_evacuation);
 }
 
+bool G1CollectedHeap::evacuation_alloc_failed() const {
+  return Atomic::load(&_evacuation_alloc_failed);
+}
+
+void G1CollectedHeap::set_evacuation_alloc_failed() {
+  if (!Atomic::load(&_evacuation_alloc_failed)) {
+    Atomic::store(&_evacuation_alloc_failed, true);
+  }
+}
+
 bool G1CollectedHeap::notify_region_failed_evacuation(uint const region_idx) {
   assert(region_idx < max_regions(), "Invalid region index %u", region_idx);
 
-  volatile bool* region_failed_addr = &_regions_failed_evacuation[region_idx];
-  bool result = !Atomic::load(region_failed_addr) && !Atomic::cmpxchg(region_failed_addr, false, true, memory_order_relaxed);
-  if (result) {
+  volatile uint8_t* region_state_addr = &_regions_failed_evacuation[region_idx];
+  uint8_t const state = Atomic::load_acquire(region_state_addr);
+  if (state == RegionEvacFailed) {
+    return false;
+  }
+  if (state == RegionEvacSucceeded &&
+      Atomic::cmpxchg(region_state_addr, RegionEvacSucceeded, RegionEvacFailurePreparing, memory_order_relaxed) == RegionEvacSucceeded) {
     Atomic::inc(&_num_regions_failed_evacuation, memory_order_relaxed);
+    prepare_region_for_evac_failure(region_at(region_idx));
+    Atomic::release_store(region_state_addr, RegionEvacFailed);
+    return true;
   }
-  return result;
+  wait_for_region_evac_failure_prepared(region_idx);
+  return false;
 }
 
 #ifndef PRODUCT
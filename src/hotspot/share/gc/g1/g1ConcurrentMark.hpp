@@ -561,9 +561,9 @@ public:
   void swap_mark_bitmaps();
 
   void cleanup();
-  // Mark in the previous bitmap. Caution: the prev bitmap is usually read-only, so use
-  // this carefully.
-  inline void mark_in_prev_bitmap(oop p);
+  // Mark in the previous bitmap; may be called by multiple threads in parallel.
+  // Caution: the prev bitmap is usually read-only, so use this carefully.
+  inline void par_mark_in_prev_bitmap(oop p);
 
   // Clears marks for all objects in the given range, for the prev or
   // next bitmaps.  Caution: the previous bitmap is usually
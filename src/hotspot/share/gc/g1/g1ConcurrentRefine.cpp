@@ -321,25 +321,6 @@ uint G1ConcurrentRefine::max_num_threads() {
   return G1ConcRefinementThreads;
 }
 
-static size_t calc_new_green_zone(size_t green,
-                                  double logged_cards_scan_time,
-                                  size_t processed_logged_cards,
-                                  double goal_ms) {
-  // Adjust green zone based on whether we're meeting the time goal.
-  // Limit to max_green_zone.
-  const double inc_k = 1.1, dec_k = 0.9;
-  if (logged_cards_scan_time > goal_ms) {
-    if (green > 0) {
-      green = static_cast<size_t>(green * dec_k);
-    }
-  } else if (logged_cards_scan_time < goal_ms &&
-             processed_logged_cards > green) {
-    green = static_cast<size_t>(MAX2(green * inc_k, green + 1.0));
-    green = MIN2(green, max_green_zone);
-  }
-  return green;
-}
-
 static size_t calc_new_yellow_zone(size_t green, size_t min_yellow_size) {
   size_t size = green * 2;
   size = MAX2(size, min_yellow_size);
@@ -350,21 +331,18 @@ static size_t calc_new_red_zone(size_t green, size_t yellow) {
   return MIN2(yellow + (yellow - green), max_red_zone);
 }
 
-void G1ConcurrentRefine::update_zones(double logged_cards_scan_time,
-                                      size_t processed_logged_cards,
-                                      double goal_ms) {
+size_t G1ConcurrentRefine::max_green_zone_value() {
+  return max_green_zone;
+}
+
+void G1ConcurrentRefine::update_zones(size_t pending_cards_target) {
   log_trace( CTRL_TAGS )("Updating Refinement Zones: "
-                         "logged cards scan time: %.3fms, "
-                         "processed cards: " SIZE_FORMAT ", "
-                         "goal time: %.3fms",
-                         logged_cards_scan_time,
-                         processed_logged_cards,
-                         goal_ms);
-
-  _green_zone = calc_new_green_zone(_green_zone,
-                                    logged_cards_scan_time,
-                                    processed_logged_cards,
-                                    goal_ms);
+                         "pending cards target: " SIZE_FORMAT,
+                         pending_cards_target);
+
+  // Leave up to the number of cards the next pause can process within its
+  // goal to the pause; refinement threads are activated only for the excess.
+  _green_zone = MIN2(pending_cards_target, max_green_zone);
   _yellow_zone = calc_new_yellow_zone(_green_zone, _min_yellow_zone_size);
   _red_zone = calc_new_red_zone(_green_zone, _yellow_zone);
 
@@ -376,13 +354,11 @@ void G1ConcurrentRefine::update_zones(double logged_cards_scan_time,
             _green_zone, _yellow_zone, _red_zone);
 }
 
-void G1ConcurrentRefine::adjust(double logged_cards_scan_time,
-                                size_t processed_logged_cards,
-                                double goal_ms) {
+void G1ConcurrentRefine::adjust(size_t pending_cards_target) {
   G1DirtyCardQueueSet& dcqs = G1BarrierSet::dirty_card_queue_set();
 
   if (G1UseAdaptiveConcRefinement) {
-    update_zones(logged_cards_scan_time, processed_logged_cards, goal_ms);
+    update_zones(pending_cards_target);
 
     // Change the barrier params
     if (max_num_threads() == 0) {
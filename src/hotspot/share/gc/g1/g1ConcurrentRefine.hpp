@@ -75,7 +75,10 @@ class G1ConcurrentRefine : public CHeapObj<mtGC> {
    * The value of the completed dirty card queue length falls into one of 3 zones:
    * green, yellow, red. If the value is in [0, green) nothing is
    * done, the buffered cards are left unprocessed to enable the caching effect of the
-   * dirtied cards. In the yellow zone [green, yellow) the concurrent refinement
+   * dirtied cards. With G1UseAdaptiveConcRefinement the green zone is the
+   * number of pending cards the next pause is predicted to be able to process
+   * within its time budget, so that refinement only starts when the pause
+   * could not handle the cards itself. In the yellow zone [green, yellow) the concurrent refinement
    * threads are gradually activated. In [yellow, red) all threads are
    * running. If the length becomes red (max queue length) the mutators start
    * processing cards too.
@@ -98,10 +101,9 @@ class G1ConcurrentRefine : public CHeapObj<mtGC> {
                      size_t red_zone,
                      size_t min_yellow_zone_size);
 
-  // Update green/yellow/red zone values based on how well goals are being met.
-  void update_zones(double logged_cards_scan_time,
-                    size_t processed_logged_cards,
-                    double goal_ms);
+  // Update green/yellow/red zone values based on the number of pending cards
+  // the next pause can afford to process.
+  void update_zones(size_t pending_cards_target);
 
   static uint worker_id_offset();
   void maybe_activate_more_threads(uint worker_id, size_t num_cur_cards);
@@ -116,8 +118,9 @@ public:
 
   void stop();
 
-  // Adjust refinement thresholds based on work done during the pause and the goal time.
-  void adjust(double logged_cards_scan_time, size_t processed_logged_cards, double goal_ms);
+  // Adjust refinement thresholds based on the number of pending cards the
+  // next pause is predicted to be able to process within its time goal.
+  void adjust(size_t pending_cards_target);
 
   // Return total of concurrent refinement stats for the
   // ConcurrentRefineThreads.  Also reset the stats for the threads.
@@ -138,6 +141,9 @@ public:
   // Maximum number of refinement threads.
   static uint max_num_threads();
 
+  // Upper bound for the green zone, and so the pending cards target.
+  static size_t max_green_zone_value();
+
   // Cards in the dirty card queue set.
   size_t green_zone() const      { return _green_zone;  }
   size_t yellow_zone() const     { return _yellow_zone; }
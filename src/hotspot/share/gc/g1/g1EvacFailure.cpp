@@ -30,12 +30,14 @@
 #include "gc/g1/g1HeapVerifier.hpp"
 #include "gc/g1/g1OopClosures.inline.hpp"
 #include "gc/g1/g1RedirtyCardsQueue.hpp"
+#include "gc/g1/g1_globals.hpp"
 #include "gc/g1/heapRegion.hpp"
 #include "gc/g1/heapRegionRemSet.hpp"
 #include "gc/shared/preservedMarks.inline.hpp"
 #include "oops/access.inline.hpp"
 #include "oops/compressedOops.inline.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/atomic.hpp"
 
 class UpdateLogBuffersDeferred : public BasicOopIterateClosure {
 private:
@@ -84,7 +86,6 @@ class RemoveSelfForwardPtrObjClosure: public ObjectClosure {
   UpdateLogBuffersDeferred* _log_buffer_cl;
   bool _during_concurrent_start;
   uint _worker_id;
-  HeapWord* _last_forwarded_object_end;
 
 public:
   RemoveSelfForwardPtrObjClosure(HeapRegion* hr,
@@ -97,89 +98,77 @@ public:
     _marked_bytes(0),
     _log_buffer_cl(log_buffer_cl),
     _during_concurrent_start(during_concurrent_start),
-    _worker_id(worker_id),
-    _last_forwarded_object_end(hr->bottom()) { }
+    _worker_id(worker_id) { }
 
   size_t marked_bytes() { return _marked_bytes; }
 
-  // Iterate over the live objects in the region to find self-forwarded objects
-  // that need to be kept live. We need to update the remembered sets of these
-  // objects. Further update the BOT and marks.
-  // We can coalesce and overwrite the remaining heap contents with dummy objects
-  // as they have either been dead or evacuated (which are unreferenced now, i.e.
-  // dead too) already.
+  // Handle an object that failed to move. We need to update the remembered sets
+  // of these objects. Further update the BOT and marks.
   void do_object(oop obj) {
     HeapWord* obj_addr = cast_from_oop<HeapWord*>(obj);
     assert(_hr->is_in(obj_addr), "sanity");
-
-    if (obj->is_forwarded() && obj->forwardee() == obj) {
-      // The object failed to move.
-
-      zap_dead_objects(_last_forwarded_object_end, obj_addr);
-      // We consider all objects that we find self-forwarded to be
-      // live. What we'll do is that we'll update the prev marking
-      // info so that they are all under PTAMS and explicitly marked.
-      if (!_cm->is_marked_in_prev_bitmap(obj)) {
-        _cm->mark_in_prev_bitmap(obj);
-      }
-      if (_during_concurrent_start) {
-        // For the next marking info we'll only mark the
-        // self-forwarded objects explicitly if we are during
-        // concurrent start (since, normally, we only mark objects pointed
-        // to by roots if we succeed in copying them). By marking all
-        // self-forwarded objects we ensure that we mark any that are
-        // still pointed to be roots. During concurrent marking, and
-        // after concurrent start, we don't need to mark any objects
-        // explicitly and all objects in the CSet are considered
-        // (implicitly) live. So, we won't mark them explicitly and
-        // we'll leave them over NTAMS.
-        _cm->mark_in_next_bitmap(_worker_id, _hr, obj);
-      }
-      size_t obj_size = obj->size();
-
-      _marked_bytes += (obj_size * HeapWordSize);
-      PreservedMarks::init_forwarded_mark(obj);
-
-      // While we were processing RSet buffers during the collection,
-      // we actually didn't scan any cards on the collection set,
-      // since we didn't want to update remembered sets with entries
-      // that point into the collection set, given that live objects
-      // from the collection set are about to move and such entries
-      // will be stale very soon.
-      // This change also dealt with a reliability issue which
-      // involved scanning a card in the collection set and coming
-      // across an array that was being chunked and looking malformed.
-      // The problem is that, if evacuation fails, we might have
-      // remembered set entries missing given that we skipped cards on
-      // the collection set. So, we'll recreate such entries now.
-      obj->oop_iterate(_log_buffer_cl);
-
-      HeapWord* obj_end = obj_addr + obj_size;
-      _last_forwarded_object_end = obj_end;
-      _hr->cross_threshold(obj_addr, obj_end);
+    assert(obj->is_forwarded() && obj->forwardee() == obj,
+           "Object " PTR_FORMAT " recorded as failed must be self-forwarded", p2i(obj));
+
+    // We consider all objects that we find self-forwarded to be
+    // live. They have already been marked on the prev bitmap during
+    // evacuation; the prev marking info will be updated so that they
+    // are all under PTAMS.
+    assert(_cm->is_marked_in_prev_bitmap(obj), "Object " PTR_FORMAT " must be marked", p2i(obj));
+    if (_during_concurrent_start) {
+      // For the next marking info we'll only mark the
+      // self-forwarded objects explicitly if we are during
+      // concurrent start (since, normally, we only mark objects pointed
+      // to by roots if we succeed in copying them). By marking all
+      // self-forwarded objects we ensure that we mark any that are
+      // still pointed to be roots. During concurrent marking, and
+      // after concurrent start, we don't need to mark any objects
+      // explicitly and all objects in the CSet are considered
+      // (implicitly) live. So, we won't mark them explicitly and
+      // we'll leave them over NTAMS.
+      _cm->mark_in_next_bitmap(_worker_id, _hr, obj);
     }
+    size_t obj_size = obj->size();
+
+    _marked_bytes += (obj_size * HeapWordSize);
+    PreservedMarks::init_forwarded_mark(obj);
+
+    // While we were processing RSet buffers during the collection,
+    // we actually didn't scan any cards on the collection set,
+    // since we didn't want to update remembered sets with entries
+    // that point into the collection set, given that live objects
+    // from the collection set are about to move and such entries
+    // will be stale very soon.
+    // This change also dealt with a reliability issue which
+    // involved scanning a card in the collection set and coming
+    // across an array that was being chunked and looking malformed.
+    // The problem is that, if evacuation fails, we might have
+    // remembered set entries missing given that we skipped cards on
+    // the collection set. So, we'll recreate such entries now.
+    obj->oop_iterate(_log_buffer_cl);
+
+    _hr->update_bot_for_block(obj_addr, obj_addr + obj_size);
   }
 
   // Fill the memory area from start to end with filler objects, and update the BOT
-  // and the mark bitmap accordingly.
+  // accordingly. The area does not contain any marks on the prev bitmap.
   void zap_dead_objects(HeapWord* start, HeapWord* end) {
     if (start == end) {
       return;
     }
 
     size_t gap_size = pointer_delta(end, start);
-    MemRegion mr(start, gap_size);
     if (gap_size >= CollectedHeap::min_fill_size()) {
       CollectedHeap::fill_with_objects(start, gap_size);
 
       HeapWord* end_first_obj = start + cast_to_oop(start)->size();
-      _hr->cross_threshold(start, end_first_obj);
+      _hr->update_bot_for_block(start, end_first_obj);
       // Fill_with_objects() may have created multiple (i.e. two)
       // objects, as the max_fill_size() is half a region.
       // After updating the BOT for the first object, also update the
       // BOT for the second object to make the BOT complete.
       if (end_first_obj != end) {
-        _hr->cross_threshold(end_first_obj, end);
+        _hr->update_bot_for_block(end_first_obj, end);
 #ifdef ASSERT
         size_t size_second_obj = cast_to_oop(end_first_obj)->size();
         HeapWord* end_of_second_obj = end_first_obj + size_second_obj;
@@ -190,96 +179,161 @@ public:
 #endif
       }
     }
-    _cm->clear_range_in_prev_bitmap(mr);
+    assert(_cm->prev_mark_bitmap()->get_next_marked_addr(start, end) == end,
+           "No marks expected in dead area [" PTR_FORMAT ", " PTR_FORMAT ")", p2i(start), p2i(end));
   }
 
-  void zap_remainder() {
-    zap_dead_objects(_last_forwarded_object_end, _hr->top());
+  // Process the objects that failed evacuation starting within the given chunk
+  // of the region, and the dead area following each of them. The dead area in
+  // front of the first such object in the region is processed with the chunk
+  // at the bottom of the region.
+  void process_chunk(HeapWord* chunk_start, HeapWord* chunk_end) {
+    const G1CMBitMap* const bitmap = _cm->prev_mark_bitmap();
+    HeapWord* const hr_top = _hr->top();
+
+    HeapWord* obj_addr = bitmap->get_next_marked_addr(chunk_start, hr_top);
+    if (chunk_start == _hr->bottom()) {
+      zap_dead_objects(chunk_start, obj_addr);
+    }
+    while (obj_addr < chunk_end) {
+      oop obj = cast_to_oop(obj_addr);
+      do_object(obj);
+
+      HeapWord* obj_end = obj_addr + obj->size();
+      HeapWord* next_obj_addr = bitmap->get_next_marked_addr(obj_end, hr_top);
+      zap_dead_objects(obj_end, next_obj_addr);
+      obj_addr = next_obj_addr;
+    }
   }
 };
 
-class RemoveSelfForwardPtrHRClosure: public HeapRegionClosure {
+// Collects the regions of the collection set that failed evacuation.
+class G1CollectFailedRegionsClosure : public HeapRegionClosure {
   G1CollectedHeap* _g1h;
-  uint _worker_id;
-
-  G1RedirtyCardsLocalQueueSet _rdc_local_qset;
-  UpdateLogBuffersDeferred _log_buffer_cl;
-
-  uint volatile* _num_failed_regions;
+  uint* _failed_regions;
+  uint _num_failed_regions;
 
 public:
-  RemoveSelfForwardPtrHRClosure(G1RedirtyCardsQueueSet* rdcqs, uint worker_id, uint volatile* num_failed_regions) :
+  G1CollectFailedRegionsClosure(uint* failed_regions) :
     _g1h(G1CollectedHeap::heap()),
-    _worker_id(worker_id),
-    _rdc_local_qset(rdcqs),
-    _log_buffer_cl(&_rdc_local_qset),
-    _num_failed_regions(num_failed_regions) {
-  }
+    _failed_regions(failed_regions),
+    _num_failed_regions(0) { }
 
-  ~RemoveSelfForwardPtrHRClosure() {
-    _rdc_local_qset.flush();
-  }
-
-  size_t remove_self_forward_ptr_by_walking_hr(HeapRegion* hr,
-                                               bool during_concurrent_start) {
-    RemoveSelfForwardPtrObjClosure rspc(hr,
-                                        &_log_buffer_cl,
-                                        during_concurrent_start,
-                                        _worker_id);
-    hr->object_iterate(&rspc);
-    // Need to zap the remainder area of the processed region.
-    rspc.zap_remainder();
-
-    return rspc.marked_bytes();
-  }
-
-  bool do_heap_region(HeapRegion *hr) {
-    assert(!hr->is_pinned(), "Unexpected pinned region at index %u", hr->hrm_index());
+  bool do_heap_region(HeapRegion* hr) {
     assert(hr->in_collection_set(), "bad CS");
 
     if (_g1h->evacuation_failed(hr->hrm_index())) {
-      hr->clear_index_in_opt_cset();
-
-      bool during_concurrent_start = _g1h->collector_state()->in_concurrent_start_gc();
-      bool during_concurrent_mark = _g1h->collector_state()->mark_or_rebuild_in_progress();
-
-      hr->note_self_forwarding_removal_start(during_concurrent_start,
-                                             during_concurrent_mark);
-      _g1h->verifier()->check_bitmaps("Self-Forwarding Ptr Removal", hr);
-
-      hr->reset_bot();
-
-      size_t live_bytes = remove_self_forward_ptr_by_walking_hr(hr, during_concurrent_start);
-
-      hr->rem_set()->clean_strong_code_roots(hr);
-      hr->rem_set()->clear_locked(true);
-
-      hr->note_self_forwarding_removal_end(live_bytes);
-
-      Atomic::inc(_num_failed_regions, memory_order_relaxed);
+      _failed_regions[_num_failed_regions++] = hr->hrm_index();
     }
     return false;
   }
+
+  uint num_failed_regions() const { return _num_failed_regions; }
 };
 
 G1ParRemoveSelfForwardPtrsTask::G1ParRemoveSelfForwardPtrsTask(G1RedirtyCardsQueueSet* rdcqs) :
   AbstractGangTask("G1 Remove Self-forwarding Pointers"),
   _g1h(G1CollectedHeap::heap()),
   _rdcqs(rdcqs),
-  _hrclaimer(_g1h->workers()->active_workers()),
-  _num_failed_regions(0) { }
-
-void G1ParRemoveSelfForwardPtrsTask::work(uint worker_id) {
-  RemoveSelfForwardPtrHRClosure rsfp_cl(_rdcqs, worker_id, &_num_failed_regions);
+  _failed_regions(NEW_C_HEAP_ARRAY(uint, _g1h->num_regions_failed_evacuation(), mtGC)),
+  _num_regions_to_process(0),
+  _chunk_size(HeapRegion::GrainWords / chunks_per_region()),
+  _chunks_per_region(chunks_per_region()),
+  _next_chunk(0),
+  _chunks_remaining(NULL),
+  _live_bytes(NULL),
+  _during_concurrent_start(_g1h->collector_state()->in_concurrent_start_gc()),
+  _num_failed_regions(0) {
 
   // We need to check all collection set regions whether they need self forward
   // removals, not only the last collection set increment. The reason is that
   // reference processing (e.g. finalizers) can make it necessary to resurrect an
   // otherwise unreachable object at the very end of the collection. That object
   // might cause an evacuation failure in any region in the collection set.
-  _g1h->collection_set_par_iterate_all(&rsfp_cl, &_hrclaimer, worker_id);
+  G1CollectFailedRegionsClosure cl(_failed_regions);
+  _g1h->collection_set_iterate_all(&cl);
+  _num_regions_to_process = cl.num_failed_regions();
+
+  _chunks_remaining = NEW_C_HEAP_ARRAY(uint, _num_regions_to_process, mtGC);
+  _live_bytes = NEW_C_HEAP_ARRAY(size_t, _num_regions_to_process, mtGC);
+  for (uint i = 0; i < _num_regions_to_process; i++) {
+    _chunks_remaining[i] = _chunks_per_region;
+    _live_bytes[i] = 0;
+    prepare_region(_g1h->region_at(_failed_regions[i]));
+  }
+}
+
+G1ParRemoveSelfForwardPtrsTask::~G1ParRemoveSelfForwardPtrsTask() {
+  FREE_C_HEAP_ARRAY(uint, _failed_regions);
+  FREE_C_HEAP_ARRAY(uint, _chunks_remaining);
+  FREE_C_HEAP_ARRAY(size_t, _live_bytes);
+}
+
+void G1ParRemoveSelfForwardPtrsTask::prepare_region(HeapRegion* hr) {
+  assert(!hr->is_pinned(), "Unexpected pinned region at index %u", hr->hrm_index());
+
+  hr->clear_index_in_opt_cset();
+
+  bool during_concurrent_mark = _g1h->collector_state()->mark_or_rebuild_in_progress();
+  hr->note_self_forwarding_removal_start(_during_concurrent_start,
+                                         during_concurrent_mark);
+
+  hr->reset_bot();
+}
+
+void G1ParRemoveSelfForwardPtrsTask::finish_region(HeapRegion* hr, size_t live_bytes) {
+  hr->rem_set()->clean_strong_code_roots(hr);
+  hr->rem_set()->clear_locked(true);
+
+  hr->note_self_forwarding_removal_end(live_bytes);
+  _g1h->verifier()->check_bitmaps("Self-Forwarding Ptr Removal", hr);
+
+  Atomic::inc(&_num_failed_regions, memory_order_relaxed);
+}
+
+void G1ParRemoveSelfForwardPtrsTask::work(uint worker_id) {
+  G1RedirtyCardsLocalQueueSet rdc_local_qset(_rdcqs);
+  UpdateLogBuffersDeferred log_buffer_cl(&rdc_local_qset);
+
+  size_t const total_chunks = num_chunks();
+  for (size_t chunk = Atomic::fetch_and_add(&_next_chunk, (size_t)1);
+       chunk < total_chunks;
+       chunk = Atomic::fetch_and_add(&_next_chunk, (size_t)1)) {
+    uint const idx = (uint)(chunk / _chunks_per_region);
+    HeapRegion* hr = _g1h->region_at(_failed_regions[idx]);
+
+    HeapWord* const chunk_start = hr->bottom() + (chunk % _chunks_per_region) * _chunk_size;
+    if (chunk_start < hr->top()) {
+      RemoveSelfForwardPtrObjClosure rspc(hr,
+                                          &log_buffer_cl,
+                                          _during_concurrent_start,
+                                          worker_id);
+      rspc.process_chunk(chunk_start, MIN2(chunk_start + _chunk_size, hr->top()));
+      if (rspc.marked_bytes() > 0) {
+        Atomic::add(&_live_bytes[idx], rspc.marked_bytes());
+      }
+    }
+
+    if (Atomic::sub(&_chunks_remaining[idx], 1u) == 0) {
+      finish_region(hr, Atomic::load(&_live_bytes[idx]));
+    }
+  }
+
+  rdc_local_qset.flush();
+}
+
+uint G1ParRemoveSelfForwardPtrsTask::chunks_per_region() {
+  uint log_region_size = (uint)HeapRegion::LogOfHRGrainBytes;
+  // Limit the expected input values to the currently possible region sizes.
+  assert(log_region_size >= 20 && log_region_size <= 29,
+         "expected value in [20,29], but got %u", log_region_size);
+  return 1u << (log_region_size / 2 - 4);
 }
 
 uint G1ParRemoveSelfForwardPtrsTask::num_failed_regions() const {
   return Atomic::load(&_num_failed_regions);
 }
+
+uint G1ParRemoveSelfForwardPtrsTask::num_chunks() const {
+  return _num_regions_to_process * _chunks_per_region;
+}
@@ -32,23 +32,54 @@
 
 class G1CollectedHeap;
 class G1RedirtyCardsQueueSet;
+class HeapRegion;
 
 // Task to fixup self-forwarding pointers
 // installed as a result of an evacuation failure.
+//
+// Objects that failed evacuation have been recorded in the prev bitmap, so
+// this task only visits those objects instead of walking the whole region.
+// Every region that failed evacuation is split into chunks_per_region() chunks
+// that are claimed by the workers. Every chunk handles the objects
+// starting in it and the dead space following each of them; the worker finishing
+// the last chunk of a region completes the processing of that region.
 class G1ParRemoveSelfForwardPtrsTask: public AbstractGangTask {
 protected:
   G1CollectedHeap* _g1h;
   G1RedirtyCardsQueueSet* _rdcqs;
-  HeapRegionClaimer _hrclaimer;
+
+  // The regions that failed evacuation.
+  uint* _failed_regions;
+  uint _num_regions_to_process;
+
+  size_t _chunk_size;
+  uint _chunks_per_region;
+
+  // The number of chunks a region is split into. Grows with the square root
+  // of the region size, from 64 chunks of 16K for 1M regions.
+  static uint chunks_per_region();
+  size_t volatile _next_chunk;
+
+  // Per failed region, the number of unprocessed chunks and the live bytes
+  // found so far.
+  uint volatile* _chunks_remaining;
+  size_t volatile* _live_bytes;
+
+  bool _during_concurrent_start;
 
   uint volatile _num_failed_regions;
 
+  void prepare_region(HeapRegion* hr);
+  void finish_region(HeapRegion* hr, size_t live_bytes);
+
 public:
   G1ParRemoveSelfForwardPtrsTask(G1RedirtyCardsQueueSet* rdcqs);
+  ~G1ParRemoveSelfForwardPtrsTask();
 
   void work(uint worker_id);
 
   uint num_failed_regions() const;
+  uint num_chunks() const;
 };
 
 #endif // SHARE_GC_G1_G1EVACFAILURE_HPP
@@ -119,7 +119,7 @@ G1FullCollector::G1FullCollector(G1CollectedHeap* heap,
     _oop_queue_set(_num_workers),
     _array_queue_set(_num_workers),
     _preserved_marks_set(true),
-    _serial_compaction_point(),
+    _num_tail_compaction_points(0),
     _is_alive(this, heap->concurrent_mark()->next_mark_bitmap()),
     _is_alive_mutator(heap->ref_processor_stw(), &_is_alive),
     _always_subject_to_discovery(),
@@ -130,6 +130,7 @@ G1FullCollector::G1FullCollector(G1CollectedHeap* heap,
   _preserved_marks_set.init(_num_workers);
   _markers = NEW_C_HEAP_ARRAY(G1FullGCMarker*, _num_workers, mtGC);
   _compaction_points = NEW_C_HEAP_ARRAY(G1FullGCCompactionPoint*, _num_workers, mtGC);
+  _tail_compaction_points = NEW_C_HEAP_ARRAY(G1FullGCCompactionPoint*, _num_workers, mtGC);
 
   _live_stats = NEW_C_HEAP_ARRAY(G1RegionMarkStats, _heap->max_regions(), mtGC);
   for (uint j = 0; j < heap->max_regions(); j++) {
@@ -139,6 +140,7 @@ G1FullCollector::G1FullCollector(G1CollectedHeap* heap,
   for (uint i = 0; i < _num_workers; i++) {
     _markers[i] = new G1FullGCMarker(this, i, _preserved_marks_set.get(i), _live_stats);
     _compaction_points[i] = new G1FullGCCompactionPoint();
+    _tail_compaction_points[i] = new G1FullGCCompactionPoint();
     _oop_queue_set.register_queue(i, marker(i)->oop_stack());
     _array_queue_set.register_queue(i, marker(i)->objarray_stack());
   }
@@ -149,9 +151,11 @@ G1FullCollector::~G1FullCollector() {
   for (uint i = 0; i < _num_workers; i++) {
     delete _markers[i];
     delete _compaction_points[i];
+    delete _tail_compaction_points[i];
   }
   FREE_C_HEAP_ARRAY(G1FullGCMarker*, _markers);
   FREE_C_HEAP_ARRAY(G1FullGCCompactionPoint*, _compaction_points);
+  FREE_C_HEAP_ARRAY(G1FullGCCompactionPoint*, _tail_compaction_points);
   FREE_C_HEAP_ARRAY(G1RegionMarkStats, _live_stats);
 }
 
@@ -238,7 +242,7 @@ void G1FullCollector::before_marking_update_attribute_table(HeapRegion* hr) {
     _region_attr_table.verify_is_invalid(hr->hrm_index());
   } else if (hr->is_closed_archive()) {
     _region_attr_table.set_skip_marking(hr->hrm_index());
-  } else if (hr->is_pinned()) {
+  } else if (hr->is_pinned() || hr->has_pinned_objects()) {
     _region_attr_table.set_skip_compacting(hr->hrm_index());
   } else {
     // Everything else should be compacted.
@@ -317,7 +321,9 @@ void G1FullCollector::phase2_prepare_compaction() {
 
   // To avoid OOM when there is memory left.
   if (!task.has_freed_regions()) {
-    task.prepare_serial_compaction();
+    task.prepare_tail_compaction();
+    G1FullGCPrepareTailTask tail_task(this);
+    run_task(&tail_task);
   }
 }
 
@@ -335,9 +341,11 @@ void G1FullCollector::phase4_do_compaction() {
   G1FullGCCompactTask task(this);
   run_task(&task);
 
-  // Serial compact to avoid OOM when very few free regions.
-  if (serial_compaction_point()->has_regions()) {
-    task.serial_compaction();
+  // Compact the tail regions to avoid OOM when very few free regions.
+  if (num_tail_compaction_points() > 0) {
+    GCTraceTime(Debug, gc, phases) debug("Phase 4: Tail Compaction", scope()->timer());
+    G1FullGCCompactTailTask tail_task(this);
+    run_task(&tail_task);
   }
 }
 
@@ -76,15 +76,15 @@ size_t G1FullGCCompactTask::G1CompactRegionClosure::apply(oop obj) {
   return size;
 }
 
-void G1FullGCCompactTask::compact_region(HeapRegion* hr) {
+void G1FullGCCompactTask::compact_region(G1FullCollector* collector, HeapRegion* hr) {
   assert(!hr->is_pinned(), "Should be no pinned region in compaction queue");
   assert(!hr->is_humongous(), "Should be no humongous regions in compaction queue");
-  G1CompactRegionClosure compact(collector()->mark_bitmap());
-  hr->apply_to_marked_objects(collector()->mark_bitmap(), &compact);
+  G1CompactRegionClosure compact(collector->mark_bitmap());
+  hr->apply_to_marked_objects(collector->mark_bitmap(), &compact);
   // Clear the liveness information for this region if necessary i.e. if we actually look at it
   // for bitmap verification. Otherwise it is sufficient that we move the TAMS to bottom().
   if (G1VerifyBitmaps) {
-    collector()->mark_bitmap()->clear_region(hr);
+    collector->mark_bitmap()->clear_region(hr);
   }
   hr->reset_compacted_after_full_gc();
 }
@@ -95,7 +95,7 @@ void G1FullGCCompactTask::work(uint worker_id) {
   for (GrowableArrayIterator<HeapRegion*> it = compaction_queue->begin();
        it != compaction_queue->end();
        ++it) {
-    compact_region(*it);
+    compact_region(collector(), *it);
   }
 
   G1ResetSkipCompactingClosure hc(collector());
@@ -103,12 +103,16 @@ void G1FullGCCompactTask::work(uint worker_id) {
   log_task("Compaction task", worker_id, start);
 }
 
-void G1FullGCCompactTask::serial_compaction() {
-  GCTraceTime(Debug, gc, phases) tm("Phase 4: Serial Compaction", collector()->scope()->timer());
-  GrowableArray<HeapRegion*>* compaction_queue = collector()->serial_compaction_point()->regions();
+void G1FullGCCompactTailTask::work(uint worker_id) {
+  if (worker_id >= collector()->num_tail_compaction_points()) {
+    return;
+  }
+  Ticks start = Ticks::now();
+  GrowableArray<HeapRegion*>* compaction_queue = collector()->tail_compaction_point(worker_id)->regions();
   for (GrowableArrayIterator<HeapRegion*> it = compaction_queue->begin();
        it != compaction_queue->end();
        ++it) {
-    compact_region(*it);
+    G1FullGCCompactTask::compact_region(collector(), *it);
   }
+  log_task("Tail compaction task", worker_id, start);
 }
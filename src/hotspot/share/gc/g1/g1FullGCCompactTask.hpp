@@ -38,15 +38,13 @@ class G1FullGCCompactTask : public G1FullGCTask {
 protected:
   HeapRegionClaimer _claimer;
 
-private:
-  void compact_region(HeapRegion* hr);
-
 public:
   G1FullGCCompactTask(G1FullCollector* collector) :
     G1FullGCTask("G1 Compact Task", collector),
     _claimer(collector->workers()) { }
   void work(uint worker_id);
-  void serial_compaction();
+
+  static void compact_region(G1FullCollector* collector, HeapRegion* hr);
 
   class G1CompactRegionClosure : public StackObj {
     G1CMBitMap* _bitmap;
@@ -57,4 +55,14 @@ public:
   };
 };
 
+// Compacts the regions of the tail compaction points after all other regions
+// have been compacted. The tail compaction points are independent of each
+// other, so each of them is handled by a separate worker.
+class G1FullGCCompactTailTask : public G1FullGCTask {
+public:
+  G1FullGCCompactTailTask(G1FullCollector* collector) :
+    G1FullGCTask("G1 Compact Tail Task", collector) { }
+  void work(uint worker_id);
+};
+
 #endif // SHARE_GC_G1_G1FULLGCCOMPACTTASK_HPP
@@ -73,6 +73,15 @@ bool G1FullGCPrepareTask::G1CalculatePointersClosure::do_heap_region(HeapRegion*
       }
     } else if (hr->is_closed_archive()) {
       // nothing to do with closed archive region
+    } else if (hr->has_pinned_objects()) {
+      // Regions with objects pinned by JNI critical sections have been marked
+      // skip-compacting before marking already.
+      if (hr->is_young()) {
+        // See below.
+        hr->update_bot();
+      }
+      log_trace(gc, phases)("Phase 2: skip compaction region index: %u with pinned objects, live words: " SIZE_FORMAT,
+                            hr->hrm_index(), _collector->live_words(hr->hrm_index()));
     } else {
       assert(MarkSweepDeadRatio > 0,
              "only skip compaction for other regions when MarkSweepDeadRatio > 0");
@@ -137,7 +146,7 @@ G1FullGCPrepareTask::G1CalculatePointersClosure::G1CalculatePointersClosure(G1Fu
     _regions_freed(false) { }
 
 bool G1FullGCPrepareTask::G1CalculatePointersClosure::should_compact(HeapRegion* hr) {
-  if (hr->is_pinned()) {
+  if (hr->is_pinned() || hr->has_pinned_objects()) {
     return false;
   }
   size_t live_words = _collector->live_words(hr->hrm_index());
@@ -197,22 +206,58 @@ void G1FullGCPrepareTask::G1CalculatePointersClosure::prepare_for_compaction(Hea
   prepare_for_compaction_work(_cp, hr);
 }
 
-void G1FullGCPrepareTask::prepare_serial_compaction() {
-  GCTraceTime(Debug, gc, phases) debug("Phase 2: Prepare Serial Compaction", collector()->scope()->timer());
+static int compare_region_index(HeapRegion** hr1, HeapRegion** hr2) {
+  uint idx1 = (*hr1)->hrm_index();
+  uint idx2 = (*hr2)->hrm_index();
+  return (idx1 > idx2) - (idx1 < idx2);
+}
+
+void G1FullGCPrepareTask::prepare_tail_compaction() {
+  GCTraceTime(Debug, gc, phases) debug("Phase 2: Prepare Tail Compaction", collector()->scope()->timer());
   // At this point we know that no regions were completely freed by
   // the parallel compaction. That means that the last region of
   // all compaction queues still have data in them. We try to compact
-  // these regions in serial to avoid a premature OOM.
+  // these regions to avoid a premature OOM.
+  GrowableArray<HeapRegion*> tail_regions(collector()->workers());
   for (uint i = 0; i < collector()->workers(); i++) {
     G1FullGCCompactionPoint* cp = collector()->compaction_point(i);
     if (cp->has_regions()) {
-      collector()->serial_compaction_point()->add(cp->remove_last());
+      tail_regions.append(cp->remove_last());
+    }
+  }
+  if (tail_regions.is_empty()) {
+    return;
+  }
+  // Compact towards the bottom of the heap.
+  tail_regions.sort(compare_region_index);
+
+  // Distribute the tail regions in address order across as many compaction
+  // points as useful. Every compaction point may leave one partially filled
+  // region, so use a single one if we need to compact as much as possible.
+  uint num_regions = (uint)tail_regions.length();
+  uint num_cps = 1;
+  if (!collector()->scope()->do_maximum_compaction()) {
+    num_cps = clamp(num_regions / TailCompactionMinRegionsPerWorker, 1u, collector()->workers());
+  }
+  for (uint i = 0; i < num_cps; i++) {
+    uint start = i * num_regions / num_cps;
+    uint end = (i + 1) * num_regions / num_cps;
+    for (uint j = start; j < end; j++) {
+      collector()->tail_compaction_point(i)->add(tail_regions.at(j));
     }
   }
+  collector()->set_num_tail_compaction_points(num_cps);
+  log_debug(gc, phases)("Phase 2: Tail compaction of %u regions using %u workers", num_regions, num_cps);
+}
 
-  // Update the forwarding information for the regions in the serial
+void G1FullGCPrepareTailTask::work(uint worker_id) {
+  if (worker_id >= collector()->num_tail_compaction_points()) {
+    return;
+  }
+  Ticks start = Ticks::now();
+  // Update the forwarding information for the regions in the tail
   // compaction point.
-  G1FullGCCompactionPoint* cp = collector()->serial_compaction_point();
+  G1FullGCCompactionPoint* cp = collector()->tail_compaction_point(worker_id);
   for (GrowableArrayIterator<HeapRegion*> it = cp->regions()->begin(); it != cp->regions()->end(); ++it) {
     HeapRegion* current = *it;
     if (!cp->is_initialized()) {
@@ -221,12 +266,13 @@ void G1FullGCPrepareTask::prepare_serial_compaction() {
       cp->initialize(current, false);
     } else {
       assert(!current->is_humongous(), "Should be no humongous regions in compaction queue");
-      G1RePrepareClosure re_prepare(cp, current);
+      G1FullGCPrepareTask::G1RePrepareClosure re_prepare(cp, current);
       current->set_compaction_top(current->bottom());
       current->apply_to_marked_objects(collector()->mark_bitmap(), &re_prepare);
     }
   }
   cp->update();
+  log_task("Prepare tail compaction task", worker_id, start);
 }
 
 bool G1FullGCPrepareTask::G1CalculatePointersClosure::freed_regions() {
@@ -36,7 +36,13 @@ class G1CMBitMap;
 class G1FullCollector;
 
 class G1FullGCPrepareTask : public G1FullGCTask {
+  friend class G1FullGCPrepareTailTask;
+
 protected:
+  // Minimum number of tail regions given to each tail compaction point. Fewer
+  // tail compaction points leave fewer partially filled regions behind.
+  static const uint TailCompactionMinRegionsPerWorker = 4;
+
   volatile bool     _freed_regions;
   HeapRegionClaimer _hrclaimer;
 
@@ -45,7 +51,7 @@ protected:
 public:
   G1FullGCPrepareTask(G1FullCollector* collector);
   void work(uint worker_id);
-  void prepare_serial_compaction();
+  void prepare_tail_compaction();
   bool has_freed_regions();
 
 protected:
@@ -96,4 +102,13 @@ protected:
   };
 };
 
+// Prepares the regions of each tail compaction point for compaction into
+// that compaction point, in parallel.
+class G1FullGCPrepareTailTask : public G1FullGCTask {
+public:
+  G1FullGCPrepareTailTask(G1FullCollector* collector) :
+    G1FullGCTask("G1 Prepare Tail Compact Task", collector) { }
+  void work(uint worker_id);
+};
+
 #endif // SHARE_GC_G1_G1FULLGCPREPARETASK_HPP
@@ -53,6 +53,7 @@ class G1FullGCScope : public StackObj {
   ClearedAllSoftRefs      _soft_refs;
   G1MonitoringScope       _monitoring_scope;
   G1HeapTransition        _heap_transition;
+  bool                    _do_maximum_compaction;
   size_t                  _region_compaction_threshold;
 
 public:
@@ -64,6 +65,7 @@ public:
 
   bool is_explicit_gc();
   bool should_clear_soft_refs();
+  bool do_maximum_compaction() const { return _do_maximum_compaction; }
 
   STWGCTimer* timer();
   G1FullGCTracer* tracer();
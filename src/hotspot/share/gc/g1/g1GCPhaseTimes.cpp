@@ -72,12 +72,14 @@ G1GCPhaseTimes::G1GCPhaseTimes(STWGCTimer* gc_timer, uint max_gc_threads) :
 
   _gc_par_phases[MergeRS] = new WorkerDataArray<double>("MergeRS", "Remembered Sets (ms):", max_gc_threads);
   _gc_par_phases[MergeRS]->create_thread_work_items("Merged Sparse:", MergeRSMergedSparse);
+  _gc_par_phases[MergeRS]->create_thread_work_items("Merged Array:", MergeRSMergedArray);
   _gc_par_phases[MergeRS]->create_thread_work_items("Merged Fine:", MergeRSMergedFine);
   _gc_par_phases[MergeRS]->create_thread_work_items("Merged Coarse:", MergeRSMergedCoarse);
   _gc_par_phases[MergeRS]->create_thread_work_items("Dirty Cards:", MergeRSDirtyCards);
 
   _gc_par_phases[OptMergeRS] = new WorkerDataArray<double>("OptMergeRS", "Optional Remembered Sets (ms):", max_gc_threads);
   _gc_par_phases[OptMergeRS]->create_thread_work_items("Merged Sparse:", MergeRSMergedSparse);
+  _gc_par_phases[OptMergeRS]->create_thread_work_items("Merged Array:", MergeRSMergedArray);
   _gc_par_phases[OptMergeRS]->create_thread_work_items("Merged Fine:", MergeRSMergedFine);
   _gc_par_phases[OptMergeRS]->create_thread_work_items("Merged Coarse:", MergeRSMergedCoarse);
   _gc_par_phases[OptMergeRS]->create_thread_work_items("Dirty Cards:", MergeRSDirtyCards);
@@ -162,6 +164,7 @@ void G1GCPhaseTimes::reset() {
   _cur_post_evacuate_cleanup_1_time_ms = 0.0;
   _cur_post_evacuate_cleanup_2_time_ms = 0.0;
   _cur_expand_heap_time_ms = 0.0;
+  _cur_shrink_heap_time_ms = 0.0;
   _cur_ref_proc_time_ms = 0.0;
   _cur_collection_start_sec = 0.0;
   _root_region_scan_wait_time_ms = 0.0;
@@ -453,7 +456,8 @@ double G1GCPhaseTimes::print_post_evacuate_collection_set() const {
                         _cur_post_evacuate_cleanup_2_time_ms +
                         _recorded_total_rebuild_freelist_time_ms +
                         _recorded_start_new_cset_time_ms +
-                        _cur_expand_heap_time_ms;
+                        _cur_expand_heap_time_ms +
+                        _cur_shrink_heap_time_ms;
 
   info_time("Post Evacuate Collection Set", sum_ms);
 
@@ -501,6 +505,7 @@ double G1GCPhaseTimes::print_post_evacuate_collection_set() const {
     debug_time("Resize TLABs", _cur_resize_tlab_time_ms);
   }
   debug_time("Expand Heap After Collection", _cur_expand_heap_time_ms);
+  debug_time("Shrink Heap After Collection", _cur_shrink_heap_time_ms);
 
   return sum_ms;
 }
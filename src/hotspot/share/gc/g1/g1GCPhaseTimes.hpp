@@ -99,6 +99,7 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
 
   enum GCMergeRSWorkTimes {
     MergeRSMergedSparse,
+    MergeRSMergedArray,
     MergeRSMergedFine,
     MergeRSMergedCoarse,
     MergeRSDirtyCards
@@ -159,6 +160,7 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
   double _cur_post_evacuate_cleanup_2_time_ms;
 
   double _cur_expand_heap_time_ms;
+  double _cur_shrink_heap_time_ms;
   double _cur_ref_proc_time_ms;
 
   double _cur_collection_start_sec;
@@ -261,6 +263,10 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
     _cur_expand_heap_time_ms = ms;
   }
 
+  void record_shrink_heap_time(double ms) {
+    _cur_shrink_heap_time_ms = ms;
+  }
+
   void record_initial_evac_time(double ms) {
     _cur_collection_initial_evac_time_ms = ms;
   }
@@ -373,6 +379,10 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
     return _cur_expand_heap_time_ms;
   }
 
+  double cur_shrink_heap_time_ms() {
+    return _cur_shrink_heap_time_ms;
+  }
+
   double root_region_scan_wait_time_ms() {
     return _root_region_scan_wait_time_ms;
   }
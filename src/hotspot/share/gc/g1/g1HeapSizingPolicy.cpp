@@ -28,6 +28,7 @@
 #include "gc/g1/g1Analytics.hpp"
 #include "logging/log.hpp"
 #include "runtime/globals.hpp"
+#include "utilities/align.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/globalDefinitions.hpp"
 
@@ -38,9 +39,11 @@ G1HeapSizingPolicy* G1HeapSizingPolicy::create(const G1CollectedHeap* g1h, const
 G1HeapSizingPolicy::G1HeapSizingPolicy(const G1CollectedHeap* g1h, const G1Analytics* analytics) :
   _g1h(g1h),
   _analytics(analytics),
-  _num_prev_pauses_for_heuristics(analytics->number_of_recorded_pause_times()) {
+  _num_prev_pauses_for_heuristics(analytics->number_of_recorded_pause_times()),
+  _ratio_under_threshold_count(0) {
 
   assert(MinOverThresholdForGrowth < _num_prev_pauses_for_heuristics, "Threshold must be less than %u", _num_prev_pauses_for_heuristics);
+  assert(MinUnderThresholdForShrink < _num_prev_pauses_for_heuristics, "Threshold must be less than %u", _num_prev_pauses_for_heuristics);
   clear_ratio_check_data();
 }
 
@@ -212,6 +215,93 @@ static size_t target_heap_capacity(size_t used_bytes, uintx free_ratio) {
   return (size_t) desired_capacity_d;
 }
 
+size_t G1HeapSizingPolicy::young_collection_shrink_amount() {
+  if (G1ShrinkByPercentOfCapacity == 0) {
+    return 0;
+  }
+
+  double long_term_pause_time_ratio = _analytics->long_term_pause_time_ratio();
+  double short_term_pause_time_ratio = _analytics->short_term_pause_time_ratio();
+  const double pause_time_threshold = 1.0 / (1.0 + GCTimeRatio);
+  // Only shrink if GC overhead is well below the threshold used for expansion,
+  // otherwise the heap would oscillate around the expansion threshold.
+  double threshold = scale_with_heap(pause_time_threshold) / 2.0;
+
+  // Do not shrink while there are indications that the heap should grow, or
+  // while the last pause has been expensive.
+  if (_ratio_over_threshold_count > 0 ||
+      short_term_pause_time_ratio > threshold ||
+      long_term_pause_time_ratio > threshold) {
+    _ratio_under_threshold_count = 0;
+    return 0;
+  }
+
+  _ratio_under_threshold_count++;
+  if (_ratio_under_threshold_count < MinUnderThresholdForShrink) {
+    return 0;
+  }
+
+  const size_t capacity = _g1h->capacity();
+  const size_t min_capacity = MAX2(MinHeapSize, HeapRegion::GrainBytes);
+  if (capacity <= min_capacity) {
+    return 0;
+  }
+
+  // The live data the heap needs to hold is the larger of the current
+  // occupancy and the predicted trend of occupancy after young gcs.
+  const size_t live_bytes = MAX2(_g1h->used(), _analytics->predict_live_bytes_after_young_gc());
+
+  // The young gen needs to be able to hold the allocations during the mutator
+  // interval that keeps GC overhead at the desired pause time ratio.
+  const double desired_mutator_interval_ms = _analytics->recent_avg_pause_time_ms() * GCTimeRatio;
+  const double young_bytes_d = _analytics->predict_alloc_rate_ms() * desired_mutator_interval_ms * HeapRegion::GrainBytes;
+  const size_t young_bytes = (size_t)MIN2(young_bytes_d, (double)_g1h->max_capacity());
+
+  size_t desired_capacity = MAX2(target_heap_capacity(live_bytes, MaxHeapFreeRatio),
+                                 live_bytes + young_bytes);
+  desired_capacity = MAX2(desired_capacity, min_capacity);
+
+  size_t shrink_bytes = 0;
+  if (capacity > desired_capacity) {
+    // Give back memory gradually; the regions are uncommitted concurrently
+    // by the G1UncommitRegionTask.
+    const size_t max_shrink_bytes = capacity * G1ShrinkByPercentOfCapacity / 100;
+    shrink_bytes = MIN2(capacity - desired_capacity, max_shrink_bytes);
+    shrink_bytes = align_down(shrink_bytes, HeapRegion::GrainBytes);
+  }
+
+  log_debug(gc, ergo, heap)("Heap shrinking: "
+                            "short term pause time ratio %1.2f%% long term pause time ratio %1.2f%% "
+                            "threshold %1.2f%% live " SIZE_FORMAT "B young " SIZE_FORMAT "B "
+                            "desired capacity " SIZE_FORMAT "B resize by " SIZE_FORMAT "B",
+                            short_term_pause_time_ratio * 100.0,
+                            long_term_pause_time_ratio * 100.0,
+                            threshold * 100.0,
+                            live_bytes,
+                            young_bytes,
+                            desired_capacity,
+                            shrink_bytes);
+
+  if (shrink_bytes > 0) {
+    // Require another series of cheap pauses before shrinking again so that
+    // the predictions can catch up with the new heap size.
+    _ratio_under_threshold_count = 0;
+  }
+  return shrink_bytes;
+}
+
+size_t G1HeapSizingPolicy::young_collection_resize_amount(bool& expand) {
+  expand = true;
+  size_t expand_bytes = young_collection_expansion_amount();
+  if (expand_bytes > 0) {
+    _ratio_under_threshold_count = 0;
+    return expand_bytes;
+  }
+
+  expand = false;
+  return young_collection_shrink_amount();
+}
+
 size_t G1HeapSizingPolicy::full_collection_resize_amount(bool& expand) {
   // Capacity, free and used after the GC counted as full regions to
   // include the waste in the following calculations.
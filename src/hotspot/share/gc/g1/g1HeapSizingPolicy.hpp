@@ -35,6 +35,10 @@ class G1HeapSizingPolicy: public CHeapObj<mtGC> {
   // pause times in G1Analytics, representing the minimum number of pause
   // time ratios that exceed GCTimeRatio before a heap expansion will be triggered.
   const static uint MinOverThresholdForGrowth = 4;
+  // MinUnderThresholdForShrink is the number of consecutive young collections
+  // with a pause time ratio below the shrink threshold before the heap is
+  // considered for shrinking.
+  const static uint MinUnderThresholdForShrink = 4;
 
   const G1CollectedHeap* _g1h;
   const G1Analytics* _analytics;
@@ -44,17 +48,28 @@ class G1HeapSizingPolicy: public CHeapObj<mtGC> {
   uint _ratio_over_threshold_count;
   double _ratio_over_threshold_sum;
   uint _pauses_since_start;
+  // Number of consecutive pause time ratios below the shrink threshold.
+  uint _ratio_under_threshold_count;
 
   // Scale "full" gc pause time threshold with heap size as we want to resize more
   // eagerly at small heap sizes.
   double scale_with_heap(double pause_time_threshold);
 
-  G1HeapSizingPolicy(const G1CollectedHeap* g1h, const G1Analytics* analytics);
-public:
-
   // If an expansion would be appropriate, because recent GC overhead had
   // exceeded the desired limit, return an amount to expand by.
   size_t young_collection_expansion_amount();
+  // If recent GC overhead has been well below the desired limit, return an
+  // amount to shrink by so that the committed heap approaches the predicted
+  // live data plus the young gen needed at the current allocation rate.
+  size_t young_collection_shrink_amount();
+
+  G1HeapSizingPolicy(const G1CollectedHeap* g1h, const G1Analytics* analytics);
+public:
+
+  // Returns the amount of bytes to resize the heap after a young collection;
+  // if expand is set, the heap should be expanded by that amount, shrunk
+  // otherwise.
+  size_t young_collection_resize_amount(bool& expand);
 
   // Returns the amount of bytes to resize the heap; if expand is set, the heap
   // should by expanded by that amount, shrunk otherwise.
@@ -23,6 +23,7 @@
  */
 
 #include "precompiled.hpp"
+#include "gc/g1/g1CollectedHeap.hpp"
 #include "gc/g1/g1NUMA.hpp"
 #include "logging/logStream.hpp"
 #include "runtime/globals.hpp"
@@ -256,6 +257,39 @@ void G1NUMA::copy_statistics(G1NUMAStats::NodeDataItems phase,
   _stats->copy(phase, requested_node_index, allocated_stat);
 }
 
+class G1NodeOccupancyClosure : public HeapRegionClosure {
+  G1NUMAStats* _stats;
+
+public:
+  G1NodeOccupancyClosure(G1NUMAStats* stats) : _stats(stats) { }
+
+  bool do_heap_region(HeapRegion* hr) {
+    uint node_index = hr->node_index();
+    // Regions whose node could not be determined are not attributed to any node.
+    if (node_index == G1NUMA::UnknownNodeIndex) {
+      return false;
+    }
+    if (hr->is_survivor()) {
+      _stats->add_occupancy(G1NUMAStats::SurvivorOccupancy, node_index, hr->used());
+    } else if (hr->is_humongous()) {
+      _stats->add_occupancy(G1NUMAStats::HumongousOccupancy, node_index, hr->used());
+    } else if (hr->is_old()) {
+      _stats->add_occupancy(G1NUMAStats::OldOccupancy, node_index, hr->used());
+    }
+    return false;
+  }
+};
+
+void G1NUMA::update_occupancy_statistics() {
+  if (_stats == NULL || !log_is_enabled(Info, gc, heap, numa)) {
+    return;
+  }
+
+  _stats->clear_occupancy();
+  G1NodeOccupancyClosure cl(_stats);
+  G1CollectedHeap::heap()->heap_region_iterate(&cl);
+}
+
 void G1NUMA::print_statistics() const {
   if (_stats == NULL) {
     return;
@@ -123,6 +123,9 @@ public:
   // Precondition: allocated_stat should have same length of active nodes.
   void copy_statistics(G1NUMAStats::NodeDataItems phase, uint requested_node_index, size_t* allocated_stat);
 
+  // Recalculate the per node heap occupancy statistics.
+  void update_occupancy_statistics();
+
   // Print all statistics.
   void print_statistics() const;
 };
@@ -127,12 +127,19 @@ G1NUMAStats::G1NUMAStats(const int* node_ids, uint num_node_ids) :
   for (int i = 0; i < NodeDataItemsSentinel; i++) {
     _node_data[i] = new NodeDataArray(_num_node_ids);
   }
+  for (int i = 0; i < OccupancyItemsSentinel; i++) {
+    _occupancy[i] = NEW_C_HEAP_ARRAY(size_t, _num_node_ids, mtGC);
+  }
+  clear_occupancy();
 }
 
 G1NUMAStats::~G1NUMAStats() {
   for (int i = 0; i < NodeDataItemsSentinel; i++) {
     delete _node_data[i];
   }
+  for (int i = 0; i < OccupancyItemsSentinel; i++) {
+    FREE_C_HEAP_ARRAY(size_t, _occupancy[i]);
+  }
 }
 
 void G1NUMAStats::clear(G1NUMAStats::NodeDataItems phase) {
@@ -151,6 +158,21 @@ void G1NUMAStats::copy(G1NUMAStats::NodeDataItems phase,
   _node_data[phase]->copy(requested_node_index, allocated_stat);
 }
 
+void G1NUMAStats::clear_occupancy() {
+  for (int i = 0; i < OccupancyItemsSentinel; i++) {
+    memset((void*)_occupancy[i], 0, sizeof(size_t) * _num_node_ids);
+  }
+}
+
+void G1NUMAStats::add_occupancy(G1NUMAStats::OccupancyItems item,
+                                uint node_index,
+                                size_t bytes) {
+  assert(node_index < _num_node_ids,
+         "Node index %u should be less than the number of nodes %u",
+         node_index, _num_node_ids);
+  _occupancy[item][node_index] += bytes;
+}
+
 static const char* phase_to_explanatory_string(G1NUMAStats::NodeDataItems phase) {
   switch(phase) {
     case G1NUMAStats::NewRegionAlloc:
@@ -222,9 +244,32 @@ void G1NUMAStats::print_mutator_alloc_stat_debug() {
   }
 }
 
+void G1NUMAStats::print_occupancy() {
+  LogTarget(Info, gc, heap, numa) lt;
+
+  if (lt.is_enabled()) {
+    LogStream ls(lt);
+
+    ls.print("Node occupancy (survivor/old/humongous): ");
+    for (uint i = 0; i < _num_node_ids; i++) {
+      if (i != 0) {
+        ls.print(", ");
+      }
+      ls.print("%d: " SIZE_FORMAT "K/" SIZE_FORMAT "K/" SIZE_FORMAT "K",
+               _node_ids[i],
+               _occupancy[SurvivorOccupancy][i] / K,
+               _occupancy[OldOccupancy][i] / K,
+               _occupancy[HumongousOccupancy][i] / K);
+    }
+    ls.print_cr("");
+  }
+}
+
 void G1NUMAStats::print_statistics() {
   print_info(NewRegionAlloc);
   print_mutator_alloc_stat_debug();
 
   print_info(LocalObjProcessAtCopyToSurv);
+
+  print_occupancy();
 }
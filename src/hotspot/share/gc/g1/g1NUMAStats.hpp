@@ -90,16 +90,31 @@ public:
     NodeDataItemsSentinel
   };
 
+  enum OccupancyItems {
+    // Bytes used in survivor regions.
+    SurvivorOccupancy,
+    // Bytes used in old regions.
+    OldOccupancy,
+    // Bytes used in humongous regions.
+    HumongousOccupancy,
+    OccupancyItemsSentinel
+  };
+
 private:
   const int* _node_ids;
   uint _num_node_ids;
 
   NodeDataArray* _node_data[NodeDataItemsSentinel];
 
+  // Heap occupancy in bytes per node, indexed by node index.
+  size_t* _occupancy[OccupancyItemsSentinel];
+
   void print_info(G1NUMAStats::NodeDataItems phase);
 
   void print_mutator_alloc_stat_debug();
 
+  void print_occupancy();
+
 public:
   G1NUMAStats(const int* node_ids, uint num_node_ids);
   ~G1NUMAStats();
@@ -113,6 +128,10 @@ public:
   // Precondition: allocated_stat should have same length of active nodes.
   void copy(G1NUMAStats::NodeDataItems phase, uint requested_node_index, size_t* allocated_stat);
 
+  void clear_occupancy();
+  // Add the given bytes to the occupancy of the given node.
+  void add_occupancy(G1NUMAStats::OccupancyItems item, uint node_index, size_t bytes);
+
   void print_statistics();
 };
 
@@ -28,6 +28,7 @@
 #include "gc/g1/g1CollectionSet.hpp"
 #include "gc/g1/g1OopClosures.inline.hpp"
 #include "gc/g1/g1ParScanThreadState.inline.hpp"
+#include "gc/g1/g1PretenureTable.inline.hpp"
 #include "gc/g1/g1RootClosures.hpp"
 #include "gc/g1/g1StringDedup.hpp"
 #include "gc/g1/g1Trace.hpp"
@@ -79,7 +80,9 @@ G1ParScanThreadState::G1ParScanThreadState(G1CollectedHeap* g1h,
     _string_dedup_requests(),
     _num_optional_regions(optional_cset_length),
     _numa(g1h->numa()),
-    _obj_alloc_stat(NULL)
+    _obj_alloc_stat(NULL),
+    _pretenure_stats(NULL),
+    _pretenure_table(g1h->policy()->pretenure_table())
 {
   // We allocate number of young gen regions in the collection set plus one
   // entries, since entry 0 keeps track of surviving bytes for non-young regions.
@@ -103,6 +106,10 @@ G1ParScanThreadState::G1ParScanThreadState(G1CollectedHeap* g1h,
 
   _oops_into_optional_regions = new G1OopStarChunkedList[_num_optional_regions];
 
+  if (G1UsePretenuring) {
+    _pretenure_stats = new G1PretenureStats();
+  }
+
   initialize_numa_stats();
 }
 
@@ -112,6 +119,9 @@ size_t G1ParScanThreadState::flush(size_t* surviving_young_words) {
   // Update allocation statistics.
   _plab_allocator->flush_and_retire_stats();
   _g1h->policy()->record_age_table(&_age_table);
+  if (_pretenure_stats != NULL) {
+    _pretenure_table->merge(_pretenure_stats);
+  }
 
   size_t sum = 0;
   for (uint i = 0; i < _surviving_words_length; i++) {
@@ -127,6 +137,7 @@ G1ParScanThreadState::~G1ParScanThreadState() {
   FREE_C_HEAP_ARRAY(size_t, _surviving_young_words_base);
   delete[] _oops_into_optional_regions;
   FREE_C_HEAP_ARRAY(size_t, _obj_alloc_stat);
+  delete _pretenure_stats;
 }
 
 size_t G1ParScanThreadState::lab_waste_words() const {
@@ -431,6 +442,21 @@ oop G1ParScanThreadState::do_copy_to_survivor_space(G1HeapRegionAttr const regio
   HeapRegion* const from_region = _g1h->heap_region_containing(old);
   uint node_index = from_region->node_index();
 
+  if (_pretenure_stats != NULL &&
+      dest_attr.is_young() &&
+      from_region->is_eden() &&
+      _pretenure_table->should_pretenure(klass) &&
+      !_pretenure_stats->sample_pretenured()) {
+    // Instances of this klass are almost always tenured eventually; skip
+    // copying them through the survivor regions.
+    dest_attr = G1HeapRegionAttr::Old;
+  }
+
+  if (G1UseRegionPinning && from_region->has_pinned_objects()) {
+    // Objects in regions with pinned objects are kept in place.
+    return handle_evacuation_failure_par(old, old_mark, true /* cause_pinned */);
+  }
+
   HeapWord* obj_ptr = _plab_allocator->plab_allocate(dest_attr, word_sz, node_index);
 
   // PLAB allocations should succeed most of the time, so we'll
@@ -440,7 +466,7 @@ oop G1ParScanThreadState::do_copy_to_survivor_space(G1HeapRegionAttr const regio
     if (obj_ptr == NULL) {
       // This will either forward-to-self, or detect that someone else has
       // installed a forwarding pointer.
-      return handle_evacuation_failure_par(old, old_mark);
+      return handle_evacuation_failure_par(old, old_mark, false /* cause_pinned */);
     }
   }
 
@@ -453,7 +479,7 @@ oop G1ParScanThreadState::do_copy_to_survivor_space(G1HeapRegionAttr const regio
     // Doing this after all the allocation attempts also tests the
     // undo_allocation() method too.
     undo_allocation(dest_attr, obj_ptr, word_sz, node_index);
-    return handle_evacuation_failure_par(old, old_mark);
+    return handle_evacuation_failure_par(old, old_mark, false /* cause_pinned */);
   }
 #endif // !PRODUCT
 
@@ -472,6 +498,14 @@ oop G1ParScanThreadState::do_copy_to_survivor_space(G1HeapRegionAttr const regio
       _surviving_young_words[young_index] += word_sz;
     }
 
+    if (_pretenure_stats != NULL) {
+      if (from_region->is_eden() && dest_attr.is_young()) {
+        _pretenure_stats->record_survived(klass, word_sz);
+      } else if (from_region->is_survivor() && dest_attr.is_old()) {
+        _pretenure_stats->record_tenured(klass, word_sz);
+      }
+    }
+
     if (dest_attr.is_young()) {
       if (age < markWord::max_age) {
         age++;
@@ -590,7 +624,7 @@ void G1ParScanThreadStateSet::record_unused_optional_region(HeapRegion* hr) {
 }
 
 NOINLINE
-oop G1ParScanThreadState::handle_evacuation_failure_par(oop old, markWord m) {
+oop G1ParScanThreadState::handle_evacuation_failure_par(oop old, markWord m, bool cause_pinned) {
   assert(_g1h->is_in_cset(old), "Object " PTR_FORMAT " should be in the CSet", p2i(old));
 
   oop forward_ptr = old->forward_to_atomic(old, m, memory_order_relaxed);
@@ -598,10 +632,18 @@ oop G1ParScanThreadState::handle_evacuation_failure_par(oop old, markWord m) {
     // Forward-to-self succeeded. We are the "owner" of the object.
     HeapRegion* r = _g1h->heap_region_containing(old);
 
+    if (!cause_pinned) {
+      _g1h->set_evacuation_alloc_failed();
+    }
+
     if (_g1h->notify_region_failed_evacuation(r->hrm_index())) {
       _g1h->hr_printer()->evac_failure(r);
     }
 
+    // Mark the failing object in the prev bitmap so that processing after
+    // evacuation only needs to visit the failed objects.
+    _g1h->record_evac_failure_object(old);
+
     _g1h->preserve_mark_during_evac_failure(_worker_id, old, m);
 
     G1ScanInYoungSetter x(&_scanner, r->is_young());
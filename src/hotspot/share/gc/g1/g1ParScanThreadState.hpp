@@ -29,6 +29,7 @@
 #include "gc/g1/g1CollectedHeap.hpp"
 #include "gc/g1/g1RedirtyCardsQueue.hpp"
 #include "gc/g1/g1OopClosures.hpp"
+#include "gc/g1/g1PretenureTable.hpp"
 #include "gc/g1/g1RemSet.hpp"
 #include "gc/g1/heapRegionRemSet.hpp"
 #include "gc/shared/ageTable.hpp"
@@ -106,6 +107,11 @@ class G1ParScanThreadState : public CHeapObj<mtGC> {
   // transferred when flushed.
   size_t* _obj_alloc_stat;
 
+  // Per-klass survival samples for pretenuring decisions; only allocated if
+  // G1UsePretenuring is enabled.
+  G1PretenureStats* _pretenure_stats;
+  G1PretenureTable* _pretenure_table;
+
 public:
   G1ParScanThreadState(G1CollectedHeap* g1h,
                        G1RedirtyCardsQueueSet* rdcqs,
@@ -228,7 +234,7 @@ public:
   void reset_trim_ticks();
 
   // An attempt to evacuate "obj" has failed; take necessary steps.
-  oop handle_evacuation_failure_par(oop obj, markWord m);
+  oop handle_evacuation_failure_par(oop obj, markWord m, bool cause_pinned);
 
   template <typename T>
   inline void remember_root_into_optional_region(T* p);
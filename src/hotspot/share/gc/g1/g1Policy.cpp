@@ -82,12 +82,14 @@ G1Policy::G1Policy(STWGCTimer* gc_timer) :
   _mark_cleanup_start_sec(0),
   _tenuring_threshold(MaxTenuringThreshold),
   _max_survivor_regions(0),
-  _survivors_age_table(true)
+  _survivors_age_table(true),
+  _pretenure_table(G1UsePretenuring ? new G1PretenureTable() : NULL)
 {
 }
 
 G1Policy::~G1Policy() {
   delete _ihop_control;
+  delete _pretenure_table;
 }
 
 G1CollectorState* G1Policy::collector_state() const { return _g1h->collector_state(); }
@@ -771,6 +773,10 @@ void G1Policy::record_collection_pause_end(double pause_time_ms, bool concurrent
       _analytics->report_pending_cards((double) _pending_cards_at_gc_start);
       _analytics->report_rs_length((double) _rs_length);
     }
+
+    // Eden is empty at this point, so heap occupancy is the live data that
+    // survived this gc plus old and humongous objects.
+    _analytics->report_live_bytes_after_young_gc((double) _g1h->used());
   }
 
   assert(!(G1GCPauseTypeHelper::is_concurrent_start_pause(this_pause) && collector_state()->mark_or_rebuild_in_progress()),
@@ -823,13 +829,41 @@ void G1Policy::record_collection_pause_end(double pause_time_ms, bool concurrent
   }
 
   double const logged_cards_time = logged_cards_processing_time();
+  size_t const pending_cards_target = calculate_pending_cards_target(scan_logged_cards_time_goal_ms);
 
-  log_debug(gc, ergo, refine)("Concurrent refinement times: Logged Cards Scan time goal: %1.2fms Logged Cards Scan time: %1.2fms HCC time: %1.2fms",
-                              scan_logged_cards_time_goal_ms, logged_cards_time, merge_hcc_time_ms);
+  log_debug(gc, ergo, refine)("Concurrent refinement times: Logged Cards Scan time goal: %1.2fms Logged Cards Scan time: %1.2fms HCC time: %1.2fms "
+                              "Pending cards target: " SIZE_FORMAT,
+                              scan_logged_cards_time_goal_ms, logged_cards_time, merge_hcc_time_ms, pending_cards_target);
 
-  _g1h->concurrent_refine()->adjust(logged_cards_time,
-                                    phase_times()->sum_thread_work_items(G1GCPhaseTimes::MergeLB, G1GCPhaseTimes::MergeLBDirtyCards),
-                                    scan_logged_cards_time_goal_ms);
+  _g1h->concurrent_refine()->adjust(pending_cards_target);
+}
+
+size_t G1Policy::calculate_pending_cards_target(double goal_ms) const {
+  // Predicted cost to merge and scan a single logged card during the next pause.
+  bool for_young_gc = collector_state()->in_young_only_phase();
+  double cost_per_card_ms = _analytics->predict_card_merge_time_ms(1, for_young_gc) +
+                            _analytics->predict_card_scan_time_ms(1, for_young_gc);
+  if (goal_ms <= 0.0) {
+    return 0;
+  }
+  // Clamp as a double; converting a value that does not fit into size_t
+  // is undefined.
+  double const max_target = (double)G1ConcurrentRefine::max_green_zone_value();
+  if (cost_per_card_ms <= 0.0) {
+    // No meaningful prediction; let the pause handle everything.
+    return (size_t)max_target;
+  }
+  double target = goal_ms / cost_per_card_ms;
+  // Refinement only starts once the number of pending cards exceeds the
+  // target, and mutators keep dirtying cards while a refinement thread
+  // processes a buffer. Start refinement early enough to absorb that
+  // overshoot, so that the pause finds at most the target number of cards.
+  double refine_rate_ms = _analytics->predict_concurrent_refine_rate_ms();
+  if (refine_rate_ms > 0.0) {
+    double buffer_refine_time_ms = G1UpdateBufferSize / refine_rate_ms;
+    target -= _analytics->predict_dirtied_cards_rate_ms() * buffer_refine_time_ms;
+  }
+  return (size_t)clamp(target, 0.0, max_target);
 }
 
 G1IHOPControl* G1Policy::create_ihop_control(const G1OldGenAllocationTracker* old_gen_alloc_tracker,
@@ -980,6 +1014,13 @@ void G1Policy::print_age_table() {
   _survivors_age_table.print_age_table(_tenuring_threshold);
 }
 
+void G1Policy::update_pretenure_decisions() {
+  if (_pretenure_table != NULL) {
+    _pretenure_table->update();
+    log_debug(gc, ergo)("Pretenured classes: %u", _pretenure_table->num_pretenured());
+  }
+}
+
 void G1Policy::update_max_gc_locker_expansion() {
   uint expansion_region_num = 0;
   if (GCLockerEdenExpansionPercent > 0) {
@@ -1161,8 +1202,9 @@ void G1Policy::maybe_start_marking() {
 
 bool G1Policy::should_update_gc_stats() {
   // Evacuation failures skew the timing too much to be considered for statistics updates.
-  // We make the assumption that these are rare.
-  return !_g1h->evacuation_failed();
+  // We make the assumption that these are rare. Regions retained because of pinned
+  // objects only add a small amount of work.
+  return !_g1h->evacuation_alloc_failed();
 }
 
 void G1Policy::update_gc_pause_time_ratios(G1GCPauseType gc_type, double start_time_sec, double end_time_sec) {
@@ -33,6 +33,7 @@
 #include "gc/g1/g1OldGenAllocationTracker.hpp"
 #include "gc/g1/g1RemSetTrackingPolicy.hpp"
 #include "gc/g1/g1Predictions.hpp"
+#include "gc/g1/g1PretenureTable.hpp"
 #include "gc/g1/g1YoungGenSizer.hpp"
 #include "gc/shared/gcCause.hpp"
 #include "utilities/pair.hpp"
@@ -116,6 +117,9 @@ class G1Policy: public CHeapObj<mtGC> {
   }
 
   double logged_cards_processing_time() const;
+  // Number of pending cards the next pause can afford to process within the
+  // given time goal, based on the predicted card merge and scan costs.
+  size_t calculate_pending_cards_target(double goal_ms) const;
 public:
   const G1Predictions& predictor() const { return _predictor; }
   const G1Analytics* analytics()   const { return const_cast<const G1Analytics*>(_analytics); }
@@ -409,6 +413,9 @@ private:
 
   AgeTable _survivors_age_table;
 
+  // Per-klass pretenuring statistics and decisions, see G1UsePretenuring.
+  G1PretenureTable* _pretenure_table;
+
   size_t desired_survivor_size(uint max_regions) const;
 
   // Fraction used when predicting how many optional regions to include in
@@ -441,6 +448,11 @@ public:
 
   void print_age_table();
 
+  G1PretenureTable* pretenure_table() const { return _pretenure_table; }
+  // Update pretenuring decisions after the samples of all threads of the
+  // current collection have been merged.
+  void update_pretenure_decisions();
+
   void update_max_gc_locker_expansion();
 
   void update_survivors_policy();
@@ -0,0 +1,146 @@
+/*
+ * Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/g1/g1PretenureTable.inline.hpp"
+#include "gc/g1/g1_globals.hpp"
+#include "logging/log.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/klass.inline.hpp"
+
+void G1PretenureStats::clear() {
+  memset(_entries, 0, sizeof(_entries));
+}
+
+G1PretenureTable::G1PretenureTable() :
+  _entries(NEW_C_HEAP_ARRAY(Entry, Capacity, mtGC)),
+  _num_pretenured(0) {
+  memset(_entries, 0, Capacity * sizeof(Entry));
+}
+
+G1PretenureTable::~G1PretenureTable() {
+  FREE_C_HEAP_ARRAY(Entry, _entries);
+}
+
+G1PretenureTable::Entry* G1PretenureTable::find_or_insert(Entry* entries, Klass* klass) {
+  uint index = hash(klass);
+  for (uint i = 0; i < MaxProbes; i++, index++) {
+    Entry* e = &entries[index & (Capacity - 1)];
+    if (e->_klass == klass) {
+      return e;
+    } else if (e->_klass == NULL) {
+      e->_klass = klass;
+      return e;
+    }
+  }
+  return NULL;
+}
+
+void G1PretenureTable::merge(const G1PretenureStats* stats) {
+  for (uint i = 0; i < G1PretenureStats::Capacity; i++) {
+    const G1PretenureStats::Entry* sample = &stats->_entries[i];
+    if (sample->_klass == NULL) {
+      continue;
+    }
+    Entry* e = find_or_insert(_entries, sample->_klass);
+    if (e == NULL) {
+      continue;
+    }
+    e->_survived_bytes += (double)(sample->_survived_words * HeapWordSize);
+    e->_tenured_bytes += (double)(sample->_tenured_words * HeapWordSize);
+  }
+}
+
+void G1PretenureTable::update() {
+  double const threshold = G1PretenureThresholdPercent / 100.0;
+  double const revert_threshold = MAX2(G1PretenureThresholdPercent - RevertMarginPercent, 0.0) / 100.0;
+
+  for (uint i = 0; i < Capacity; i++) {
+    Entry* e = &_entries[i];
+    if (e->_klass == NULL) {
+      continue;
+    }
+    if (!e->_pretenure) {
+      if (e->_survived_bytes >= MinSurvivedBytesToPretenure &&
+          e->_tenured_bytes >= e->_survived_bytes * threshold) {
+        e->_pretenure = true;
+        _num_pretenured++;
+        if (log_is_enabled(Debug, gc, ergo)) {
+          ResourceMark rm;
+          log_debug(gc, ergo)("Pretenure %s (survived: %.0fB tenured: %.0fB)",
+                              e->_klass->external_name(), e->_survived_bytes, e->_tenured_bytes);
+        }
+      }
+    } else if (e->_survived_bytes >= MinSurvivedBytesToRevert &&
+               e->_tenured_bytes < e->_survived_bytes * revert_threshold) {
+      // Only the sampled instances of a pretenured klass contribute to its
+      // statistics, so the ratio is still meaningful.
+      e->_pretenure = false;
+      _num_pretenured--;
+      if (log_is_enabled(Debug, gc, ergo)) {
+        ResourceMark rm;
+        log_debug(gc, ergo)("Stop pretenuring %s (survived: %.0fB tenured: %.0fB)",
+                            e->_klass->external_name(), e->_survived_bytes, e->_tenured_bytes);
+      }
+    }
+    e->_survived_bytes *= DecayFactor;
+    e->_tenured_bytes *= DecayFactor;
+  }
+  compact(false /* class_unloading_occurred */);
+}
+
+void G1PretenureTable::remove_unloaded_klasses() {
+  compact(true /* class_unloading_occurred */);
+}
+
+void G1PretenureTable::compact(bool class_unloading_occurred) {
+  Entry* new_entries = NEW_C_HEAP_ARRAY(Entry, Capacity, mtGC);
+  memset(new_entries, 0, Capacity * sizeof(Entry));
+
+  uint num_pretenured = 0;
+  for (uint i = 0; i < Capacity; i++) {
+    Entry* e = &_entries[i];
+    if (e->_klass == NULL) {
+      continue;
+    }
+    if (class_unloading_occurred && !e->_klass->is_loader_alive()) {
+      continue;
+    }
+    if (!e->_pretenure && e->_survived_bytes < MinRetainedBytes) {
+      continue;
+    }
+    Entry* new_entry = find_or_insert(new_entries, e->_klass);
+    if (new_entry == NULL) {
+      continue;
+    }
+    *new_entry = *e;
+    if (e->_pretenure) {
+      num_pretenured++;
+    }
+  }
+
+  FREE_C_HEAP_ARRAY(Entry, _entries);
+  _entries = new_entries;
+  _num_pretenured = num_pretenured;
+}
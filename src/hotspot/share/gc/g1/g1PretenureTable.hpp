@@ -0,0 +1,154 @@
+/*
+ * Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_GC_G1_G1PRETENURETABLE_HPP
+#define SHARE_GC_G1_G1PRETENURETABLE_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+class Klass;
+
+// Per-klass pretenuring support.
+//
+// Objects of some classes almost always live until they are tenured, i.e.
+// they are copied from eden into survivor regions and then between survivor
+// regions until they reach the tenuring threshold. Copying them directly into
+// the old generation the first time they are evacuated from eden saves all the
+// intermediate copies.
+//
+// During evacuation every G1ParScanThreadState records, per klass, the number
+// of words copied from eden into survivor regions and the number of words
+// tenured from survivor regions into the old generation into its own
+// G1PretenureStats. These are merged into the global G1PretenureTable at the
+// end of evacuation, which then decides which klasses to pretenure from the
+// decayed ratio of tenured to survived words.
+//
+// A small sample of the instances of pretenured klasses is still copied into
+// survivor regions, so that the ratio keeps being measured for them. A klass
+// stops being pretenured once that ratio falls clearly below the threshold.
+
+// Thread local samples collected during a single evacuation.
+class G1PretenureStats : public CHeapObj<mtGC> {
+  friend class G1PretenureTable;
+
+  struct Entry {
+    Klass* _klass;
+    size_t _survived_words;
+    size_t _tenured_words;
+  };
+
+  // Must be a power of two.
+  static const uint Capacity = 256;
+  // Samples for klasses that can not be placed within that many probes are
+  // dropped.
+  static const uint MaxProbes = 8;
+
+  // Every that many'th object of a pretenured klass is still copied into a
+  // survivor region.
+  static const uint PretenuredSampleInterval = 16;
+
+  Entry _entries[Capacity];
+  uint _num_pretenure_candidates;
+
+  inline Entry* entry_for(Klass* klass);
+
+public:
+  G1PretenureStats() : _num_pretenure_candidates(0) { clear(); }
+
+  void clear();
+
+  // Record that word_sz words of the given klass were copied from eden into
+  // a survivor region.
+  inline void record_survived(Klass* klass, size_t word_sz);
+  // Record that word_sz words of the given klass were copied from a survivor
+  // region into the old generation.
+  inline void record_tenured(Klass* klass, size_t word_sz);
+
+  // Returns whether an object of a pretenured klass should be copied into a
+  // survivor region anyway to keep sampling that klass.
+  inline bool sample_pretenured();
+};
+
+// Global pretenuring statistics and decisions. Only modified while no
+// evacuation is in progress, so lookups during evacuation need no
+// synchronization.
+class G1PretenureTable : public CHeapObj<mtGC> {
+  friend class G1PretenureStats;
+
+  struct Entry {
+    Klass* _klass;
+    double _survived_bytes;
+    double _tenured_bytes;
+    bool _pretenure;
+  };
+
+  // Must be a power of two.
+  static const uint Capacity = 1024;
+  static const uint MaxProbes = 16;
+
+  // Weight of past samples when merging in the samples of a new collection.
+  static constexpr double DecayFactor = 0.9;
+  // Entries whose decayed survived bytes drop below this value and that
+  // are not pretenured are removed.
+  static constexpr double MinRetainedBytes = 1.0 * K;
+  // Minimum decayed survived bytes before a klass may be pretenured.
+  static constexpr double MinSurvivedBytesToPretenure = 64.0 * K;
+  // Minimum decayed survived bytes of the sampled instances of a pretenured
+  // klass before that decision may be reverted.
+  static constexpr double MinSurvivedBytesToRevert =
+    MinSurvivedBytesToPretenure / G1PretenureStats::PretenuredSampleInterval;
+  // A klass stops being pretenured if its tenured ratio drops this many
+  // percentage points below G1PretenureThresholdPercent.
+  static constexpr double RevertMarginPercent = 10.0;
+
+  Entry* _entries;
+  uint _num_pretenured;
+
+  static inline uint hash(Klass* klass);
+
+  Entry* find_or_insert(Entry* entries, Klass* klass);
+  // Rehash all entries that are retained; if class_unloading_occurred, drop
+  // entries for klasses that have been unloaded.
+  void compact(bool class_unloading_occurred);
+
+public:
+  G1PretenureTable();
+  ~G1PretenureTable();
+
+  // Merge samples of a single thread. Must be called after all samples of the
+  // current evacuation have been collected.
+  void merge(const G1PretenureStats* stats);
+  // Update pretenuring decisions after all per thread samples of a collection
+  // have been merged, and age the samples.
+  void update();
+  // Remove all entries referencing klasses that have been unloaded.
+  void remove_unloaded_klasses();
+
+  inline bool should_pretenure(Klass* klass) const;
+
+  uint num_pretenured() const { return _num_pretenured; }
+};
+
+#endif // SHARE_GC_G1_G1PRETENURETABLE_HPP
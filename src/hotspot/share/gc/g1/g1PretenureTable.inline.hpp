@@ -0,0 +1,83 @@
+/*
+ * Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_GC_G1_G1PRETENURETABLE_INLINE_HPP
+#define SHARE_GC_G1_G1PRETENURETABLE_INLINE_HPP
+
+#include "gc/g1/g1PretenureTable.hpp"
+
+inline uint G1PretenureTable::hash(Klass* klass) {
+  uintptr_t value = (uintptr_t)klass >> LogHeapWordSize;
+  return (uint)(value ^ (value >> 16));
+}
+
+inline G1PretenureStats::Entry* G1PretenureStats::entry_for(Klass* klass) {
+  uint index = G1PretenureTable::hash(klass);
+  for (uint i = 0; i < MaxProbes; i++, index++) {
+    Entry* e = &_entries[index & (Capacity - 1)];
+    if (e->_klass == klass) {
+      return e;
+    } else if (e->_klass == NULL) {
+      e->_klass = klass;
+      return e;
+    }
+  }
+  return NULL;
+}
+
+inline void G1PretenureStats::record_survived(Klass* klass, size_t word_sz) {
+  Entry* e = entry_for(klass);
+  if (e != NULL) {
+    e->_survived_words += word_sz;
+  }
+}
+
+inline void G1PretenureStats::record_tenured(Klass* klass, size_t word_sz) {
+  Entry* e = entry_for(klass);
+  if (e != NULL) {
+    e->_tenured_words += word_sz;
+  }
+}
+
+inline bool G1PretenureStats::sample_pretenured() {
+  return (++_num_pretenure_candidates % PretenuredSampleInterval) == 0;
+}
+
+inline bool G1PretenureTable::should_pretenure(Klass* klass) const {
+  if (_num_pretenured == 0) {
+    return false;
+  }
+  uint index = hash(klass);
+  for (uint i = 0; i < MaxProbes; i++, index++) {
+    const Entry* e = &_entries[index & (Capacity - 1)];
+    if (e->_klass == klass) {
+      return e->_pretenure;
+    } else if (e->_klass == NULL) {
+      break;
+    }
+  }
+  return false;
+}
+
+#endif // SHARE_GC_G1_G1PRETENURETABLE_INLINE_HPP
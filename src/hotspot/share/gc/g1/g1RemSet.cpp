@@ -629,101 +629,47 @@ double G1RemSet::sampling_task_vtime() {
 // Helper class to scan and detect ranges of cards that need to be scanned on the
 // card table.
 class G1CardTableScanner : public StackObj {
-public:
-  typedef CardTable::CardValue CardValue;
-
-private:
-  CardValue* const _base_addr;
+  G1CardTable* const _ct;
 
-  CardValue* _cur_addr;
-  CardValue* const _end_addr;
-
-  static const size_t ToScanMask = G1CardTable::g1_card_already_scanned;
-  static const size_t ExpandedToScanMask = G1CardTable::WordAlreadyScanned;
-
-  bool cur_addr_aligned() const {
-    return ((uintptr_t)_cur_addr) % sizeof(size_t) == 0;
-  }
-
-  bool cur_card_is_dirty() const {
-    CardValue value = *_cur_addr;
-    return (value & ToScanMask) == 0;
-  }
-
-  bool cur_word_of_cards_contains_any_dirty_card() const {
-    assert(cur_addr_aligned(), "Current address should be aligned");
-    size_t const value = *(size_t*)_cur_addr;
-    return (~value & ExpandedToScanMask) != 0;
-  }
-
-  bool cur_word_of_cards_all_dirty_cards() const {
-    size_t const value = *(size_t*)_cur_addr;
-    return value == G1CardTable::WordAllDirty;
-  }
-
-  size_t get_and_advance_pos() {
-    _cur_addr++;
-    return pointer_delta(_cur_addr, _base_addr, sizeof(CardValue)) - 1;
-  }
+  size_t const _base_idx;
+  size_t _cur_idx;
+  size_t const _end_idx;
 
 public:
-  G1CardTableScanner(CardValue* start_card, size_t size) :
-    _base_addr(start_card),
-    _cur_addr(start_card),
-    _end_addr(start_card + size) {
-
-    assert(is_aligned(start_card, sizeof(size_t)), "Unaligned start addr " PTR_FORMAT, p2i(start_card));
+  G1CardTableScanner(G1CardTable* ct, size_t start_card_idx, size_t size) :
+    _ct(ct),
+    _base_idx(start_card_idx),
+    _cur_idx(start_card_idx),
+    _end_idx(start_card_idx + size) {
+
+    assert(is_aligned(ct->byte_for_index(start_card_idx), sizeof(size_t)),
+           "Unaligned start addr " PTR_FORMAT, p2i(ct->byte_for_index(start_card_idx)));
     assert(is_aligned(size, sizeof(size_t)), "Unaligned size " SIZE_FORMAT, size);
   }
 
+  // Returns the offset of the next Dirty card relative to the start of the
+  // range, or the size of the range if there is none.
   size_t find_next_dirty() {
-    while (!cur_addr_aligned()) {
-      if (cur_card_is_dirty()) {
-        return get_and_advance_pos();
-      }
-      _cur_addr++;
-    }
-
-    assert(cur_addr_aligned(), "Current address should be aligned now.");
-    while (_cur_addr != _end_addr) {
-      if (cur_word_of_cards_contains_any_dirty_card()) {
-        for (size_t i = 0; i < sizeof(size_t); i++) {
-          if (cur_card_is_dirty()) {
-            return get_and_advance_pos();
-          }
-          _cur_addr++;
-        }
-        assert(false, "Should not reach here given we detected a dirty card in the word.");
-      }
-      _cur_addr += sizeof(size_t);
-    }
-    return get_and_advance_pos();
+    _cur_idx = _ct->find_first_dirty_card(_cur_idx, _end_idx);
+    return next_pos();
   }
 
+  // Returns the offset of the next non-Dirty card relative to the start of the
+  // range, or the size of the range if there is none.
   size_t find_next_non_dirty() {
-    assert(_cur_addr <= _end_addr, "Not allowed to search for marks after area.");
-
-    while (!cur_addr_aligned()) {
-      if (!cur_card_is_dirty()) {
-        return get_and_advance_pos();
-      }
-      _cur_addr++;
-    }
+    assert(_cur_idx <= _end_idx, "Not allowed to search for marks after area.");
+    _cur_idx = _ct->find_first_non_dirty_card(_cur_idx, _end_idx);
+    return next_pos();
+  }
 
-    assert(cur_addr_aligned(), "Current address should be aligned now.");
-    while (_cur_addr != _end_addr) {
-      if (!cur_word_of_cards_all_dirty_cards()) {
-        for (size_t i = 0; i < sizeof(size_t); i++) {
-          if (!cur_card_is_dirty()) {
-            return get_and_advance_pos();
-          }
-          _cur_addr++;
-        }
-        assert(false, "Should not reach here given we detected a non-dirty card in the word.");
-      }
-      _cur_addr += sizeof(size_t);
+private:
+  size_t next_pos() {
+    size_t const result = _cur_idx - _base_idx;
+    // Continue searching after the card found.
+    if (_cur_idx < _end_idx) {
+      _cur_idx++;
     }
-    return get_and_advance_pos();
+    return result;
   }
 };
 
@@ -839,9 +785,8 @@ class G1ScanHRForRegionClosure : public HeapRegionClosure {
 
     while (claim.has_next()) {
       size_t const region_card_base_idx = ((size_t)region_idx << HeapRegion::LogCardsPerRegion) + claim.value();
-      CardTable::CardValue* const base_addr = _ct->byte_for_index(region_card_base_idx);
 
-      G1CardTableScanner scan(base_addr, claim.size());
+      G1CardTableScanner scan(_ct, region_card_base_idx, claim.size());
 
       size_t first_scan_idx = scan.find_next_dirty();
       while (first_scan_idx != claim.size()) {
@@ -1122,6 +1067,7 @@ class G1MergeHeapRootsTask : public AbstractGangTask {
     G1CardTable* _ct;
 
     uint _merged_sparse;
+    uint _merged_array;
     uint _merged_fine;
     uint _merged_coarse;
 
@@ -1174,6 +1120,7 @@ class G1MergeHeapRootsTask : public AbstractGangTask {
       _scan_state(scan_state),
       _ct(G1CollectedHeap::heap()->card_table()),
       _merged_sparse(0),
+      _merged_array(0),
       _merged_fine(0),
       _merged_coarse(0),
       _cards_dirty(0),
@@ -1215,6 +1162,19 @@ class G1MergeHeapRootsTask : public AbstractGangTask {
       }
     }
 
+    void next_array_prt(uint const region_idx, PerRegionTable::card_elem_t* cards, uint const num_cards) {
+      if (!remember_if_interesting(region_idx)) {
+        return;
+      }
+
+      _merged_array++;
+
+      start_iterate(region_idx);
+      for (uint i = 0; i < num_cards; i++) {
+        do_card(cards[i]);
+      }
+    }
+
     void next_sparse_prt(uint const region_idx, SparsePRTEntry::card_elem_t* cards, uint const num_cards) {
       if (!remember_if_interesting(region_idx)) {
         return;
@@ -1261,6 +1221,7 @@ class G1MergeHeapRootsTask : public AbstractGangTask {
     }
 
     size_t merged_sparse() const { return _merged_sparse; }
+    size_t merged_array() const { return _merged_array; }
     size_t merged_fine() const { return _merged_fine; }
     size_t merged_coarse() const { return _merged_coarse; }
 
@@ -1308,6 +1269,7 @@ class G1MergeHeapRootsTask : public AbstractGangTask {
     }
 
     size_t merged_sparse() const { return _cl.merged_sparse(); }
+    size_t merged_array() const { return _cl.merged_array(); }
     size_t merged_fine() const { return _cl.merged_fine(); }
     size_t merged_coarse() const { return _cl.merged_coarse(); }
 
@@ -1443,6 +1405,7 @@ public:
       g1h->heap_region_iterate(&cl);
 
       p->record_or_add_thread_work_item(merge_remset_phase, worker_id, cl.merged_sparse(), G1GCPhaseTimes::MergeRSMergedSparse);
+      p->record_or_add_thread_work_item(merge_remset_phase, worker_id, cl.merged_array(), G1GCPhaseTimes::MergeRSMergedArray);
       p->record_or_add_thread_work_item(merge_remset_phase, worker_id, cl.merged_fine(), G1GCPhaseTimes::MergeRSMergedFine);
       p->record_or_add_thread_work_item(merge_remset_phase, worker_id, cl.merged_coarse(), G1GCPhaseTimes::MergeRSMergedCoarse);
       p->record_or_add_thread_work_item(merge_remset_phase, worker_id, cl.cards_dirty(), G1GCPhaseTimes::MergeRSDirtyCards);
@@ -1455,6 +1418,7 @@ public:
       g1h->collection_set_iterate_increment_from(&cl, &_hr_claimer, worker_id);
 
       p->record_or_add_thread_work_item(merge_remset_phase, worker_id, cl.merged_sparse(), G1GCPhaseTimes::MergeRSMergedSparse);
+      p->record_or_add_thread_work_item(merge_remset_phase, worker_id, cl.merged_array(), G1GCPhaseTimes::MergeRSMergedArray);
       p->record_or_add_thread_work_item(merge_remset_phase, worker_id, cl.merged_fine(), G1GCPhaseTimes::MergeRSMergedFine);
       p->record_or_add_thread_work_item(merge_remset_phase, worker_id, cl.merged_coarse(), G1GCPhaseTimes::MergeRSMergedCoarse);
       p->record_or_add_thread_work_item(merge_remset_phase, worker_id, cl.cards_dirty(), G1GCPhaseTimes::MergeRSDirtyCards);
@@ -1745,12 +1709,145 @@ void G1RemSet::print_summary_info() {
 }
 
 class G1RebuildRemSetTask: public AbstractGangTask {
-  // Aggregate the counting data that was constructed concurrently
-  // with marking.
-  class G1RebuildRemSetHeapRegionClosure : public HeapRegionClosure {
+  // Distributes the work for the rebuild. Every region is split into card aligned
+  // chunks of (at most) G1RebuildRemSetChunkSize bytes. Every worker owns a contiguous range
+  // of these chunks which it claims in address order. After exhausting its own
+  // range, a worker steals chunks from the ranges of the other workers, so that
+  // a few densely populated regions do not keep a single worker busy while the
+  // others are idle.
+  // Chunks at or above the TARS of a region, or in regions not selected for
+  // rebuild, are skipped without being handed out.
+  class G1RebuildRemSetChunkClaimer : public StackObj {
+    struct ChunkRange {
+      size_t volatile _cur;
+      size_t _end;
+    };
+
+    G1CollectedHeap* _g1h;
     G1ConcurrentMark* _cm;
+    size_t const _chunk_size_in_words;
+    size_t const _chunks_per_region;
+    uint const _num_workers;
+    ChunkRange* _ranges;
+
+    uint region_idx_for_chunk(size_t chunk) const {
+      return (uint)(chunk / _chunks_per_region);
+    }
+
+    // Returns whether the chunk does not contain anything to scan. In this case the
+    // remainder of that region does not either.
+    bool is_empty_chunk(size_t chunk) const {
+      uint const region_idx = region_idx_for_chunk(chunk);
+      HeapWord* const top_at_rebuild_start = _cm->top_at_rebuild_start(region_idx);
+      if (top_at_rebuild_start == NULL) {
+        return true;
+      }
+      return chunk_start(chunk) >= top_at_rebuild_start;
+    }
+
+    bool claim_in_range(ChunkRange* range, size_t& chunk) {
+      size_t cur = Atomic::load(&range->_cur);
+      while (cur < range->_end) {
+        bool const skip_region = is_empty_chunk(cur);
+        size_t const next = skip_region ? MIN2(((size_t)region_idx_for_chunk(cur) + 1) * _chunks_per_region, range->_end)
+                                        : cur + 1;
+        size_t const witness = Atomic::cmpxchg(&range->_cur, cur, next);
+        if (witness != cur) {
+          cur = witness;
+        } else if (skip_region) {
+          cur = next;
+        } else {
+          chunk = cur;
+          return true;
+        }
+      }
+      return false;
+    }
+
+  public:
+    G1RebuildRemSetChunkClaimer(G1CollectedHeap* g1h, G1ConcurrentMark* cm, uint num_workers) :
+      _g1h(g1h),
+      _cm(cm),
+      _chunk_size_in_words(MIN2(align_up(G1RebuildRemSetChunkSize, (size_t)G1CardTable::card_size), HeapRegion::GrainBytes) / HeapWordSize),
+      _chunks_per_region((HeapRegion::GrainWords + _chunk_size_in_words - 1) / _chunk_size_in_words),
+      _num_workers(num_workers),
+      _ranges(NEW_C_HEAP_ARRAY(ChunkRange, num_workers, mtGC)) {
+
+      size_t const num_regions = g1h->max_regions();
+      for (uint i = 0; i < num_workers; i++) {
+        // Align the ranges to regions to avoid workers sharing regions initially.
+        _ranges[i]._cur = num_regions * i / num_workers * _chunks_per_region;
+        _ranges[i]._end = num_regions * (i + 1) / num_workers * _chunks_per_region;
+      }
+    }
+
+    ~G1RebuildRemSetChunkClaimer() {
+      FREE_C_HEAP_ARRAY(ChunkRange, _ranges);
+    }
+
+    size_t chunk_size_in_words() const { return _chunk_size_in_words; }
+
+    HeapRegion* region_for_chunk(size_t chunk) const {
+      return _g1h->region_at(region_idx_for_chunk(chunk));
+    }
+
+    HeapWord* chunk_start(size_t chunk) const {
+      return _g1h->bottom_addr_for_region(region_idx_for_chunk(chunk)) +
+             (chunk % _chunks_per_region) * _chunk_size_in_words;
+    }
+
+    // Claim the next chunk to scan for the given worker, first from its own
+    // range, then from the ranges of the other workers. Sets stolen if the
+    // chunk has been taken from another worker's range.
+    bool claim(uint worker_id, size_t& chunk, bool& stolen) {
+      for (uint i = 0; i < _num_workers; i++) {
+        uint const range_idx = (worker_id + i) % _num_workers;
+        if (claim_in_range(&_ranges[range_idx], chunk)) {
+          stolen = (i != 0);
+          return true;
+        }
+      }
+      return false;
+    }
+  };
+
+  // Rebuilds the remembered sets for the chunks claimed by a single worker.
+  class G1RebuildRemSetChunkClosure : public StackObj {
+    // Number of words to scan between checks whether the current step should end.
+    static const size_t StepCheckWordsInterval = 4 * K;
+
+    G1ConcurrentMark* _cm;
+    G1RebuildRemSetTask* _task;
     G1RebuildRemSetClosure _update_cl;
 
+    // Time based step termination: a worker ends the current step within a chunk
+    // if a yield has been requested or the step took more than
+    // G1ConcMarkStepDurationMillis. This bounds the time between yield checks and
+    // the revalidation of the region's TARS independent of the chunk size and the
+    // density of references within it.
+    jlong const _step_duration_ticks;
+    jlong _step_start_ticks;
+    size_t _words_since_step_check;
+
+    size_t _chunks_processed;
+    size_t _chunks_stolen;
+    size_t _steps_ended_early;
+
+    void start_step() {
+      _step_start_ticks = os::elapsed_counter();
+      _words_since_step_check = 0;
+    }
+
+    bool should_end_step(size_t scanned_words) {
+      _words_since_step_check += scanned_words;
+      if (_words_since_step_check < StepCheckWordsInterval) {
+        return false;
+      }
+      _words_since_step_check = 0;
+      return SuspendibleThreadSet::should_yield() ||
+             (os::elapsed_counter() - _step_start_ticks) > _step_duration_ticks;
+    }
+
     // Applies _update_cl to the references of the given object, limiting objArrays
     // to the given MemRegion. Returns the amount of words actually scanned.
     size_t scan_for_references(oop const obj, MemRegion mr) {
@@ -1849,14 +1946,15 @@ class G1RebuildRemSetTask: public AbstractGangTask {
     // Rebuild remembered sets in the part of the region specified by mr and hr.
     // Objects between the bottom of the region and the TAMS are checked for liveness
     // using the given bitmap. Objects between TAMS and TARS are assumed to be live.
-    // Returns the number of live words between bottom and TAMS.
-    size_t rebuild_rem_set_in_region(const G1CMBitMap* const bitmap,
-                                     HeapWord* const top_at_mark_start,
-                                     HeapWord* const top_at_rebuild_start,
-                                     HeapRegion* hr,
-                                     MemRegion mr) {
-      size_t marked_words = 0;
-
+    // Adds the number of live bytes between bottom and TAMS to marked_bytes.
+    // Returns the address up to which the MemRegion has been processed, which is
+    // below the end of mr if the current step ended early.
+    HeapWord* rebuild_rem_set_in_region(const G1CMBitMap* const bitmap,
+                                        HeapWord* const top_at_mark_start,
+                                        HeapWord* const top_at_rebuild_start,
+                                        HeapRegion* hr,
+                                        MemRegion mr,
+                                        size_t& marked_bytes) {
       if (hr->is_humongous()) {
         oop const humongous_obj = cast_to_oop(hr->humongous_start_region()->bottom());
         if (is_humongous_live(humongous_obj, bitmap, top_at_mark_start, top_at_rebuild_start)) {
@@ -1869,35 +1967,34 @@ class G1RebuildRemSetTask: public AbstractGangTask {
           assert(hr->top() == top_at_mark_start || hr->top() == top_at_rebuild_start,
                  "More than one object in the humongous region?");
           humongous_obj->oop_iterate(&_update_cl, mr);
-          return top_at_mark_start != hr->bottom() ? mr.intersection(MemRegion(cast_from_oop<HeapWord*>(humongous_obj), humongous_obj->size())).byte_size() : 0;
-        } else {
-          return 0;
+          if (top_at_mark_start != hr->bottom()) {
+            marked_bytes += mr.intersection(MemRegion(cast_from_oop<HeapWord*>(humongous_obj), humongous_obj->size())).byte_size();
+          }
         }
+        return mr.end();
       }
 
+      bool end_step = false;
       for (LiveObjIterator it(bitmap, top_at_mark_start, mr, hr->block_start(mr.start())); it.has_next(); it.move_to_next()) {
         oop obj = it.next();
+        HeapWord* const obj_addr = cast_from_oop<HeapWord*>(obj);
+        // Only end the step at objects starting within mr to guarantee progress.
+        if (end_step && obj_addr > mr.start()) {
+          return obj_addr;
+        }
         size_t scanned_size = scan_for_references(obj, mr);
-        if (cast_from_oop<HeapWord*>(obj) < top_at_mark_start) {
-          marked_words += scanned_size;
+        if (obj_addr < top_at_mark_start) {
+          marked_bytes += scanned_size * HeapWordSize;
         }
+        end_step = end_step || should_end_step(scanned_size);
       }
-
-      return marked_words * HeapWordSize;
+      return mr.end();
     }
-public:
-  G1RebuildRemSetHeapRegionClosure(G1CollectedHeap* g1h,
-                                   G1ConcurrentMark* cm,
-                                   uint worker_id) :
-    HeapRegionClosure(),
-    _cm(cm),
-    _update_cl(g1h, worker_id) { }
-
-    bool do_heap_region(HeapRegion* hr) {
-      if (_cm->has_aborted()) {
-        return true;
-      }
 
+    // Rebuild the remembered sets for the given chunk of the region. The chunk is
+    // processed in steps; after every step the worker checks for a yield request,
+    // and whether the region has been eagerly reclaimed in the meantime.
+    void rebuild_rem_set_in_chunk(HeapRegion* hr, HeapWord* chunk_start) {
       uint const region_idx = hr->hrm_index();
       DEBUG_ONLY(HeapWord* const top_at_rebuild_start_check = _cm->top_at_rebuild_start(region_idx);)
       assert(top_at_rebuild_start_check == NULL ||
@@ -1905,85 +2002,127 @@ public:
              "A TARS (" PTR_FORMAT ") == bottom() (" PTR_FORMAT ") indicates the old region %u is empty (%s)",
              p2i(top_at_rebuild_start_check), p2i(hr->bottom()),  region_idx, hr->get_type_str());
 
-      size_t total_marked_bytes = 0;
-      size_t const chunk_size_in_words = G1RebuildRemSetChunkSize / HeapWordSize;
-
       HeapWord* const top_at_mark_start = hr->prev_top_at_mark_start();
+      HeapWord* const chunk_end = MIN2(chunk_start + _task->_claimer.chunk_size_in_words(), hr->end());
 
-      HeapWord* cur = hr->bottom();
-      while (cur < hr->end()) {
-        // After every iteration (yield point) we need to check whether the region's
+      size_t marked_bytes = 0;
+      Tickspan time;
+
+      HeapWord* cur = chunk_start;
+      while (cur < chunk_end) {
+        // After every step (yield point) we need to check whether the region's
         // TARS changed due to e.g. eager reclaim.
         HeapWord* const top_at_rebuild_start = _cm->top_at_rebuild_start(region_idx);
         if (top_at_rebuild_start == NULL) {
-          return false;
+          return;
         }
 
-        MemRegion next_chunk = MemRegion(hr->bottom(), top_at_rebuild_start).intersection(MemRegion(cur, chunk_size_in_words));
-        if (next_chunk.is_empty()) {
+        MemRegion next_step = MemRegion(hr->bottom(), top_at_rebuild_start).intersection(MemRegion(cur, chunk_end));
+        if (next_step.is_empty()) {
           break;
         }
 
         const Ticks start = Ticks::now();
-        size_t marked_bytes = rebuild_rem_set_in_region(_cm->prev_mark_bitmap(),
-                                                        top_at_mark_start,
-                                                        top_at_rebuild_start,
-                                                        hr,
-                                                        next_chunk);
-        Tickspan time = Ticks::now() - start;
-
-        log_trace(gc, remset, tracking)("Rebuilt region %u "
-                                        "live " SIZE_FORMAT " "
-                                        "time %.3fms "
-                                        "marked bytes " SIZE_FORMAT " "
-                                        "bot " PTR_FORMAT " "
-                                        "TAMS " PTR_FORMAT " "
-                                        "TARS " PTR_FORMAT,
-                                        region_idx,
-                                        _cm->live_bytes(region_idx),
-                                        time.seconds() * 1000.0,
-                                        marked_bytes,
-                                        p2i(hr->bottom()),
-                                        p2i(top_at_mark_start),
-                                        p2i(top_at_rebuild_start));
-
-        if (marked_bytes > 0) {
-          total_marked_bytes += marked_bytes;
+        start_step();
+        cur = rebuild_rem_set_in_region(_cm->prev_mark_bitmap(),
+                                        top_at_mark_start,
+                                        top_at_rebuild_start,
+                                        hr,
+                                        next_step,
+                                        marked_bytes);
+        time += Ticks::now() - start;
+
+        if (cur < next_step.end()) {
+          _steps_ended_early++;
         }
-        cur += chunk_size_in_words;
 
         _cm->do_yield_check();
         if (_cm->has_aborted()) {
-          return true;
+          return;
         }
       }
-      // In the final iteration of the loop the region might have been eagerly reclaimed.
-      // Simply filter out those regions. We can not just use region type because there
-      // might have already been new allocations into these regions.
-      DEBUG_ONLY(HeapWord* const top_at_rebuild_start = _cm->top_at_rebuild_start(region_idx);)
-      assert(top_at_rebuild_start == NULL ||
-             total_marked_bytes == hr->marked_bytes(),
-             "Marked bytes " SIZE_FORMAT " for region %u (%s) in [bottom, TAMS) do not match calculated marked bytes " SIZE_FORMAT " "
-             "(" PTR_FORMAT " " PTR_FORMAT " " PTR_FORMAT ")",
-             total_marked_bytes, hr->hrm_index(), hr->get_type_str(), hr->marked_bytes(),
-             p2i(hr->bottom()), p2i(top_at_mark_start), p2i(top_at_rebuild_start));
-       // Abort state may have changed after the yield check.
-      return _cm->has_aborted();
+
+      _task->add_region_progress(region_idx, marked_bytes, time);
     }
+
+  public:
+    G1RebuildRemSetChunkClosure(G1CollectedHeap* g1h,
+                                G1ConcurrentMark* cm,
+                                G1RebuildRemSetTask* task,
+                                uint worker_id) :
+      _cm(cm),
+      _task(task),
+      _update_cl(g1h, worker_id),
+      _step_duration_ticks((jlong)(G1ConcMarkStepDurationMillis * os::elapsed_frequency() / 1000.0)),
+      _step_start_ticks(0),
+      _words_since_step_check(0),
+      _chunks_processed(0),
+      _chunks_stolen(0),
+      _steps_ended_early(0) { }
+
+    void do_chunks(uint worker_id) {
+      size_t chunk;
+      bool stolen;
+      while (!_cm->has_aborted() && _task->_claimer.claim(worker_id, chunk, stolen)) {
+        rebuild_rem_set_in_chunk(_task->_claimer.region_for_chunk(chunk),
+                                 _task->_claimer.chunk_start(chunk));
+        _chunks_processed++;
+        if (stolen) {
+          _chunks_stolen++;
+        }
+      }
+    }
+
+    size_t chunks_processed() const { return _chunks_processed; }
+    size_t chunks_stolen() const { return _chunks_stolen; }
+    size_t steps_ended_early() const { return _steps_ended_early; }
   };
 
-  HeapRegionClaimer _hr_claimer;
   G1ConcurrentMark* _cm;
+  G1RebuildRemSetChunkClaimer _claimer;
+
+  // Per-region progress of the rebuild: the number of live bytes below TAMS
+  // found so far, and the total time spent scanning the region.
+  size_t volatile* _marked_bytes;
+  jlong volatile* _rebuild_time_ticks;
+  uint const _num_regions;
+
+  size_t volatile _chunks_processed;
+  size_t volatile _chunks_stolen;
+  size_t volatile _steps_ended_early;
 
   uint _worker_id_offset;
+
+  void add_region_progress(uint region_idx, size_t marked_bytes, Tickspan time) {
+    if (marked_bytes > 0) {
+      Atomic::add(&_marked_bytes[region_idx], marked_bytes);
+    }
+    Atomic::add(&_rebuild_time_ticks[region_idx], time.value());
+  }
+
 public:
   G1RebuildRemSetTask(G1ConcurrentMark* cm,
                       uint n_workers,
                       uint worker_id_offset) :
       AbstractGangTask("G1 Rebuild Remembered Set"),
-      _hr_claimer(n_workers),
       _cm(cm),
+      _claimer(G1CollectedHeap::heap(), cm, n_workers),
+      _marked_bytes(NEW_C_HEAP_ARRAY(size_t, G1CollectedHeap::heap()->max_regions(), mtGC)),
+      _rebuild_time_ticks(NEW_C_HEAP_ARRAY(jlong, G1CollectedHeap::heap()->max_regions(), mtGC)),
+      _num_regions(G1CollectedHeap::heap()->max_regions()),
+      _chunks_processed(0),
+      _chunks_stolen(0),
+      _steps_ended_early(0),
       _worker_id_offset(worker_id_offset) {
+    for (uint i = 0; i < _num_regions; i++) {
+      _marked_bytes[i] = 0;
+      _rebuild_time_ticks[i] = 0;
+    }
+  }
+
+  ~G1RebuildRemSetTask() {
+    FREE_C_HEAP_ARRAY(size_t, _marked_bytes);
+    FREE_C_HEAP_ARRAY(jlong, _rebuild_time_ticks);
   }
 
   void work(uint worker_id) {
@@ -1991,8 +2130,63 @@ public:
 
     G1CollectedHeap* g1h = G1CollectedHeap::heap();
 
-    G1RebuildRemSetHeapRegionClosure cl(g1h, _cm, _worker_id_offset + worker_id);
-    g1h->heap_region_par_iterate_from_worker_offset(&cl, &_hr_claimer, worker_id);
+    G1RebuildRemSetChunkClosure cl(g1h, _cm, this, _worker_id_offset + worker_id);
+    cl.do_chunks(worker_id);
+
+    Atomic::add(&_chunks_processed, cl.chunks_processed());
+    Atomic::add(&_chunks_stolen, cl.chunks_stolen());
+    Atomic::add(&_steps_ended_early, cl.steps_ended_early());
+  }
+
+  // Verify the per-region results of a completed rebuild and report them.
+  // Must be called from within the suspendible thread set: the regions
+  // might otherwise be eagerly reclaimed concurrently.
+  void report_region_progress() {
+    assert(!_cm->has_aborted(), "Rebuild must have completed");
+
+    G1CollectedHeap* g1h = G1CollectedHeap::heap();
+    uint num_regions_rebuilt = 0;
+    for (uint region_idx = 0; region_idx < _num_regions; region_idx++) {
+      // Regions might have been eagerly reclaimed during the rebuild. Simply filter
+      // out those regions. We can not just use region type because there might
+      // have already been new allocations into these regions.
+      HeapWord* const top_at_rebuild_start = _cm->top_at_rebuild_start(region_idx);
+      if (top_at_rebuild_start == NULL) {
+        continue;
+      }
+      num_regions_rebuilt++;
+
+      HeapRegion* hr = g1h->region_at(region_idx);
+      size_t const marked_bytes = Atomic::load(&_marked_bytes[region_idx]);
+      assert(marked_bytes == hr->marked_bytes(),
+             "Marked bytes " SIZE_FORMAT " for region %u (%s) in [bottom, TAMS) do not match calculated marked bytes " SIZE_FORMAT " "
+             "(" PTR_FORMAT " " PTR_FORMAT " " PTR_FORMAT ")",
+             marked_bytes, region_idx, hr->get_type_str(), hr->marked_bytes(),
+             p2i(hr->bottom()), p2i(hr->prev_top_at_mark_start()), p2i(top_at_rebuild_start));
+
+      log_trace(gc, remset, tracking)("Rebuilt region %u "
+                                      "live " SIZE_FORMAT " "
+                                      "time %.3fms "
+                                      "marked bytes " SIZE_FORMAT " "
+                                      "bot " PTR_FORMAT " "
+                                      "TAMS " PTR_FORMAT " "
+                                      "TARS " PTR_FORMAT,
+                                      region_idx,
+                                      _cm->live_bytes(region_idx),
+                                      TimeHelper::counter_to_millis(Atomic::load(&_rebuild_time_ticks[region_idx])),
+                                      marked_bytes,
+                                      p2i(hr->bottom()),
+                                      p2i(hr->prev_top_at_mark_start()),
+                                      p2i(top_at_rebuild_start));
+    }
+
+    log_debug(gc, remset, tracking)("Rebuilt remembered sets of %u regions: "
+                                    "chunks " SIZE_FORMAT " (stolen " SIZE_FORMAT ") "
+                                    "steps ended early " SIZE_FORMAT,
+                                    num_regions_rebuilt,
+                                    Atomic::load(&_chunks_processed),
+                                    Atomic::load(&_chunks_stolen),
+                                    Atomic::load(&_steps_ended_early));
   }
 };
 
@@ -2005,4 +2199,13 @@ void G1RemSet::rebuild_rem_set(G1ConcurrentMark* cm,
                          num_workers,
                          worker_id_offset);
   workers->run_task(&cl, num_workers);
+
+  bool const report_progress = log_is_enabled(Debug, gc, remset, tracking) DEBUG_ONLY(|| true);
+  if (report_progress && !cm->has_aborted()) {
+    SuspendibleThreadSetJoiner sts_join;
+    // A Full GC may have aborted marking while waiting to join.
+    if (!cm->has_aborted()) {
+      cl.report_region_progress();
+    }
+  }
 }
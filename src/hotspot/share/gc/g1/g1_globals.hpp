@@ -102,6 +102,12 @@
           "When expanding, % of uncommitted space to claim.")               \
           range(0, 100)                                                     \
                                                                             \
+  product(uint, G1ShrinkByPercentOfCapacity, 0, EXPERIMENTAL,               \
+          "When shrinking after a young collection, maximum % of "          \
+          "committed space to release per collection. Zero disables "       \
+          "shrinking after young collections.")                             \
+          range(0, 100)                                                     \
+                                                                            \
   product(size_t, G1UpdateBufferSize, 256,                                  \
           "Size of an update buffer")                                       \
           range(1, NOT_LP64(32*M) LP64_ONLY(1*G))                           \
@@ -233,6 +239,28 @@
           "The target number of mixed GCs after a marking cycle.")          \
           range(0, max_uintx)                                               \
                                                                             \
+  product(bool, G1UseRegionPinning, false, EXPERIMENTAL,                    \
+          "Pin the region containing an object accessed by JNI critical "   \
+          "functions instead of blocking garbage collections using the "    \
+          "GCLocker. Regions with pinned objects are not evacuated.")       \
+                                                                            \
+  product(bool, G1UsePretenuring, false, EXPERIMENTAL,                      \
+          "Copy objects of classes whose instances almost always live "     \
+          "until they are tenured directly from eden into the old "         \
+          "generation during young collections.")                           \
+                                                                            \
+  product(uint, G1PretenureThresholdPercent, 90, EXPERIMENTAL,              \
+          "Percentage of the bytes of a class surviving their first young " \
+          "collection that must eventually be tenured before instances "    \
+          "of that class are pretenured. See G1UsePretenuring.")            \
+          range(0, 100)                                                     \
+                                                                            \
+  product(bool, G1ReduceHumongousWaste, false, EXPERIMENTAL,                \
+          "Place multi-region humongous objects into the smallest range "   \
+          "of free regions they fit in to keep large ranges available, "    \
+          "and release the memory backing the unused tail of the last "     \
+          "region of humongous objects.")                                   \
+                                                                            \
   product(bool, G1EagerReclaimHumongousObjects, true, EXPERIMENTAL,         \
           "Try to reclaim dead large objects at every young GC.")           \
                                                                             \
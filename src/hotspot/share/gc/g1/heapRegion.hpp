@@ -33,6 +33,7 @@
 #include "gc/shared/ageTable.hpp"
 #include "gc/shared/spaceDecorator.hpp"
 #include "gc/shared/verifyOption.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/mutex.hpp"
 #include "utilities/macros.hpp"
 
@@ -198,6 +199,11 @@ public:
     _bot_part.update();
   }
 
+  // Update the BOT for the given block only; see G1BlockOffsetTablePart::update_for_block().
+  void update_bot_for_block(HeapWord* start, HeapWord* end) {
+    _bot_part.update_for_block(start, end);
+  }
+
 private:
   // The remembered set for this region.
   HeapRegionRemSet* _rem_set;
@@ -256,6 +262,9 @@ private:
 
   uint _node_index;
 
+  // Number of objects in this region currently pinned by JNI critical sections.
+  volatile size_t _pinned_object_count;
+
   void report_region_type_change(G1HeapRegionTraceType::Type to);
 
   // Returns whether the given object address refers to a dead object, and either the
@@ -405,6 +414,14 @@ public:
   // Humongous regions and archive regions are pinned.
   bool is_pinned() const { return _type.is_pinned(); }
 
+  // Whether this region contains objects pinned by JNI critical sections (see
+  // G1UseRegionPinning). Such objects must not be moved, so garbage collections
+  // keep the region in place.
+  bool has_pinned_objects() const { return pinned_object_count() > 0; }
+  size_t pinned_object_count() const { return Atomic::load(&_pinned_object_count); }
+  inline void increment_pinned_object_count();
+  inline void decrement_pinned_object_count();
+
   // An archive region is a pinned region, also tagged as old, which
   // should not be marked during mark/sweep. This allows the address
   // space to be shared by JVM instances.
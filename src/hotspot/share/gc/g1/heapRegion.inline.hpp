@@ -221,6 +221,15 @@ inline void HeapRegion::reset_skip_compacting_after_full_gc() {
   reset_after_full_gc_common();
 }
 
+inline void HeapRegion::increment_pinned_object_count() {
+  Atomic::inc(&_pinned_object_count, memory_order_relaxed);
+}
+
+inline void HeapRegion::decrement_pinned_object_count() {
+  assert(has_pinned_objects(), "Region %u must have pinned objects", hrm_index());
+  Atomic::dec(&_pinned_object_count, memory_order_relaxed);
+}
+
 inline void HeapRegion::reset_after_full_gc_common() {
   if (is_empty()) {
     reset_bot();
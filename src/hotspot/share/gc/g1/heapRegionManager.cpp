@@ -124,7 +124,8 @@ HeapRegion* HeapRegionManager::allocate_free_region(HeapRegionType type, uint re
 }
 
 HeapRegion* HeapRegionManager::allocate_humongous_from_free_list(uint num_regions) {
-  uint candidate = find_contiguous_in_free_list(num_regions);
+  uint candidate = G1ReduceHumongousWaste ? find_contiguous_best_fit_in_free_list(num_regions)
+                                          : find_contiguous_in_free_list(num_regions);
   if (candidate == G1_NO_HRM_INDEX) {
     return NULL;
   }
@@ -496,6 +497,43 @@ uint HeapRegionManager::find_contiguous_in_free_list(uint num_regions) {
   return candidate;
 }
 
+uint HeapRegionManager::find_contiguous_best_fit_in_free_list(uint num_regions) {
+  uint candidate = G1_NO_HRM_INDEX;
+  uint candidate_length = UINT_MAX;
+  HeapRegionRange range(0,0);
+
+  do {
+    range = _committed_map.next_active_range(range.end());
+    uint i = range.start();
+    while (i < range.end()) {
+      if (!at(i)->is_free()) {
+        i++;
+        continue;
+      }
+      // Determine the length of this run of free regions.
+      uint run_start = i;
+      while (i < range.end() && at(i)->is_free()) {
+        i++;
+      }
+      uint run_length = i - run_start;
+      if (run_length >= num_regions && run_length < candidate_length) {
+        candidate = run_start;
+        candidate_length = run_length;
+        if (run_length == num_regions) {
+          // Can not do better than an exact fit.
+          assert_contiguous_range(candidate, num_regions);
+          return candidate;
+        }
+      }
+    }
+  } while (range.end() < reserved_length());
+
+  if (candidate != G1_NO_HRM_INDEX) {
+    assert_contiguous_range(candidate, num_regions);
+  }
+  return candidate;
+}
+
 uint HeapRegionManager::find_contiguous_allow_expand(uint num_regions) {
   // Check if we can actually satisfy the allocation.
   if (num_regions > available()) {
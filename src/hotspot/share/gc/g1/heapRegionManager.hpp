@@ -101,6 +101,9 @@ class HeapRegionManager: public CHeapObj<mtGC> {
   // Find a contiguous set of empty regions of length num_regions. Returns the start index
   // of that set, or G1_NO_HRM_INDEX.
   uint find_contiguous_in_free_list(uint num_regions);
+  // Find the smallest contiguous set of empty regions with at least num_regions
+  // regions. Returns the start index of that set, or G1_NO_HRM_INDEX.
+  uint find_contiguous_best_fit_in_free_list(uint num_regions);
   // Find a contiguous set of empty or unavailable regions of length num_regions. Returns the
   // start index of that set, or G1_NO_HRM_INDEX.
   uint find_contiguous_allow_expand(uint num_regions);
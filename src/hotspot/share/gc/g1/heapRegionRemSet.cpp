@@ -62,6 +62,91 @@ PerRegionTable* PerRegionTable::alloc(HeapRegion* hr) {
 
 PerRegionTable* volatile PerRegionTable::_free_list = NULL;
 
+uint PerRegionTable::_initial_array_capacity = 0;
+uint PerRegionTable::_max_array_capacity = 0;
+
+void PerRegionTable::setup_array_capacity() {
+  // The card array is never larger than the bitmap it is replaced with.
+  _max_array_capacity = (uint)(HeapRegion::CardsPerRegion / (BitsPerByte * sizeof(card_elem_t)));
+  // Cards are transferred from a sparse entry, so the initial array must be
+  // able to hold all of them.
+  uint initial = round_up_power_of_2((uint)SparsePRTEntry::cards_num() + 1);
+  _initial_array_capacity = MIN2(initial, _max_array_capacity);
+}
+
+uint PerRegionTable::array_position(card_elem_t card, bool& found) const {
+  uint low = 0;
+  uint high = _num_cards;
+  while (low < high) {
+    uint mid = low + (high - low) / 2;
+    if (_cards[mid] < card) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  found = (low < _num_cards) && (_cards[low] == card);
+  return low;
+}
+
+bool PerRegionTable::add_card_to_array(CardIdx_t from_card_index) {
+  assert(!is_bitmap(), "must be");
+  assert(from_card_index >= 0 && (size_t)from_card_index < HeapRegion::CardsPerRegion,
+         "Card index %d out of range", from_card_index);
+
+  card_elem_t card = (card_elem_t)from_card_index;
+  bool found;
+  uint pos = array_position(card, found);
+  if (found) {
+    return false;
+  }
+
+  if (_num_cards == _cards_capacity) {
+    if (_cards_capacity >= _max_array_capacity) {
+      inflate();
+      return add_card(from_card_index);
+    }
+    uint new_capacity = (_cards_capacity == 0) ? _initial_array_capacity : MIN2(_cards_capacity * 2, _max_array_capacity);
+    _cards = REALLOC_C_HEAP_ARRAY(card_elem_t, _cards, new_capacity, mtGC);
+    _cards_capacity = new_capacity;
+  }
+
+  memmove(&_cards[pos + 1], &_cards[pos], (_num_cards - pos) * sizeof(card_elem_t));
+  _cards[pos] = card;
+  _num_cards++;
+  _occupied++;
+  return true;
+}
+
+void PerRegionTable::inflate() {
+  assert(!is_bitmap(), "must be");
+  _bm.reinitialize(HeapRegion::CardsPerRegion);
+  for (uint i = 0; i < _num_cards; i++) {
+    _bm.set_bit(_cards[i]);
+  }
+  FREE_C_HEAP_ARRAY(card_elem_t, _cards);
+  _cards = NULL;
+  _num_cards = 0;
+  _cards_capacity = 0;
+  // Make sure that the bitmap contents are visible before concurrent
+  // threads start adding to it without holding the lock.
+  Atomic::release_store(&_is_bitmap, true);
+}
+
+void PerRegionTable::shrink() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be");
+  if (is_bitmap()) {
+    _bm.resize(0);
+    _is_bitmap = false;
+  } else if (_cards_capacity > _initial_array_capacity) {
+    FREE_C_HEAP_ARRAY(card_elem_t, _cards);
+    _cards = NULL;
+    _cards_capacity = 0;
+  }
+  _num_cards = 0;
+  _occupied = 0;
+}
+
 size_t OtherRegionsTable::_max_fine_entries = 0;
 size_t OtherRegionsTable::_mod_max_fine_entries_mask = 0;
 size_t OtherRegionsTable::_fine_eviction_stride = 0;
@@ -139,11 +224,22 @@ void OtherRegionsTable::add_reference(OopOrNarrowOopStar from, uint tid) {
     return;
   }
 
-  size_t num_added_by_coarsening = 0;
   // Otherwise find a per-region table to add it to.
   size_t ind = from_hrm_ind & _mod_max_fine_entries_mask;
   PerRegionTable* prt = find_region_table(ind, from_hr);
-  if (prt == NULL) {
+  if (prt != NULL && prt->is_bitmap()) {
+    // Note that we can't assert "prt->hr() == from_hr", because of the
+    // possibility of concurrent reuse.  But see head comment of
+    // OtherRegionsTable for why this is OK.
+    if (prt->add_reference(from)) {
+      Atomic::inc(&_num_occupied, memory_order_relaxed);
+    }
+    assert(contains_reference(from), "We just added " PTR_FORMAT " to the PRT (%d)", p2i(from), prt->contains_reference(from));
+    return;
+  }
+
+  size_t num_added_by_coarsening = 0;
+  {
     MutexLocker x(_m, Mutex::_no_safepoint_check_flag);
 
     // Rechecking if the region is coarsened, while holding the lock.
@@ -205,17 +301,14 @@ void OtherRegionsTable::add_reference(OopOrNarrowOopStar from, uint tid) {
       assert(res, "It should have been there.");
     }
     assert(prt != NULL && prt->hr() == from_hr, "consequence");
-  }
-  // Note that we can't assert "prt->hr() == from_hr", because of the
-  // possibility of concurrent reuse.  But see head comment of
-  // OtherRegionsTable for why this is OK.
-  assert(prt != NULL, "Inv");
 
-  if (prt->add_reference(from)) {
-    num_added_by_coarsening++;
+    // The PRT may still be a card array, so add the card while holding the lock.
+    if (prt->add_reference(from)) {
+      num_added_by_coarsening++;
+    }
+    assert(contains_reference_locked(from), "We just added " PTR_FORMAT " to the PRT (%d)", p2i(from), prt->contains_reference(from));
   }
   Atomic::add(&_num_occupied, num_added_by_coarsening, memory_order_relaxed);
-  assert(contains_reference(from), "We just added " PTR_FORMAT " to the PRT (%d)", p2i(from), prt->contains_reference(from));
 }
 
 PerRegionTable*
@@ -309,11 +402,9 @@ size_t OtherRegionsTable::occupied() const {
 
 size_t OtherRegionsTable::mem_size() const {
   size_t sum = 0;
-  // all PRTs are of the same size so it is sufficient to query only one of them.
-  if (_first_all_fine_prts != NULL) {
-    assert(_last_all_fine_prts != NULL &&
-      _first_all_fine_prts->mem_size() == _last_all_fine_prts->mem_size(), "check that mem_size() is constant");
-    sum += _first_all_fine_prts->mem_size() * _n_fine_entries;
+  // PRTs are of different size depending on whether they have been inflated.
+  for (PerRegionTable* cur = _first_all_fine_prts; cur != NULL; cur = cur->next()) {
+    sum += cur->mem_size();
   }
   sum += (sizeof(PerRegionTable*) * _max_fine_entries);
   sum += (_coarse_map.size_in_words() * HeapWordSize);
@@ -334,6 +425,13 @@ void OtherRegionsTable::clear() {
   // if there are no entries, skip this step
   if (_first_all_fine_prts != NULL) {
     guarantee(_first_all_fine_prts != NULL && _last_all_fine_prts != NULL, "just checking");
+    // Give back the memory of inflated PRTs so that they start out small again
+    // on reuse. This is only safe if no other thread may be adding to them.
+    if (SafepointSynchronize::is_at_safepoint()) {
+      for (PerRegionTable* cur = _first_all_fine_prts; cur != NULL; cur = cur->next()) {
+        cur->shrink();
+      }
+    }
     PerRegionTable::bulk_free(_first_all_fine_prts, _last_all_fine_prts);
     memset(_fine_grain_regions, 0, _max_fine_entries * sizeof(_fine_grain_regions[0]));
   } else {
@@ -407,6 +505,8 @@ void HeapRegionRemSet::setup_remset_size() {
     G1RSetRegionEntries = G1RSetRegionEntriesBase * (region_size_log_mb + 1);
   }
   guarantee(G1RSetSparseRegionEntries > 0 && G1RSetRegionEntries > 0 , "Sanity");
+
+  PerRegionTable::setup_array_capacity();
 }
 
 void HeapRegionRemSet::clear(bool only_cardset) {
@@ -52,6 +52,11 @@ class nmethod;
 // cards.  The strategy is to cap the size of the fine-grain table,
 // deleting an entry and setting the corresponding coarse-grained bit when
 // we would overflow this cap.
+// A PRT keeps its cards in a sorted card array until that array would
+// use as much memory as a bitmap covering the whole region, and only then
+// switches to such a bitmap. So the size of a PRT, and the time needed to
+// merge it into the card table, is proportional to the number of cards it
+// contains for all but the densest PRTs.
 
 // We use a mixture of locking and lock-free techniques here.  We allow
 // threads to locate PRTs without locking, but threads attempting to alter
@@ -66,6 +71,9 @@ class nmethod;
 //      it's _coarse_map bit is set, so the that we were attempting to add
 //      is represented.  If a deleted PRT is re-used, a thread adding a bit,
 //      thinking the PRT is for a different region, does no harm.
+//   3) Only PRTs that have been inflated to a bitmap are modified without
+//      holding the lock. A PRT never changes back from bitmap to card array
+//      outside of a safepoint.
 
 class OtherRegionsTable {
   G1CollectedHeap* _g1h;
@@ -161,8 +169,25 @@ public:
 class PerRegionTable: public CHeapObj<mtGC> {
   friend class OtherRegionsTable;
 
+public:
+  typedef SparsePRTEntry::card_elem_t card_elem_t;
+
+private:
   HeapRegion*     _hr;
+
+  // The cards of a PRT are first kept in a sorted array. Only when that array
+  // would use about as much memory as a bitmap over all cards of the region
+  // the PRT is converted ("inflated") into such a bitmap.
+  // The array may only be accessed while holding the lock of the owning
+  // remembered set or at a safepoint. The bitmap is published via _is_bitmap,
+  // after which cards may be added lock-free.
+  card_elem_t*    _cards;
+  uint            _num_cards;
+  uint            _cards_capacity;
+
   CHeapBitMap     _bm;
+  volatile bool   _is_bitmap;
+
   jint            _occupied;
 
   // next pointer for free/allocated 'all' list
@@ -174,18 +199,33 @@ class PerRegionTable: public CHeapObj<mtGC> {
   // Global free list of PRTs
   static PerRegionTable* volatile _free_list;
 
+  // Initial and maximum number of entries of the card array.
+  static uint _initial_array_capacity;
+  static uint _max_array_capacity;
+
+  // Returns the position of the given card in the card array, or the
+  // position where it should be inserted if not found.
+  uint array_position(card_elem_t card, bool& found) const;
+  bool add_card_to_array(CardIdx_t from_card_index);
+  // Convert the card array into a bitmap.
+  void inflate();
+
 protected:
   PerRegionTable(HeapRegion* hr) :
     _hr(hr),
-    _bm(HeapRegion::CardsPerRegion, mtGC),
+    _cards(NULL),
+    _num_cards(0),
+    _cards_capacity(0),
+    _bm(mtGC),
+    _is_bitmap(false),
     _occupied(0),
     _next(NULL),
     _collision_list_next(NULL)
   {}
 
 public:
-  // We need access in order to union things into the base table.
-  BitMap* bm() { return &_bm; }
+  // Setup the card array sizes depending on region and sparse entry sizes.
+  static void setup_array_capacity();
 
   HeapRegion* hr() const { return Atomic::load_acquire(&_hr); }
 
@@ -193,21 +233,32 @@ public:
     return _occupied;
   }
 
+  bool is_bitmap() const { return Atomic::load_acquire(&_is_bitmap); }
+
+  // Accessors for the bitmap or card array representations; which one is valid
+  // depends on is_bitmap().
+  BitMap* bm() { assert(is_bitmap(), "must be"); return &_bm; }
+  card_elem_t* cards() const { assert(!is_bitmap(), "must be"); return _cards; }
+  uint num_cards() const { assert(!is_bitmap(), "must be"); return _num_cards; }
+
   void init(HeapRegion* hr, bool clear_links_to_all_list);
 
+  // Release the bitmap memory of this PRT, making it start out with a card
+  // array again. Must only be called at a safepoint when there can be no
+  // concurrent lock-free adders.
+  void shrink();
+
+  // Adds the given reference or card to this PRT. This is lock-free if the
+  // PRT has been inflated into a bitmap, otherwise the caller must hold the lock
+  // of the owning remembered set.
   inline bool add_reference(OopOrNarrowOopStar from);
 
   inline bool add_card(CardIdx_t from_card_index);
 
-  // (Destructively) union the bitmap of the current table into the given
-  // bitmap (which is assumed to be of the same size.)
-  void union_bitmap_into(BitMap* bm) {
-    bm->set_union(_bm);
-  }
-
   // Mem size in bytes.
   size_t mem_size() const {
-    return sizeof(PerRegionTable) + _bm.size_in_words() * HeapWordSize;
+    return sizeof(PerRegionTable) +
+           (is_bitmap() ? _bm.size_in_words() * HeapWordSize : _cards_capacity * sizeof(card_elem_t));
   }
 
   // Requires "from" to be in "hr()".
@@ -215,7 +266,12 @@ public:
     assert(hr()->is_in_reserved(from), "Precondition.");
     size_t card_ind = pointer_delta(from, hr()->bottom(),
                                     G1CardTable::card_size);
-    return _bm.at(card_ind);
+    if (is_bitmap()) {
+      return _bm.at(card_ind);
+    }
+    bool found;
+    array_position((card_elem_t)card_ind, found);
+    return found;
   }
 
   // Bulk-free the PRTs from prt to last, assumes that they are
@@ -38,6 +38,9 @@ inline void HeapRegionRemSet::iterate_prts(Closure& cl) {
 }
 
 inline bool PerRegionTable::add_card(CardIdx_t from_card_index) {
+  if (!is_bitmap()) {
+    return add_card_to_array(from_card_index);
+  }
   if (_bm.par_set_bit(from_card_index)) {
     Atomic::inc(&_occupied, memory_order_relaxed);
     return true;
@@ -66,7 +69,12 @@ inline void PerRegionTable::init(HeapRegion* hr, bool clear_links_to_all_list) {
   }
   _collision_list_next = NULL;
   _occupied = 0;
-  _bm.clear();
+  _num_cards = 0;
+  // A PRT that has been inflated stays a bitmap as there may be concurrent
+  // lock-free adders to it.
+  if (is_bitmap()) {
+    _bm.clear();
+  }
   // Make sure that the bitmap clearing above has been finished before publishing
   // this PRT to concurrent threads.
   Atomic::release_store(&_hr, hr);
@@ -84,7 +92,11 @@ void OtherRegionsTable::iterate(Closure& cl) {
   {
     PerRegionTable* cur = _first_all_fine_prts;
     while (cur != NULL) {
-      cl.next_fine_prt(cur->hr()->hrm_index(), cur->bm());
+      if (cur->is_bitmap()) {
+        cl.next_fine_prt(cur->hr()->hrm_index(), cur->bm());
+      } else {
+        cl.next_array_prt(cur->hr()->hrm_index(), cur->cards(), cur->num_cards());
+      }
       cur = cur->next();
     }
   }
@@ -194,6 +194,7 @@ class MutableNUMASpace : public MutableSpace {
 
  public:
   GrowableArray<LGRPSpace*>* lgrp_spaces() const     { return _lgrp_spaces;       }
+  int lgrp_id_at(int i) const                        { return _lgrp_spaces->at(i)->lgrp_id(); }
   MutableNUMASpace(size_t alignment);
   virtual ~MutableNUMASpace();
   // Space initialization.
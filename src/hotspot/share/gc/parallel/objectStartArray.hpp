@@ -141,6 +141,11 @@ class ObjectStartArray : public CHeapObj<mtGC> {
   // object hit should be at the beginning of the block
   inline HeapWord* object_start(HeapWord* addr) const;
 
+  // Like object_start(addr), but if the known object start hint is at most
+  // a block below addr, walk the objects forward from the hint instead of
+  // searching the start array backwards.
+  inline HeapWord* object_start(HeapWord* addr, HeapWord* hint) const;
+
   bool is_block_allocated(HeapWord* addr) {
     assert_covered_region_contains(addr);
     jbyte* block = block_for_addr(addr);
@@ -49,5 +49,20 @@ HeapWord* ObjectStartArray::object_start(HeapWord* addr) const {
   return scroll_forward;
 }
 
+HeapWord* ObjectStartArray::object_start(HeapWord* addr, HeapWord* hint) const {
+  if (hint == NULL || hint > addr || pointer_delta(addr, hint) > block_size_in_words) {
+    return object_start(addr);
+  }
+
+  HeapWord* scroll_forward = hint;
+  HeapWord* next = hint;
+  while (next <= addr) {
+    scroll_forward = next;
+    next += cast_to_oop(next)->size();
+  }
+  assert(scroll_forward == object_start(addr), "hint must be an object start");
+  return scroll_forward;
+}
+
 
 #endif // SHARE_GC_PARALLEL_OBJECTSTARTARRAY_INLINE_HPP
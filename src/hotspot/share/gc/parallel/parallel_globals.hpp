@@ -59,7 +59,11 @@
           "Delay in scheduling GC workers (in milliseconds)")               \
                                                                             \
   product(bool, PSChunkLargeArrays, true,                                   \
-          "Process large arrays in chunks")
+          "Process large arrays in chunks")                                 \
+                                                                            \
+  product(bool, UseNUMASurvivorStripes, false, EXPERIMENTAL,                \
+          "With UseNUMA, split to-space into one stripe per NUMA node "     \
+          "and copy survivors to the node they were allocated on")
 
 // end of GC_PARALLEL_FLAGS
 
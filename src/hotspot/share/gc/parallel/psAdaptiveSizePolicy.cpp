@@ -61,12 +61,40 @@ PSAdaptiveSizePolicy::PSAdaptiveSizePolicy(size_t init_eden_size,
      _change_old_gen_for_min_pauses(0),
      _change_young_gen_for_maj_pauses(0),
      _young_gen_size_increment_supplement(YoungGenerationSizeSupplement),
-     _old_gen_size_increment_supplement(TenuredGenerationSizeSupplement)
+     _old_gen_size_increment_supplement(TenuredGenerationSizeSupplement),
+     _survived_nodes(0),
+     _avg_survived_per_node(NULL)
 {
   // Start the timers
   _major_timer.start();
 }
 
+void PSAdaptiveSizePolicy::initialize_survived_per_node(uint nodes) {
+  assert(_avg_survived_per_node == NULL, "already initialized");
+  _avg_survived_per_node = NEW_C_HEAP_ARRAY(AdaptivePaddedAverage*, nodes, mtGC);
+  for (uint i = 0; i < nodes; i++) {
+    _avg_survived_per_node[i] = new AdaptivePaddedAverage(AdaptiveSizePolicyWeight, SurvivorPadding);
+  }
+  _survived_nodes = nodes;
+}
+
+void PSAdaptiveSizePolicy::update_survived_per_node(uint node, size_t survived) {
+  assert(node < _survived_nodes, "node out of range");
+  _avg_survived_per_node[node]->sample(survived);
+  log_trace(gc, ergo)("node %u avg_survived: %f  avg_deviation: %f", node,
+                      _avg_survived_per_node[node]->average(),
+                      _avg_survived_per_node[node]->deviation());
+}
+
+bool PSAdaptiveSizePolicy::has_survived_per_node(uint node) const {
+  return node < _survived_nodes && _avg_survived_per_node[node]->count() > 0;
+}
+
+size_t PSAdaptiveSizePolicy::padded_survived_per_node(uint node) const {
+  assert(node < _survived_nodes, "node out of range");
+  return (size_t)_avg_survived_per_node[node]->padded_average();
+}
+
 size_t PSAdaptiveSizePolicy::calculate_free_based_on_live(size_t live, uintx ratio_as_percentage) {
   // We want to calculate how much free memory there can be based on the
   // amount of live data currently in the old gen. Using the formula:
@@ -1023,8 +1051,17 @@ uint PSAdaptiveSizePolicy::compute_survivor_space_size_and_threshold(
   // we use this to see how good of an estimate we have of what survived.
   // We're trying to pad the survivor size as little as possible without
   // overflowing the survivor spaces.
-  size_t target_size = align_up((size_t)_avg_survived->padded_average(),
-                                     _space_alignment);
+  size_t target_size = (size_t)_avg_survived->padded_average();
+  if (_survived_nodes > 0) {
+    // Each node copies its survivors into its own stripe of to-space, so the
+    // survivor spaces must hold what each node is expected to need.
+    size_t node_target_size = 0;
+    for (uint i = 0; i < _survived_nodes; i++) {
+      node_target_size += padded_survived_per_node(i);
+    }
+    target_size = MAX2(target_size, node_target_size);
+  }
+  target_size = align_up(target_size, _space_alignment);
   target_size = MAX2(target_size, _space_alignment);
 
   if (target_size > survivor_limit) {
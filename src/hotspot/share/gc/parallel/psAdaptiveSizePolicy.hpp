@@ -113,6 +113,11 @@ class PSAdaptiveSizePolicy : public AdaptiveSizePolicy {
   uint _young_gen_size_increment_supplement;
   uint _old_gen_size_increment_supplement;
 
+  // Bytes surviving a scavenge per NUMA node, sampled when to-space is split
+  // into node-local stripes (PSNUMASurvivorStripes).
+  uint _survived_nodes;
+  AdaptivePaddedAverage** _avg_survived_per_node;
+
  private:
 
   // Accessors
@@ -364,6 +369,12 @@ class PSAdaptiveSizePolicy : public AdaptiveSizePolicy {
                        size_t survived,
                        size_t promoted);
 
+  // Per NUMA node survivor statistics.
+  void initialize_survived_per_node(uint nodes);
+  void update_survived_per_node(uint node, size_t survived);
+  bool has_survived_per_node(uint node) const;
+  size_t padded_survived_per_node(uint node) const;
+
   // Printing support
   virtual bool print() const;
 
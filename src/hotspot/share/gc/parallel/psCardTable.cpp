@@ -117,6 +117,28 @@ class CheckForPreciseMarks : public BasicOopIterateClosure {
   virtual void do_oop(narrowOop* p) { CheckForPreciseMarks::do_oop_work(p); }
 };
 
+CardTable::CardValue* PSCardTable::find_first_unclean_card(CardValue* start, CardValue* end) const {
+  STATIC_ASSERT(clean_card == (CardValue)-1);
+  const uintptr_t clean_word = ~(uintptr_t)0;
+
+  CardValue* cur = start;
+  // Read single cards up to a word boundary, then a word of cards at a time.
+  while (cur < end && !is_aligned(cur, sizeof(uintptr_t))) {
+    if (!card_is_clean(*cur)) {
+      return cur;
+    }
+    cur++;
+  }
+  while (pointer_delta(end, cur, sizeof(CardValue)) >= sizeof(uintptr_t) &&
+         *(uintptr_t*)cur == clean_word) {
+    cur += sizeof(uintptr_t);
+  }
+  while (cur < end && card_is_clean(*cur)) {
+    cur++;
+  }
+  return cur;
+}
+
 // We get passed the space_top value to prevent us from traversing into
 // the old_gen promotion labs, which cannot be safely parsed.
 
@@ -126,45 +148,36 @@ class CheckForPreciseMarks : public BasicOopIterateClosure {
 // when the space is empty, fix the calculation of
 // end_card to allow sp_top == sp->bottom().
 
-// The generation (old gen) is divided into slices, which are further
-// subdivided into stripes, with one stripe per GC thread. The size of
-// a stripe is a constant, ssize.
+// The generation (old gen) is divided into stripes of a constant number of
+// cards, ssize.  The stripes are not assigned to GC threads up front.
+// Instead each thread claims the next unscanned stripe from the shared
+// PSCardStripeClaimer whenever it is done with its previous one:
 //
-//      +===============+        slice 0
-//      |  stripe 0     |
+//      +===============+
+//      |  stripe 0     |  <- claimed by thread 2
 //      +---------------+
-//      |  stripe 1     |
+//      |  stripe 1     |  <- claimed by thread 0
 //      +---------------+
-//      |  stripe 2     |
+//      |  stripe 2     |  <- claimed by thread 2
 //      +---------------+
-//      |  stripe 3     |
-//      +===============+        slice 1
-//      |  stripe 0     |
+//      |  stripe 3     |  <- claimed by thread 1
 //      +---------------+
-//      |  stripe 1     |
+//      |  stripe 4     |  <- next stripe to be claimed
 //      +---------------+
-//      |  stripe 2     |
-//      +---------------+
-//      |  stripe 3     |
-//      +===============+        slice 2
 //      ...
 //
-// In this case there are 4 threads, so 4 stripes.  A GC thread first works on
-// its stripe within slice 0 and then moves to its stripe in the next slice
-// until it has exceeded the top of the generation.  The distance to stripe in
-// the next slice is calculated based on the number of stripes.  The next
-// stripe is at ssize * number_of_stripes (= slice_stride)..  So after
-// finishing stripe 0 in slice 0, the thread finds the stripe 0 in slice1 by
-// adding slice_stride to the start of stripe 0 in slice 0 to get to the start
-// of stride 0 in slice 1.
+// The stripes are handed out in increasing address order, until a claimed
+// stripe starts above the top of the generation.  A thread that finds few
+// dirty cards in its stripes therefore claims more of them, and the stripes
+// a single thread scans are in increasing address order as well.
 
 void PSCardTable::scavenge_contents_parallel(ObjectStartArray* start_array,
                                              MutableSpace* sp,
                                              HeapWord* space_top,
                                              PSPromotionManager* pm,
-                                             uint stripe_number,
-                                             uint stripe_total) {
-  int ssize = 128; // Naked constant!  Work unit = 64k.
+                                             PSCardStripeClaimer* stripes,
+                                             uint worker_id) {
+  const size_t ssize = num_cards_in_stripe;
   int dirty_card_count = 0;
 
   // It is a waste to get here if empty.
@@ -173,14 +186,13 @@ void PSCardTable::scavenge_contents_parallel(ObjectStartArray* start_array,
   CardValue* start_card = byte_for(sp->bottom());
   CardValue* end_card   = byte_for(sp_top - 1) + 1;
   oop* last_scanned = NULL; // Prevent scanning objects more than once
-  // The width of the stripe ssize*stripe_total must be
-  // consistent with the number of stripes so that the complete slice
-  // is covered.
-  size_t slice_width = ssize * stripe_total;
-  for (CardValue* slice = start_card; slice < end_card; slice += slice_width) {
-    CardValue* worker_start_card = slice + stripe_number * ssize;
-    if (worker_start_card >= end_card)
+  // The stripes are claimed in increasing address order, so the stripes
+  // scanned by a worker are increasing as well.
+  const size_t num_stripes = (pointer_delta(end_card, start_card, sizeof(CardValue)) + ssize - 1) / ssize;
+  for (size_t stripe = stripes->claim(); /* until done */; stripe = stripes->claim()) {
+    if (stripe >= num_stripes)
       return; // We're done.
+    CardValue* worker_start_card = start_card + stripe * ssize;
 
     CardValue* worker_end_card = worker_start_card + ssize;
     if (worker_end_card > end_card)
@@ -199,7 +211,7 @@ void PSCardTable::scavenge_contents_parallel(ObjectStartArray* start_array,
     if (GCWorkerDelayMillis > 0) {
       // Delay 1 worker so that it proceeds after all the work
       // has been completed.
-      if (stripe_number < 2) {
+      if (worker_id < 2) {
         os::naked_sleep(GCWorkerDelayMillis);
       }
     }
@@ -209,8 +221,29 @@ void PSCardTable::scavenge_contents_parallel(ObjectStartArray* start_array,
     if (!start_array->object_starts_in_range(slice_start, slice_end)) {
       continue;
     }
+
+    // If all cards of the stripe are clean, only the last object starting in
+    // the stripe may need scanning, if it extends onto dirty cards of the
+    // following stripes.
+    if (find_first_unclean_card(worker_start_card, worker_end_card) == worker_end_card) {
+      if (slice_end == (HeapWord*)sp_top) {
+        continue;
+      }
+      HeapWord* last_object = start_array->object_start(slice_end - 1);
+      if (last_object < slice_start) {
+        // Belongs to the stripe it starts in.
+        continue;
+      }
+      HeapWord* last_object_end = last_object + cast_to_oop(last_object)->size();
+      CardValue* last_object_end_card = MIN2(byte_for(last_object_end - 1) + 1, end_card);
+      if (last_object_end <= slice_end ||
+          find_first_unclean_card(worker_end_card, last_object_end_card) == last_object_end_card) {
+        continue;
+      }
+    }
+
     // Update our beginning addr
-    HeapWord* first_object = start_array->object_start(slice_start);
+    HeapWord* first_object = start_array->object_start(slice_start, (HeapWord*)last_scanned);
     debug_only(oop* first_object_within_slice = (oop*) first_object;)
     if (first_object < slice_start) {
       last_scanned = (oop*)(first_object + cast_to_oop(first_object)->size());
@@ -242,9 +275,7 @@ void PSCardTable::scavenge_contents_parallel(ObjectStartArray* start_array,
     CardValue* current_card = worker_start_card;
     while (current_card < worker_end_card) {
       // Find an unclean card.
-      while (current_card < worker_end_card && card_is_clean(*current_card)) {
-        current_card++;
-      }
+      current_card = find_first_unclean_card(current_card, worker_end_card);
       CardValue* first_unclean_card = current_card;
 
       // Find the end of a run of contiguous unclean cards
@@ -259,7 +290,8 @@ void PSCardTable::scavenge_contents_parallel(ObjectStartArray* start_array,
           // we will attempt to scan it twice. The test against "last_scanned"
           // prevents the redundant object scan, but it does not prevent newly
           // marked cards from being cleaned.
-          HeapWord* last_object_in_dirty_region = start_array->object_start(addr_for(current_card)-1);
+          HeapWord* last_object_in_dirty_region =
+            start_array->object_start(addr_for(current_card)-1, (HeapWord*)last_scanned);
           size_t size_of_last_object = cast_to_oop(last_object_in_dirty_region)->size();
           HeapWord* end_of_last_object = last_object_in_dirty_region + size_of_last_object;
           CardValue* ending_card_of_last_object = byte_for(end_of_last_object);
@@ -274,7 +306,8 @@ void PSCardTable::scavenge_contents_parallel(ObjectStartArray* start_array,
       CardValue* following_clean_card = current_card;
 
       if (first_unclean_card < worker_end_card) {
-        oop* p = (oop*) start_array->object_start(addr_for(first_unclean_card));
+        // last_scanned is an object start, usually close below this card.
+        oop* p = (oop*) start_array->object_start(addr_for(first_unclean_card), (HeapWord*)last_scanned);
         assert((HeapWord*)p <= addr_for(first_unclean_card), "checking");
         // "p" should always be >= "last_scanned" because newly GC dirtied
         // cards are no longer scanned again (see comment at end
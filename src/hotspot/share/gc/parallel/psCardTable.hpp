@@ -27,11 +27,24 @@
 
 #include "gc/shared/cardTable.hpp"
 #include "oops/oop.hpp"
+#include "runtime/atomic.hpp"
 
 class MutableSpace;
 class ObjectStartArray;
 class PSPromotionManager;
 
+// Hands out the stripes of cards scanned by scavenge_contents_parallel() in
+// address order to whichever worker asks next, so that workers finding few
+// dirty cards take on more of the old gen.
+class PSCardStripeClaimer {
+  volatile size_t _next_stripe;
+
+ public:
+  PSCardStripeClaimer() : _next_stripe(0) {}
+
+  size_t claim() { return Atomic::fetch_and_add(&_next_stripe, (size_t)1); }
+};
+
 class PSCardTable: public CardTable {
  private:
   // Support methods for resizing the card table.
@@ -45,6 +58,9 @@ class PSCardTable: public CardTable {
 
   void verify_all_young_refs_precise_helper(MemRegion mr);
 
+  // Returns the first card in [start, end) that is not clean, or end.
+  CardValue* find_first_unclean_card(CardValue* start, CardValue* end) const;
+
   enum ExtendedCardValue {
     youngergen_card   = CT_MR_BS_last_reserved + 1,
     verify_card       = CT_MR_BS_last_reserved + 5
@@ -57,12 +73,19 @@ class PSCardTable: public CardTable {
   static CardValue verify_card_val()     { return verify_card; }
 
   // Scavenge support
+
+  // scavenge_contents_parallel() hands out the old gen in stripes of this
+  // many cards.  The cards of a stripe are summarized a word at a time
+  // before any objects are looked up, so stripes without dirty cards are
+  // skipped in bulk.
+  static const size_t num_cards_in_stripe = 512;
+
   void scavenge_contents_parallel(ObjectStartArray* start_array,
                                   MutableSpace* sp,
                                   HeapWord* space_top,
                                   PSPromotionManager* pm,
-                                  uint stripe_number,
-                                  uint stripe_total);
+                                  PSCardStripeClaimer* stripes,
+                                  uint worker_id);
 
   bool addr_is_marked_imprecise(void *addr);
   bool addr_is_marked_precise(void *addr);
@@ -0,0 +1,300 @@
+/*
+ * Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/parallel/mutableSpace.hpp"
+#include "gc/parallel/psAdaptiveSizePolicy.hpp"
+#include "gc/parallel/psNUMASurvivorStripes.hpp"
+#include "gc/shared/collectedHeap.hpp"
+#include "gc/shared/spaceDecorator.hpp"
+#include "logging/log.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/os.hpp"
+#include "utilities/align.hpp"
+#include "utilities/powerOfTwo.hpp"
+
+void PSNUMASurvivorStripes::Stripe::initialize(HeapWord* bottom, HeapWord* end) {
+  assert(bottom <= end, "invariant");
+  _bottom = bottom;
+  _end = end;
+  _top = bottom;
+  _survived = 0;
+}
+
+HeapWord* PSNUMASurvivorStripes::Stripe::cas_allocate(size_t word_size) {
+  HeapWord* obj = Atomic::load(&_top);
+  while (true) {
+    const size_t available = pointer_delta(_end, obj);
+    if (word_size > available) {
+      return NULL;
+    }
+    // Never leave a tail that cannot be filled.
+    const size_t remainder = available - word_size;
+    if (remainder > 0 && remainder < CollectedHeap::min_fill_size()) {
+      return NULL;
+    }
+    HeapWord* result = Atomic::cmpxchg(&_top, obj, obj + word_size);
+    if (result == obj) {
+      assert(is_object_aligned(obj) && is_object_aligned(obj + word_size), "checking alignment");
+      return obj;
+    }
+    obj = result;
+  }
+}
+
+void PSNUMASurvivorStripes::Layout::initialize(const MutableSpace* space, uint nodes) {
+  _space = space;
+  _bounds = NEW_C_HEAP_ARRAY(HeapWord*, nodes + 2, mtGC);
+  for (uint i = 0; i < nodes + 2; i++) {
+    _bounds[i] = NULL;
+  }
+}
+
+PSNUMASurvivorStripes::PSNUMASurvivorStripes(MemRegion young_reserved,
+                                             MutableNUMASpace* eden,
+                                             MutableSpace* from_space,
+                                             MutableSpace* to_space) :
+  _eden(eden),
+  _nodes((uint)eden->lgrp_spaces()->length()),
+  _stripes(NULL),
+  _to_layout(&_layouts[1]),
+  _from_layout(&_layouts[0]),
+  _to_space(NULL),
+  _page_size(os::vm_page_size()),
+  _active(false),
+  _filler_words(0),
+  _table_base(young_reserved.start()),
+  _table_length(align_up(young_reserved.byte_size(), os::vm_page_size()) / os::vm_page_size()),
+  _table_shift(log2i_exact(os::vm_page_size())),
+  _node_table(NULL) {
+  assert(_nodes <= max_nodes(), "node index does not fit into the node table");
+  _stripes = NEW_C_HEAP_ARRAY(Stripe, _nodes + 1, mtGC);
+  for (uint i = 0; i <= _nodes; i++) {
+    _stripes[i].initialize(NULL, NULL);
+  }
+  _layouts[0].initialize(from_space, _nodes);
+  _layouts[1].initialize(to_space, _nodes);
+  _node_table = NEW_C_HEAP_ARRAY(u1, _table_length, mtGC);
+  memset(_node_table, 0, _table_length);
+}
+
+void PSNUMASurvivorStripes::set_node_index(HeapWord* bottom, HeapWord* end, uint node) {
+  assert(_table_base <= bottom && bottom <= end, "invariant");
+  // The eden chunks and the stripes are page aligned, except at the ends of
+  // the spaces, which are aligned to the (larger) space alignment.
+  const size_t from = pointer_delta(bottom, _table_base, 1) >> _table_shift;
+  const size_t to = align_up(pointer_delta(end, _table_base, 1), os::vm_page_size()) >> _table_shift;
+  assert(to <= _table_length, "out of range");
+  memset(_node_table + from, (int)node, to - from);
+}
+
+void PSNUMASurvivorStripes::update_node_table() {
+  for (uint i = 0; i < _nodes; i++) {
+    MutableSpace* chunk = _eden->lgrp_spaces()->at((int)i)->space();
+    set_node_index(chunk->bottom(), chunk->end(), i);
+  }
+  // Objects in from-space stay with the node of the stripe they were copied
+  // to at the last scavenge.  Survivors in the spill stripe, or copied while
+  // the stripes were inactive, go to the first node.  The bounds are clipped
+  // in case from-space has been resized since.
+  HeapWord* const bottom = _from_layout->space()->bottom();
+  HeapWord* const end = _from_layout->space()->end();
+  set_node_index(bottom, end, 0);
+  if (_from_layout->is_valid()) {
+    for (uint i = 1; i < _nodes; i++) {
+      HeapWord* const stripe_bottom = clamp(_from_layout->bound(i), bottom, end);
+      HeapWord* const stripe_end = clamp(_from_layout->bound(i + 1), bottom, end);
+      set_node_index(stripe_bottom, stripe_end, i);
+    }
+  }
+}
+
+void PSNUMASurvivorStripes::desired_stripe_words(PSAdaptiveSizePolicy* policy,
+                                                 size_t capacity,
+                                                 size_t* words) const {
+  const size_t page_words = _page_size / HeapWordSize;
+  // Until a node has been sampled, assume survivors are spread evenly.
+  const size_t even_words = (size_t)policy->avg_survived()->padded_average() / HeapWordSize / _nodes;
+
+  size_t total = 0;
+  for (uint i = 0; i < _nodes; i++) {
+    size_t node_words = policy->has_survived_per_node(i)
+                      ? policy->padded_survived_per_node(i) / HeapWordSize
+                      : even_words;
+    words[i] = align_up(MAX2(node_words, page_words), page_words);
+    total += words[i];
+  }
+
+  if (total > capacity) {
+    // Shrink the stripes proportionally, leaving no spill stripe.
+    for (uint i = 0; i < _nodes; i++) {
+      words[i] = align_down((size_t)((double)words[i] * capacity / total), page_words);
+      words[i] = MAX2(words[i], page_words);
+    }
+  }
+}
+
+void PSNUMASurvivorStripes::prepare(MutableSpace* to_space, PSAdaptiveSizePolicy* policy) {
+  assert(!_active, "stripes not retired");
+  assert(to_space->is_empty(), "to-space must be empty");
+
+  if (_from_layout->space() == to_space) {
+    // The survivor spaces have been swapped.
+    Layout* tmp = _to_layout;
+    _to_layout = _from_layout;
+    _from_layout = tmp;
+  }
+  assert(_to_layout->space() == to_space, "unknown survivor space");
+  _to_space = to_space;
+  _filler_words = 0;
+
+  _page_size = UseLargePages ? to_space->alignment() : os::vm_page_size();
+  HeapWord* const bottom = to_space->bottom();
+  HeapWord* const end = to_space->end();
+  HeapWord* const first_bound = align_up(bottom, _page_size);
+  HeapWord* const last_bound = align_down(end, _page_size);
+  const size_t page_words = _page_size / HeapWordSize;
+
+  if (_eden->lgrp_spaces()->length() != (int)_nodes ||
+      last_bound <= first_bound ||
+      pointer_delta(last_bound, first_bound) < _nodes * page_words) {
+    // The NUMA topology changed, or to-space is too small to split.
+    log_debug(gc, heap)("NUMA survivor stripes inactive: to-space " SIZE_FORMAT "K, %u nodes",
+                        to_space->capacity_in_bytes() / K, _nodes);
+    _to_layout->set_valid(false);
+    return;
+  }
+
+  size_t* words = NEW_C_HEAP_ARRAY(size_t, _nodes, mtGC);
+  desired_stripe_words(policy, pointer_delta(last_bound, first_bound), words);
+
+  HeapWord* bound = bottom;
+  for (uint i = 0; i < _nodes; i++) {
+    // Leave at least a page for each of the remaining stripes.
+    HeapWord* const limit = last_bound - (_nodes - 1 - i) * page_words;
+    HeapWord* const next = MIN2((i == 0 ? first_bound : bound) + words[i], limit);
+    MemRegion old_mr = _to_layout->is_valid() ? MemRegion(_to_layout->bound(i), _to_layout->bound(i + 1))
+                                              : MemRegion();
+    bias_stripe(i, MemRegion(bound, next), old_mr);
+    _stripes[i].initialize(bound, next);
+    _to_layout->set_bound(i, bound);
+    bound = next;
+  }
+  assert(bound <= last_bound, "stripes must fit into to-space");
+  _stripes[spill_stripe()].initialize(bound, end);
+  _to_layout->set_bound(_nodes, bound);
+  _to_layout->set_bound(_nodes + 1, end);
+  _to_layout->set_valid(true);
+
+  FREE_C_HEAP_ARRAY(size_t, words);
+
+  update_node_table();
+
+  log_debug(gc, heap)("NUMA survivor stripes: " SIZE_FORMAT "K spill of " SIZE_FORMAT "K",
+                      pointer_delta(end, bound, 1) / K, to_space->capacity_in_bytes() / K);
+  _active = true;
+}
+
+void PSNUMASurvivorStripes::bias_stripe(uint node, MemRegion new_mr, MemRegion old_mr) {
+  const int lgrp_id = _eden->lgrp_id_at((int)node);
+  if (new_mr.intersection(old_mr).is_empty()) {
+    bias_region(new_mr, lgrp_id);
+    return;
+  }
+  // Only the tails of the new stripe outside of the old stripe change node.
+  if (new_mr.start() < old_mr.start()) {
+    bias_region(MemRegion(new_mr.start(), old_mr.start()), lgrp_id);
+  }
+  if (old_mr.end() < new_mr.end()) {
+    bias_region(MemRegion(old_mr.end(), new_mr.end()), lgrp_id);
+  }
+}
+
+void PSNUMASurvivorStripes::bias_region(MemRegion mr, int lgrp_id) {
+  HeapWord* start = align_up(mr.start(), _page_size);
+  HeapWord* end = align_down(mr.end(), _page_size);
+  if (end > start) {
+    MemRegion aligned_region(start, end);
+    // To-space is empty, so the pages can be freed and will be allocated on
+    // the node when next touched.
+    os::realign_memory((char*)aligned_region.start(), aligned_region.byte_size(), _page_size);
+    os::free_memory((char*)aligned_region.start(), aligned_region.byte_size(), _page_size);
+    os::numa_make_local((char*)aligned_region.start(), aligned_region.byte_size(), lgrp_id);
+    if (ZapUnusedHeapArea) {
+      SpaceMangler::mangle_region(aligned_region);
+    }
+  }
+}
+
+HeapWord* PSNUMASurvivorStripes::cas_allocate(uint node, size_t word_size) {
+  assert(_active, "stripes not prepared");
+  assert(node < _nodes, "node out of range");
+
+  HeapWord* obj = _stripes[node].cas_allocate(word_size);
+  for (uint i = 0; obj == NULL && i <= _nodes; i++) {
+    // Try the spill stripe first.
+    uint other = (spill_stripe() + i) % (_nodes + 1);
+    if (other != node) {
+      obj = _stripes[other].cas_allocate(word_size);
+    }
+  }
+  if (obj == NULL) {
+    return NULL;
+  }
+
+  // Keep to-space top at the end of the highest allocation.
+  HeapWord* const obj_end = obj + word_size;
+  HeapWord* cur_top = _to_space->top();
+  while (cur_top < obj_end) {
+    HeapWord* result = Atomic::cmpxchg(_to_space->top_addr(), cur_top, obj_end);
+    if (result == cur_top) {
+      break;
+    }
+    cur_top = result;
+  }
+  return obj;
+}
+
+void PSNUMASurvivorStripes::retire(PSAdaptiveSizePolicy* policy) {
+  if (!_active) {
+    return;
+  }
+
+  HeapWord* const top = _to_space->top();
+  for (uint i = 0; i <= _nodes; i++) {
+    Stripe* stripe = &_stripes[i];
+    if (stripe->top() < top && stripe->top() < stripe->end()) {
+      assert(stripe->end() <= top, "only the highest stripe can contain top");
+      const size_t words = pointer_delta(stripe->end(), stripe->top());
+      CollectedHeap::fill_with_objects(stripe->top(), words);
+      _filler_words += words;
+    }
+    if (i < _nodes) {
+      policy->update_survived_per_node(i, stripe->survived() * HeapWordSize);
+    }
+  }
+
+  log_debug(gc, heap)("NUMA survivor stripes: filled " SIZE_FORMAT "K", filler_bytes() / K);
+  _active = false;
+}
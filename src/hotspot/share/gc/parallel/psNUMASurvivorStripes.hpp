@@ -0,0 +1,174 @@
+/*
+ * Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_GC_PARALLEL_PSNUMASURVIVORSTRIPES_HPP
+#define SHARE_GC_PARALLEL_PSNUMASURVIVORSTRIPES_HPP
+
+#include "gc/parallel/mutableNUMASpace.hpp"
+#include "memory/allocation.hpp"
+#include "memory/memRegion.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+class MutableSpace;
+class PSAdaptiveSizePolicy;
+
+//
+// With UseNUMA eden is split into one chunk per locality group, but the
+// survivor spaces are interleaved over all nodes, so objects surviving a
+// scavenge usually end up on a remote node.  PSNUMASurvivorStripes splits
+// to-space into one stripe per locality group for the duration of a scavenge.
+// Each stripe is biased to its node, and an object is copied into the stripe
+// of the node it was allocated on (the eden chunk, or the from-space stripe,
+// it is found in).
+//
+// The node of an object is looked up in a table with one entry per page of the
+// young generation, which is rebuilt from the eden chunks and the from-space
+// stripes at the start of each scavenge.
+//
+// The stripes are packed at the bottom of to-space and sized from what each
+// node's objects survived in recent scavenges.  The remainder of to-space is a
+// shared spill stripe that is not biased.  When a node's stripe is full its
+// survivors go to the spill stripe and then to the other nodes' stripes.  The
+// free tail of a stripe below to-space top is filled after the scavenge to keep
+// the space parsable.
+//
+// The layout of each survivor space is remembered, so that only pages that
+// move to another node are freed and rebiased.
+//
+
+class PSNUMASurvivorStripes : public CHeapObj<mtGC> {
+  class Stripe {
+    HeapWord*          _bottom;
+    HeapWord*          _end;
+    HeapWord* volatile _top;
+    // Words of the objects of this stripe's node copied to to-space,
+    // wherever they were allocated.
+    size_t             _survived;
+
+   public:
+    Stripe() : _bottom(NULL), _end(NULL), _top(NULL), _survived(0) {}
+
+    void initialize(HeapWord* bottom, HeapWord* end);
+
+    HeapWord* bottom() const { return _bottom; }
+    HeapWord* end() const    { return _end; }
+    HeapWord* top() const    { return _top; }
+    size_t survived() const  { return _survived; }
+
+    void add_survived(size_t word_size) { _survived += word_size; }
+    HeapWord* cas_allocate(size_t word_size);
+  };
+
+  // Stripe boundaries of a survivor space at its last scavenge as to-space.
+  class Layout {
+    const MutableSpace* _space;
+    HeapWord**          _bounds;
+    bool                _is_valid;
+
+   public:
+    Layout() : _space(NULL), _bounds(NULL), _is_valid(false) {}
+
+    void initialize(const MutableSpace* space, uint nodes);
+
+    const MutableSpace* space() const { return _space; }
+    bool is_valid() const             { return _is_valid; }
+    void set_valid(bool value)        { _is_valid = value; }
+
+    HeapWord* bound(uint i) const { return _bounds[i]; }
+    void set_bound(uint i, HeapWord* addr) { _bounds[i] = addr; }
+  };
+
+  MutableNUMASpace* const _eden;
+  const uint              _nodes;
+  // Node stripes followed by the spill stripe.
+  Stripe*                 _stripes;
+  // One layout for each of the survivor spaces.
+  Layout                  _layouts[2];
+  Layout*                 _to_layout;
+  Layout*                 _from_layout;
+  MutableSpace*           _to_space;
+  size_t                  _page_size;
+  bool                    _active;
+  size_t                  _filler_words;
+
+  // Node index of each page of the young generation.
+  HeapWord* const         _table_base;
+  const size_t            _table_length;
+  const int               _table_shift;
+  u1*                     _node_table;
+
+  uint spill_stripe() const { return _nodes; }
+
+  void set_node_index(HeapWord* bottom, HeapWord* end, uint node);
+  void update_node_table();
+
+  // Words of to-space wanted for each node stripe.
+  void desired_stripe_words(PSAdaptiveSizePolicy* policy, size_t capacity, size_t* words) const;
+  // Bias the part of the new stripe of the node that was not already part
+  // of its stripe in the previous layout of to-space.
+  void bias_stripe(uint node, MemRegion new_mr, MemRegion old_mr);
+  void bias_region(MemRegion mr, int lgrp_id);
+
+ public:
+  PSNUMASurvivorStripes(MemRegion young_reserved,
+                        MutableNUMASpace* eden,
+                        MutableSpace* from_space,
+                        MutableSpace* to_space);
+
+  // The node indices must fit into the entries of the node table.
+  static uint max_nodes() { return (uint)max_jubyte + 1; }
+
+  uint nodes() const     { return _nodes; }
+  bool is_active() const { return _active; }
+
+  // Lay out the (empty) to-space before a scavenge.  The stripes are left
+  // inactive if to-space is too small to give each node a page.
+  void prepare(MutableSpace* to_space, PSAdaptiveSizePolicy* policy);
+  // Fill the gaps between the stripes and sample the per node statistics
+  // after all promotion LABs have been flushed.
+  void retire(PSAdaptiveSizePolicy* policy);
+
+  // Account words of the node's objects copied to to-space.  Called serially
+  // when the promotion LABs are flushed.
+  void add_survived(uint node, size_t word_size) { _stripes[node].add_survived(word_size); }
+
+  // The node whose stripe survivors of the young object at addr go to.
+  inline uint node_index_for(const void* addr) const;
+
+  // Allocate in the stripe of the node, falling back to the spill stripe and
+  // the other stripes.  Returns NULL if to-space is full.
+  HeapWord* cas_allocate(uint node, size_t word_size);
+
+  // Bytes of to-space filled by retire() at the last scavenge.
+  size_t filler_bytes() const { return _filler_words * HeapWordSize; }
+};
+
+inline uint PSNUMASurvivorStripes::node_index_for(const void* addr) const {
+  assert(_active, "node table only valid during a scavenge");
+  const size_t index = pointer_delta(addr, _table_base, 1) >> _table_shift;
+  assert(index < _table_length, "address " PTR_FORMAT " not in young generation", p2i(addr));
+  return _node_table[index];
+}
+
+#endif // SHARE_GC_PARALLEL_PSNUMASURVIVORSTRIPES_HPP
@@ -552,15 +552,127 @@ void ParallelCompactData::add_obj(HeapWord* addr, size_t len)
   _region_data[end_region].set_partial_obj_addr(addr);
 }
 
+// Hands out chunks of ParallelCompactData::SummaryChunkRegions consecutive
+// regions to the workers.
+class PCRegionChunkTask : public AbstractGangTask {
+  const size_t _beg_region;
+  const size_t _end_region;
+  const size_t _num_chunks;
+  volatile size_t _next_chunk;
+
+protected:
+  virtual void do_chunk(size_t chunk, size_t beg_region, size_t end_region) = 0;
+
+public:
+  PCRegionChunkTask(const char* name, size_t beg_region, size_t end_region) :
+    AbstractGangTask(name),
+    _beg_region(beg_region),
+    _end_region(end_region),
+    _num_chunks(num_chunks(beg_region, end_region)),
+    _next_chunk(0) {}
+
+  static size_t num_chunks(size_t beg_region, size_t end_region) {
+    return (end_region - beg_region + ParallelCompactData::SummaryChunkRegions - 1) /
+           ParallelCompactData::SummaryChunkRegions;
+  }
+
+  // Only worth handing out to the workers if there is more than one chunk.
+  static bool should_run_in_parallel(size_t beg_region, size_t end_region) {
+    return ParallelScavengeHeap::heap()->workers().active_workers() > 1 &&
+           num_chunks(beg_region, end_region) > 1;
+  }
+
+  size_t num_chunks() const { return _num_chunks; }
+
+  void reset() { _next_chunk = 0; }
+
+  virtual void work(uint worker_id) {
+    for (size_t chunk = Atomic::fetch_and_add(&_next_chunk, (size_t)1);
+         chunk < _num_chunks;
+         chunk = Atomic::fetch_and_add(&_next_chunk, (size_t)1)) {
+      size_t beg = _beg_region + chunk * ParallelCompactData::SummaryChunkRegions;
+      size_t end = MIN2(beg + ParallelCompactData::SummaryChunkRegions, _end_region);
+      do_chunk(chunk, beg, end);
+    }
+  }
+};
+
+class PCDensePrefixTask : public PCRegionChunkTask {
+  ParallelCompactData& _sd;
+
+  virtual void do_chunk(size_t chunk, size_t beg_region, size_t end_region) {
+    _sd.summarize_dense_prefix_regions(beg_region, end_region);
+  }
+
+public:
+  PCDensePrefixTask(ParallelCompactData& sd, size_t beg_region, size_t end_region) :
+    PCRegionChunkTask("PCDensePrefixTask", beg_region, end_region),
+    _sd(sd) {}
+};
+
+// Summarizes a range of regions in two passes: the first counts the live words
+// in each chunk, and after the destination of each chunk has been computed from
+// those, the second summarizes the chunks.
+class PCSummaryTask : public PCRegionChunkTask {
+  ParallelCompactData& _sd;
+  SplitInfo& _split_info;
+  size_t* const _chunk_words;
+  HeapWord** const _chunk_dest;
+  bool _summarize;
+
+  virtual void do_chunk(size_t chunk, size_t beg_region, size_t end_region) {
+    if (_summarize) {
+      HeapWord* const end = _sd.summarize_regions(_split_info, beg_region, end_region, _chunk_dest[chunk]);
+      assert(end == _chunk_dest[chunk] + _chunk_words[chunk], "summarized live words must match counted");
+    } else {
+      _chunk_words[chunk] = _sd.live_words_in_regions(beg_region, end_region);
+    }
+  }
+
+public:
+  PCSummaryTask(ParallelCompactData& sd, SplitInfo& split_info, size_t beg_region, size_t end_region) :
+    PCRegionChunkTask("PCSummaryTask", beg_region, end_region),
+    _sd(sd),
+    _split_info(split_info),
+    _chunk_words(NEW_C_HEAP_ARRAY(size_t, num_chunks(), mtGC)),
+    _chunk_dest(NEW_C_HEAP_ARRAY(HeapWord*, num_chunks(), mtGC)),
+    _summarize(false) {}
+
+  ~PCSummaryTask() {
+    FREE_C_HEAP_ARRAY(size_t, _chunk_words);
+    FREE_C_HEAP_ARRAY(HeapWord*, _chunk_dest);
+  }
+
+  size_t chunk_words(size_t chunk) const { return _chunk_words[chunk]; }
+  void set_chunk_destination(size_t chunk, HeapWord* dest_addr) { _chunk_dest[chunk] = dest_addr; }
+
+  void start_summarize() {
+    _summarize = true;
+    reset();
+  }
+};
+
 void
 ParallelCompactData::summarize_dense_prefix(HeapWord* beg, HeapWord* end)
 {
   assert(is_region_aligned(beg), "not RegionSize aligned");
   assert(is_region_aligned(end), "not RegionSize aligned");
 
-  size_t cur_region = addr_to_region_idx(beg);
+  const size_t beg_region = addr_to_region_idx(beg);
   const size_t end_region = addr_to_region_idx(end);
-  HeapWord* addr = beg;
+  if (PCRegionChunkTask::should_run_in_parallel(beg_region, end_region)) {
+    PCDensePrefixTask task(*this, beg_region, end_region);
+    ParallelScavengeHeap::heap()->workers().run_task(&task);
+  } else {
+    summarize_dense_prefix_regions(beg_region, end_region);
+  }
+}
+
+void
+ParallelCompactData::summarize_dense_prefix_regions(size_t beg_region, size_t end_region)
+{
+  size_t cur_region = beg_region;
+  HeapWord* addr = region_to_addr(beg_region);
   while (cur_region < end_region) {
     _region_data[cur_region].set_destination(addr);
     _region_data[cur_region].set_destination_count(0);
@@ -682,6 +794,120 @@ ParallelCompactData::summarize_split_space(size_t src_region,
   return source_next;
 }
 
+void ParallelCompactData::summarize_region(SplitInfo& split_info, size_t cur_region, HeapWord* dest_addr)
+{
+  // Compute the destination_count for cur_region, and if necessary, update
+  // source_region for a destination region.  The source_region field is
+  // updated if cur_region is the first (left-most) region to be copied to a
+  // destination region.
+  //
+  // The destination_count calculation is a bit subtle.  A region that has
+  // data that compacts into itself does not count itself as a destination.
+  // This maintains the invariant that a zero count means the region is
+  // available and can be claimed and then filled.
+  uint destination_count = 0;
+  if (split_info.is_split(cur_region)) {
+    // The current region has been split:  the partial object will be copied
+    // to one destination space and the remaining data will be copied to
+    // another destination space.  Adjust the initial destination_count and,
+    // if necessary, set the source_region field if the partial object will
+    // cross a destination region boundary.
+    destination_count = split_info.destination_count();
+    if (destination_count == 2) {
+      size_t dest_idx = addr_to_region_idx(split_info.dest_region_addr());
+      _region_data[dest_idx].set_source_region(cur_region);
+    }
+  }
+
+  HeapWord* const last_addr = dest_addr + _region_data[cur_region].data_size() - 1;
+  const size_t dest_region_1 = addr_to_region_idx(dest_addr);
+  const size_t dest_region_2 = addr_to_region_idx(last_addr);
+
+  // Initially assume that the destination regions will be the same and
+  // adjust the value below if necessary.  Under this assumption, if
+  // cur_region == dest_region_2, then cur_region will be compacted
+  // completely into itself.
+  destination_count += cur_region == dest_region_2 ? 0 : 1;
+  if (dest_region_1 != dest_region_2) {
+    // Destination regions differ; adjust destination_count.
+    destination_count += 1;
+    // Data from cur_region will be copied to the start of dest_region_2.
+    _region_data[dest_region_2].set_source_region(cur_region);
+  } else if (is_region_aligned(dest_addr)) {
+    // Data from cur_region will be copied to the start of the destination
+    // region.
+    _region_data[dest_region_1].set_source_region(cur_region);
+  }
+
+  _region_data[cur_region].set_destination_count(destination_count);
+  _region_data[cur_region].set_data_location(region_to_addr(cur_region));
+}
+
+size_t ParallelCompactData::live_words_in_regions(size_t beg_region, size_t end_region) const
+{
+  size_t words = 0;
+  for (size_t cur_region = beg_region; cur_region < end_region; ++cur_region) {
+    words += _region_data[cur_region].data_size();
+  }
+  return words;
+}
+
+HeapWord* ParallelCompactData::summarize_regions(SplitInfo& split_info,
+                                                 size_t beg_region, size_t end_region,
+                                                 HeapWord* dest_addr)
+{
+  for (size_t cur_region = beg_region; cur_region < end_region; ++cur_region) {
+    // The destination must be set even if the region has no data.
+    _region_data[cur_region].set_destination(dest_addr);
+
+    size_t words = _region_data[cur_region].data_size();
+    if (words > 0) {
+      summarize_region(split_info, cur_region, dest_addr);
+      dest_addr += words;
+    }
+  }
+  return dest_addr;
+}
+
+// Summarizes [beg_region, end_region) with the gang if all of it fits into the
+// target space.  Returns false, without having modified the summary data, if
+// the range is too small to be worth splitting into chunks, or if it has to be
+// split, which is left to the serial summary.
+bool ParallelCompactData::summarize_in_parallel(SplitInfo& split_info,
+                                                size_t beg_region, size_t end_region,
+                                                HeapWord* target_beg, HeapWord* target_end,
+                                                HeapWord** target_next)
+{
+  // A split region has its destination count and source regions adjusted by
+  // the split info, which is left to the serial summary.
+  if (split_info.is_valid() ||
+      !PCRegionChunkTask::should_run_in_parallel(beg_region, end_region)) {
+    return false;
+  }
+
+  WorkGang& workers = ParallelScavengeHeap::heap()->workers();
+  PCSummaryTask task(*this, split_info, beg_region, end_region);
+  workers.run_task(&task);
+
+  // The destination of each chunk is the end of the live data of the chunks to
+  // its left.
+  const size_t target_words = pointer_delta(target_end, target_beg);
+  size_t live_words = 0;
+  for (size_t chunk = 0; chunk < task.num_chunks(); ++chunk) {
+    task.set_chunk_destination(chunk, target_beg + live_words);
+    live_words += task.chunk_words(chunk);
+    if (live_words > target_words) {
+      return false;
+    }
+  }
+
+  task.start_summarize();
+  workers.run_task(&task);
+
+  *target_next = target_beg + live_words;
+  return true;
+}
+
 bool ParallelCompactData::summarize(SplitInfo& split_info,
                                     HeapWord* source_beg, HeapWord* source_end,
                                     HeapWord** source_next,
@@ -698,6 +924,11 @@ bool ParallelCompactData::summarize(SplitInfo& split_info,
   size_t cur_region = addr_to_region_idx(source_beg);
   const size_t end_region = addr_to_region_idx(region_align_up(source_end));
 
+  if (summarize_in_parallel(split_info, cur_region, end_region,
+                            target_beg, target_end, target_next)) {
+    return true;
+  }
+
   HeapWord *dest_addr = target_beg;
   while (cur_region < end_region) {
     // The destination must be set even if the region has no data.
@@ -715,51 +946,7 @@ bool ParallelCompactData::summarize(SplitInfo& split_info,
         return false;
       }
 
-      // Compute the destination_count for cur_region, and if necessary, update
-      // source_region for a destination region.  The source_region field is
-      // updated if cur_region is the first (left-most) region to be copied to a
-      // destination region.
-      //
-      // The destination_count calculation is a bit subtle.  A region that has
-      // data that compacts into itself does not count itself as a destination.
-      // This maintains the invariant that a zero count means the region is
-      // available and can be claimed and then filled.
-      uint destination_count = 0;
-      if (split_info.is_split(cur_region)) {
-        // The current region has been split:  the partial object will be copied
-        // to one destination space and the remaining data will be copied to
-        // another destination space.  Adjust the initial destination_count and,
-        // if necessary, set the source_region field if the partial object will
-        // cross a destination region boundary.
-        destination_count = split_info.destination_count();
-        if (destination_count == 2) {
-          size_t dest_idx = addr_to_region_idx(split_info.dest_region_addr());
-          _region_data[dest_idx].set_source_region(cur_region);
-        }
-      }
-
-      HeapWord* const last_addr = dest_addr + words - 1;
-      const size_t dest_region_1 = addr_to_region_idx(dest_addr);
-      const size_t dest_region_2 = addr_to_region_idx(last_addr);
-
-      // Initially assume that the destination regions will be the same and
-      // adjust the value below if necessary.  Under this assumption, if
-      // cur_region == dest_region_2, then cur_region will be compacted
-      // completely into itself.
-      destination_count += cur_region == dest_region_2 ? 0 : 1;
-      if (dest_region_1 != dest_region_2) {
-        // Destination regions differ; adjust destination_count.
-        destination_count += 1;
-        // Data from cur_region will be copied to the start of dest_region_2.
-        _region_data[dest_region_2].set_source_region(cur_region);
-      } else if (is_region_aligned(dest_addr)) {
-        // Data from cur_region will be copied to the start of the destination
-        // region.
-        _region_data[dest_region_1].set_source_region(cur_region);
-      }
-
-      _region_data[cur_region].set_destination_count(destination_count);
-      _region_data[cur_region].set_data_location(region_to_addr(cur_region));
+      summarize_region(split_info, cur_region, dest_addr);
       dest_addr += words;
     }
 
@@ -1341,6 +1528,61 @@ PSParallelCompact::reclaimed_ratio(const RegionData* const cp,
   return double(reclaimable) / divisor;
 }
 
+// Finds the region with the best reclaimed ratio in each chunk.  Reducing the
+// chunks from left to right, and preferring the leftmost region within a chunk,
+// selects the same region as scanning all regions serially.
+class PCReclaimedRatioTask : public PCRegionChunkTask {
+  HeapWord* const _bottom;
+  HeapWord* const _top;
+  HeapWord* const _new_top;
+  const size_t _full_region;
+  size_t* const _chunk_best_region;
+  double* const _chunk_best_ratio;
+
+  virtual void do_chunk(size_t chunk, size_t beg_region, size_t end_region) {
+    const ParallelCompactData& sd = PSParallelCompact::summary_data();
+    double best_ratio = 0.0;
+    size_t best_region = _full_region;
+    for (size_t cur_region = beg_region; cur_region < end_region; ++cur_region) {
+      double tmp_ratio = PSParallelCompact::reclaimed_ratio(sd.region(cur_region), _bottom, _top, _new_top);
+      if (tmp_ratio > best_ratio) {
+        best_region = cur_region;
+        best_ratio = tmp_ratio;
+      }
+    }
+    _chunk_best_region[chunk] = best_region;
+    _chunk_best_ratio[chunk] = best_ratio;
+  }
+
+public:
+  PCReclaimedRatioTask(size_t beg_region, size_t end_region,
+                       HeapWord* bottom, HeapWord* top, HeapWord* new_top) :
+    PCRegionChunkTask("PCReclaimedRatioTask", beg_region, end_region),
+    _bottom(bottom),
+    _top(top),
+    _new_top(new_top),
+    _full_region(beg_region),
+    _chunk_best_region(NEW_C_HEAP_ARRAY(size_t, num_chunks(), mtGC)),
+    _chunk_best_ratio(NEW_C_HEAP_ARRAY(double, num_chunks(), mtGC)) {}
+
+  ~PCReclaimedRatioTask() {
+    FREE_C_HEAP_ARRAY(size_t, _chunk_best_region);
+    FREE_C_HEAP_ARRAY(double, _chunk_best_ratio);
+  }
+
+  size_t best_region() const {
+    double best_ratio = 0.0;
+    size_t best_region = _full_region;
+    for (size_t chunk = 0; chunk < num_chunks(); ++chunk) {
+      if (_chunk_best_ratio[chunk] > best_ratio) {
+        best_region = _chunk_best_region[chunk];
+        best_ratio = _chunk_best_ratio[chunk];
+      }
+    }
+    return best_region;
+  }
+};
+
 // Return the address of the end of the dense prefix, a.k.a. the start of the
 // compacted region.  The address is always on a region boundary.
 //
@@ -1417,6 +1659,14 @@ PSParallelCompact::compute_dense_prefix(const SpaceId id,
 
   // Scan from the first region with dead space to the limit region and find the
   // one with the best (largest) reclaimed ratio.
+  const size_t full_region = sd.region(full_cp);
+  const size_t limit_region = sd.region(limit_cp);
+  if (PCRegionChunkTask::should_run_in_parallel(full_region, limit_region)) {
+    PCReclaimedRatioTask task(full_region, limit_region, bottom, top, new_top);
+    ParallelScavengeHeap::heap()->workers().run_task(&task);
+    return sd.region_to_addr(task.best_region());
+  }
+
   double best_ratio = 0.0;
   const RegionData* best_cp = full_cp;
   for (const RegionData* cp = full_cp; cp < limit_cp; ++cp) {
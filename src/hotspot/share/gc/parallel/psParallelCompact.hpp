@@ -231,6 +231,9 @@ public:
   static const size_t BlocksPerRegion;
   static const size_t Log2BlocksPerRegion;
 
+  // The summary is computed in parallel for chunks of this many regions.
+  static const size_t SummaryChunkRegions = 1024;
+
   class RegionData
   {
   public:
@@ -432,6 +435,7 @@ public:
   // destination of region n is simply the start of region n.  Both arguments
   // beg and end must be region-aligned.
   void summarize_dense_prefix(HeapWord* beg, HeapWord* end);
+  void summarize_dense_prefix_regions(size_t beg_region, size_t end_region);
 
   HeapWord* summarize_split_space(size_t src_region, SplitInfo& split_info,
                                   HeapWord* destination, HeapWord* target_end,
@@ -442,6 +446,14 @@ public:
                  HeapWord* target_beg, HeapWord* target_end,
                  HeapWord** target_next);
 
+  // Building blocks of the parallel summary.  The live words in the chunks to
+  // the left of a chunk give its destination, after which chunks that fit into
+  // the target can be summarized independently.
+  size_t live_words_in_regions(size_t beg_region, size_t end_region) const;
+  HeapWord* summarize_regions(SplitInfo& split_info,
+                              size_t beg_region, size_t end_region,
+                              HeapWord* dest_addr);
+
   void clear();
   void clear_range(size_t beg_region, size_t end_region);
   void clear_range(HeapWord* beg, HeapWord* end) {
@@ -497,6 +509,14 @@ private:
   bool initialize_region_data(size_t region_size);
   PSVirtualSpace* create_vspace(size_t count, size_t element_size);
 
+  // Sets the destination count and source regions for a region with live data
+  // that fits entirely into the target at dest_addr.
+  void summarize_region(SplitInfo& split_info, size_t cur_region, HeapWord* dest_addr);
+  bool summarize_in_parallel(SplitInfo& split_info,
+                             size_t beg_region, size_t end_region,
+                             HeapWord* target_beg, HeapWord* target_end,
+                             HeapWord** target_next);
+
 private:
   HeapWord*       _region_start;
 #ifdef  ASSERT
@@ -1004,6 +1024,7 @@ class PSParallelCompact : AllStatic {
 
   friend class RefProcTaskProxy;
   friend class PSParallelCompactTest;
+  friend class PCReclaimedRatioTask;
 
  private:
   static STWGCTimer           _gc_timer;
@@ -24,12 +24,16 @@
 
 #include "precompiled.hpp"
 #include "classfile/javaClasses.inline.hpp"
+#include "gc/parallel/mutableNUMASpace.hpp"
 #include "gc/parallel/mutableSpace.hpp"
 #include "gc/parallel/parallelScavengeHeap.hpp"
+#include "gc/parallel/psAdaptiveSizePolicy.hpp"
+#include "gc/parallel/psNUMASurvivorStripes.hpp"
 #include "gc/parallel/psOldGen.hpp"
 #include "gc/parallel/psPromotionManager.inline.hpp"
 #include "gc/parallel/psScavenge.inline.hpp"
 #include "gc/shared/gcTrace.hpp"
+#include "gc/shared/partialArrayTaskStepper.inline.hpp"
 #include "gc/shared/preservedMarks.inline.hpp"
 #include "gc/shared/taskqueue.inline.hpp"
 #include "logging/log.hpp"
@@ -47,6 +51,7 @@ PSPromotionManager::PSScannerTasksQueueSet* PSPromotionManager::_stack_array_dep
 PreservedMarksSet*             PSPromotionManager::_preserved_marks_set = NULL;
 PSOldGen*                      PSPromotionManager::_old_gen = NULL;
 MutableSpace*                  PSPromotionManager::_young_space = NULL;
+PSNUMASurvivorStripes*         PSPromotionManager::_survivor_stripes = NULL;
 
 void PSPromotionManager::initialize() {
   ParallelScavengeHeap* heap = ParallelScavengeHeap::heap();
@@ -54,6 +59,24 @@ void PSPromotionManager::initialize() {
   _old_gen = heap->old_gen();
   _young_space = heap->young_gen()->to_space();
 
+  if (UseNUMA && UseNUMASurvivorStripes) {
+    if (UseLargePages && !os::can_commit_large_page_memory()) {
+      // The stripes are biased by freeing their pages, which is not
+      // supported for large pages that cannot be committed on demand.
+      log_info(gc, heap)("NUMA survivor stripes disabled: large pages cannot be freed");
+    } else if (os::numa_get_groups_num() > PSNUMASurvivorStripes::max_nodes()) {
+      log_info(gc, heap)("NUMA survivor stripes disabled: more than %u nodes",
+                         PSNUMASurvivorStripes::max_nodes());
+    } else {
+      PSYoungGen* young_gen = heap->young_gen();
+      _survivor_stripes = new PSNUMASurvivorStripes(young_gen->reserved(),
+                                                    (MutableNUMASpace*)young_gen->eden_space(),
+                                                    young_gen->from_space(),
+                                                    young_gen->to_space());
+      heap->size_policy()->initialize_survived_per_node(_survivor_stripes->nodes());
+    }
+  }
+
   const uint promotion_manager_num = ParallelGCThreads + 1;
 
   // To prevent false sharing, we pad the PSPromotionManagers
@@ -103,6 +126,9 @@ void PSPromotionManager::pre_scavenge() {
 
   _preserved_marks_set->assert_empty();
   _young_space = heap->young_gen()->to_space();
+  if (_survivor_stripes != NULL) {
+    _survivor_stripes->prepare(_young_space, heap->size_policy());
+  }
 
   for(uint i=0; i<ParallelGCThreads+1; i++) {
     manager_array(i)->reset();
@@ -122,6 +148,9 @@ bool PSPromotionManager::post_scavenge(YoungGCTracer& gc_tracer) {
     }
     manager->flush_labs();
   }
+  if (_survivor_stripes != NULL) {
+    _survivor_stripes->retire(ParallelScavengeHeap::heap()->size_policy());
+  }
   if (!promotion_failure_occurred) {
     // If there was no promotion failure, the preserved mark stacks
     // should be empty.
@@ -183,9 +212,21 @@ PSPromotionManager::reset_stats() {
 }
 #endif // TASKQUEUE_STATS
 
-PSPromotionManager::PSPromotionManager() {
+uint PSPromotionManager::young_lab_count() {
+  return _survivor_stripes != NULL ? _survivor_stripes->nodes() : 1;
+}
+
+size_t PSPromotionManager::survivor_stripes_filler_bytes() {
+  return _survivor_stripes != NULL ? _survivor_stripes->filler_bytes() : 0;
+}
+
+PSPromotionManager::PSPromotionManager()
+  : _partial_array_stepper(ParallelGCThreads) {
   ParallelScavengeHeap* heap = ParallelScavengeHeap::heap();
 
+  _young_labs = new PSYoungPromotionLAB[young_lab_count()];
+  _young_copied_words = NEW_C_HEAP_ARRAY(size_t, young_lab_count(), mtGC);
+
   // We set the old lab's start array.
   _old_lab.set_start_array(old_gen()->start_array());
 
@@ -220,7 +261,10 @@ void PSPromotionManager::reset() {
 
   // Do not prefill the LAB's, save heap wastage!
   HeapWord* lab_base = young_space()->top();
-  _young_lab.initialize(MemRegion(lab_base, (size_t)0));
+  for (uint i = 0; i < young_lab_count(); i++) {
+    _young_labs[i].initialize(MemRegion(lab_base, (size_t)0));
+    _young_copied_words[i] = 0;
+  }
   _young_gen_is_full = false;
 
   lab_base = old_gen()->object_space()->top();
@@ -281,9 +325,15 @@ void PSPromotionManager::flush_labs() {
 
   // If either promotion lab fills up, we can flush the
   // lab but not refill it, so check first.
-  assert(!_young_lab.is_flushed() || _young_gen_is_full, "Sanity");
-  if (!_young_lab.is_flushed())
-    _young_lab.flush();
+  for (uint i = 0; i < young_lab_count(); i++) {
+    assert(!_young_labs[i].is_flushed() || _young_gen_is_full, "Sanity");
+    if (!_young_labs[i].is_flushed())
+      _young_labs[i].flush();
+    if (_survivor_stripes != NULL && _survivor_stripes->is_active()) {
+      _survivor_stripes->add_survived(i, _young_copied_words[i]);
+    }
+    _young_copied_words[i] = 0;
+  }
 
   assert(!_old_lab.is_flushed() || _old_gen_is_full, "Sanity");
   if (!_old_lab.is_flushed())
@@ -310,6 +360,18 @@ template <class T> void PSPromotionManager::process_array_chunk_work(
   }
 }
 
+void PSPromotionManager::process_array_chunk(oop obj, int start, int end) {
+  if (UseCompressedOops) {
+    process_array_chunk_work<narrowOop>(obj, start, end);
+  } else {
+    process_array_chunk_work<oop>(obj, start, end);
+  }
+}
+
+// The partial array tasks refer to the from-space array, whose length is
+// left intact.  The length of the to-space array tracks the chunks claimed
+// so far (see PartialArrayTaskStepper), so other workers can claim chunks of
+// the same array.
 void PSPromotionManager::process_array_chunk(PartialArrayScanTask task) {
   assert(PSChunkLargeArrays, "invariant");
 
@@ -320,28 +382,37 @@ void PSPromotionManager::process_array_chunk(PartialArrayScanTask task) {
   TASKQUEUE_STATS_ONLY(++_array_chunks_processed);
 
   oop const obj = old->forwardee();
+  assert(old != obj, "should not be chunking self-forwarded objects");
 
-  int start;
-  int const end = arrayOop(old)->length();
-  if (end > (int) _min_array_size_for_chunking) {
-    // we'll chunk more
-    start = end - _array_chunk_size;
-    assert(start > 0, "invariant");
-    arrayOop(old)->set_length(start);
+  PartialArrayTaskStepper::Step step =
+    _partial_array_stepper.next(objArrayOop(old), objArrayOop(obj), _array_chunk_size);
+  for (uint i = 0; i < step._ncreate; ++i) {
     push_depth(ScannerTask(PartialArrayScanTask(old)));
-    TASKQUEUE_STATS_ONLY(++_array_chunk_pushes);
-  } else {
-    // this is the final chunk for this array
-    start = 0;
-    int const actual_length = arrayOop(obj)->length();
-    arrayOop(old)->set_length(actual_length);
   }
+  TASKQUEUE_STATS_ONLY(_array_chunk_pushes += step._ncreate);
 
-  if (UseCompressedOops) {
-    process_array_chunk_work<narrowOop>(obj, start, end);
-  } else {
-    process_array_chunk_work<oop>(obj, start, end);
+  // The length of the to-space array is not correct while it is being
+  // chunked; only use the claimed range.
+  process_array_chunk(obj, step._index, step._index + _array_chunk_size);
+}
+
+void PSPromotionManager::push_objArray(oop old_obj, oop new_obj) {
+  assert(PSChunkLargeArrays, "invariant");
+  assert(old_obj->is_objArray(), "invariant");
+  assert(old_obj->forwardee() == new_obj, "invariant");
+  assert(old_obj != new_obj, "should not be chunking self-forwarded objects");
+
+  PartialArrayTaskStepper::Step step =
+    _partial_array_stepper.start(objArrayOop(old_obj), objArrayOop(new_obj), _array_chunk_size);
+
+  // Push the partial array tasks before scanning the initial chunk, so that
+  // other workers can steal them in the meantime.
+  for (uint i = 0; i < step._ncreate; ++i) {
+    push_depth(ScannerTask(PartialArrayScanTask(old_obj)));
   }
+  TASKQUEUE_STATS_ONLY(++_arrays_chunked; _array_chunk_pushes += step._ncreate);
+
+  process_array_chunk(new_obj, 0, step._index);
 }
 
 oop PSPromotionManager::oop_promotion_failed(oop obj, markWord obj_mark) {
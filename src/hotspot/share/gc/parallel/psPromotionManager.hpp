@@ -28,6 +28,7 @@
 #include "gc/parallel/psPromotionLAB.hpp"
 #include "gc/shared/copyFailedInfo.hpp"
 #include "gc/shared/gcTrace.hpp"
+#include "gc/shared/partialArrayTaskStepper.hpp"
 #include "gc/shared/preservedMarks.hpp"
 #include "gc/shared/taskqueue.hpp"
 #include "memory/padded.hpp"
@@ -46,6 +47,7 @@
 //
 
 class MutableSpace;
+class PSNUMASurvivorStripes;
 class PSOldGen;
 class ParCompactionManager;
 
@@ -62,6 +64,7 @@ class PSPromotionManager {
   static PreservedMarksSet*             _preserved_marks_set;
   static PSOldGen*                      _old_gen;
   static MutableSpace*                  _young_space;
+  static PSNUMASurvivorStripes*         _survivor_stripes;
 
 #if TASKQUEUE_STATS
   size_t                              _array_chunk_pushes;
@@ -75,7 +78,12 @@ class PSPromotionManager {
   void reset_stats();
 #endif // TASKQUEUE_STATS
 
-  PSYoungPromotionLAB                 _young_lab;
+  // One young lab per NUMA node if to-space is split into node-local
+  // stripes, otherwise only one.
+  PSYoungPromotionLAB*                _young_labs;
+  // Words copied to to-space through each young lab's node, including
+  // objects allocated directly.
+  size_t*                             _young_copied_words;
   PSOldPromotionLAB                   _old_lab;
   bool                                _young_gen_is_full;
   bool                                _old_gen_is_full;
@@ -88,6 +96,7 @@ class PSPromotionManager {
 
   uint                                _array_chunk_size;
   uint                                _min_array_size_for_chunking;
+  PartialArrayTaskStepper             _partial_array_stepper;
 
   PreservedMarks*                     _preserved_marks;
   PromotionFailedInfo                 _promotion_failed_info;
@@ -96,11 +105,19 @@ class PSPromotionManager {
   static PSOldGen* old_gen()         { return _old_gen; }
   static MutableSpace* young_space() { return _young_space; }
 
+  static uint young_lab_count();
+  inline static uint young_lab_index(oop o);
+  inline static HeapWord* allocate_in_young_space(uint lab_index, size_t word_size);
+
   inline static PSPromotionManager* manager_array(uint index);
 
   template <class T> void  process_array_chunk_work(oop obj,
                                                     int start, int end);
   void process_array_chunk(PartialArrayScanTask task);
+  void process_array_chunk(oop obj, int start, int end);
+  // Start scanning a large object array in chunks that can be stolen by
+  // other workers, and scan the first chunk.
+  void push_objArray(oop old_obj, oop new_obj);
 
   void push_depth(ScannerTask task);
 
@@ -125,6 +142,10 @@ class PSPromotionManager {
 
   static bool steal_depth(int queue_num, ScannerTask& t);
 
+  // Bytes of to-space filled between the NUMA survivor stripes at the last
+  // scavenge, which did not survive.
+  static size_t survivor_stripes_filler_bytes();
+
   PSPromotionManager();
 
   // Accessors
@@ -29,6 +29,7 @@
 
 #include "gc/parallel/parallelScavengeHeap.hpp"
 #include "gc/parallel/parMarkBitMap.inline.hpp"
+#include "gc/parallel/psNUMASurvivorStripes.hpp"
 #include "gc/parallel/psOldGen.hpp"
 #include "gc/parallel/psPromotionLAB.inline.hpp"
 #include "gc/parallel/psScavenge.inline.hpp"
@@ -47,6 +48,20 @@ inline PSPromotionManager* PSPromotionManager::manager_array(uint index) {
   return &_manager_array[index];
 }
 
+inline uint PSPromotionManager::young_lab_index(oop o) {
+  if (_survivor_stripes != NULL && _survivor_stripes->is_active()) {
+    return _survivor_stripes->node_index_for(cast_from_oop<HeapWord*>(o));
+  }
+  return 0;
+}
+
+inline HeapWord* PSPromotionManager::allocate_in_young_space(uint lab_index, size_t word_size) {
+  if (_survivor_stripes != NULL && _survivor_stripes->is_active()) {
+    return _survivor_stripes->cas_allocate(lab_index, word_size);
+  }
+  return young_space()->cas_allocate(word_size);
+}
+
 inline void PSPromotionManager::push_depth(ScannerTask task) {
   claimed_stack_depth()->push(task);
 }
@@ -161,6 +176,8 @@ inline oop PSPromotionManager::copy_unmarked_to_survivor_space(oop o,
   oop new_obj = NULL;
   bool new_obj_is_tenured = false;
   size_t new_obj_size = o->size();
+  PSYoungPromotionLAB* young_lab = NULL;
+  uint lab_index = 0;
 
   // Find the objects age, MT safe.
   uint age = (test_mark.has_displaced_mark_helper() /* o->has_displaced_mark() */) ?
@@ -169,23 +186,25 @@ inline oop PSPromotionManager::copy_unmarked_to_survivor_space(oop o,
   if (!promote_immediately) {
     // Try allocating obj in to-space (unless too old)
     if (age < PSScavenge::tenuring_threshold()) {
-      new_obj = cast_to_oop(_young_lab.allocate(new_obj_size));
+      lab_index = young_lab_index(o);
+      young_lab = &_young_labs[lab_index];
+      new_obj = cast_to_oop(young_lab->allocate(new_obj_size));
       if (new_obj == NULL && !_young_gen_is_full) {
         // Do we allocate directly, or flush and refill?
         if (new_obj_size > (YoungPLABSize / 2)) {
           // Allocate this object directly
-          new_obj = cast_to_oop(young_space()->cas_allocate(new_obj_size));
+          new_obj = cast_to_oop(allocate_in_young_space(lab_index, new_obj_size));
           promotion_trace_event(new_obj, o, new_obj_size, age, false, NULL);
         } else {
           // Flush and fill
-          _young_lab.flush();
+          young_lab->flush();
 
-          HeapWord* lab_base = young_space()->cas_allocate(YoungPLABSize);
+          HeapWord* lab_base = allocate_in_young_space(lab_index, YoungPLABSize);
           if (lab_base != NULL) {
-            _young_lab.initialize(MemRegion(lab_base, YoungPLABSize));
+            young_lab->initialize(MemRegion(lab_base, YoungPLABSize));
             // Try the young lab allocation again.
-            new_obj = cast_to_oop(_young_lab.allocate(new_obj_size));
-            promotion_trace_event(new_obj, o, new_obj_size, age, false, &_young_lab);
+            new_obj = cast_to_oop(young_lab->allocate(new_obj_size));
+            promotion_trace_event(new_obj, o, new_obj_size, age, false, young_lab);
           } else {
             _young_gen_is_full = true;
           }
@@ -264,6 +283,7 @@ inline oop PSPromotionManager::copy_unmarked_to_survivor_space(oop o,
     if (!new_obj_is_tenured) {
       new_obj->incr_age();
       assert(young_space()->contains(new_obj), "Attempt to push non-promoted obj");
+      _young_copied_words[lab_index] += new_obj_size;
     }
 
     log_develop_trace(gc, scavenge)("{%s %s " PTR_FORMAT " -> " PTR_FORMAT " (%d)}",
@@ -279,8 +299,7 @@ inline oop PSPromotionManager::copy_unmarked_to_survivor_space(oop o,
         new_obj->is_objArray() &&
         PSChunkLargeArrays) {
       // we'll chunk it
-      push_depth(ScannerTask(PartialArrayScanTask(o)));
-      TASKQUEUE_STATS_ONLY(++_arrays_chunked; ++_array_chunk_pushes);
+      push_objArray(o, new_obj);
     } else {
       // we'll just push its contents
       push_contents(new_obj);
@@ -302,7 +321,7 @@ inline oop PSPromotionManager::copy_unmarked_to_survivor_space(oop o,
       if (!_old_lab.unallocate_object(cast_from_oop<HeapWord*>(new_obj), new_obj_size)) {
         CollectedHeap::fill_with_object(cast_from_oop<HeapWord*>(new_obj), new_obj_size);
       }
-    } else if (!_young_lab.unallocate_object(cast_from_oop<HeapWord*>(new_obj), new_obj_size)) {
+    } else if (!young_lab->unallocate_object(cast_from_oop<HeapWord*>(new_obj), new_obj_size)) {
       CollectedHeap::fill_with_object(cast_from_oop<HeapWord*>(new_obj), new_obj_size);
     }
     return forwardee;
@@ -286,6 +286,7 @@ class ScavengeRootsTask : public AbstractGangTask {
   HeapWord* _gen_top;
   uint _active_workers;
   bool _is_empty;
+  PSCardStripeClaimer _card_stripes;
   TaskTerminator _terminator;
 
 public:
@@ -300,6 +301,7 @@ public:
       _gen_top(gen_top),
       _active_workers(active_workers),
       _is_empty(is_empty),
+      _card_stripes(),
       _terminator(active_workers, PSPromotionManager::vm_thread_promotion_manager()->stack_array_depth()) {
   }
 
@@ -324,8 +326,8 @@ public:
                                                _old_gen->object_space(),
                                                _gen_top,
                                                pm,
-                                               worker_id,
-                                               _active_workers);
+                                               &_card_stripes,
+                                               worker_id);
 
         // Do the real work
         pm->drain_stacks(false);
@@ -530,7 +532,9 @@ bool PSScavenge::invoke_no_policy() {
       young_gen->from_space()->clear(SpaceDecorator::Mangle);
       young_gen->swap_spaces();
 
-      size_t survived = young_gen->from_space()->used_in_bytes();
+      // The gaps filled between the NUMA survivor stripes did not survive.
+      size_t survived = young_gen->from_space()->used_in_bytes() -
+                        PSPromotionManager::survivor_stripes_filler_bytes();
       size_t promoted = old_gen->used_in_bytes() - pre_gc_values.old_gen_used();
       size_policy->update_averages(_survivor_overflow, survived, promoted);
 
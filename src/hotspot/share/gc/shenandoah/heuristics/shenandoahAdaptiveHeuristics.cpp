@@ -29,10 +29,14 @@
 #include "gc/shenandoah/shenandoahFreeSet.hpp"
 #include "gc/shenandoah/shenandoahHeap.inline.hpp"
 #include "gc/shenandoah/shenandoahHeapRegion.inline.hpp"
+#include "gc/shenandoah/shenandoahPhaseTimings.hpp"
+#include "jfr/jfrEvents.hpp"
 #include "logging/log.hpp"
 #include "logging/logTag.hpp"
 #include "utilities/quickSort.hpp"
 
+#include <math.h>
+
 // These constants are used to adjust the margin of error for the moving
 // average of the allocation rate and cycle time. The units are standard
 // deviations.
@@ -54,6 +58,28 @@ const double ShenandoahAdaptiveHeuristics::HIGHEST_EXPECTED_AVAILABLE_AT_END = 0
 const double ShenandoahAdaptiveHeuristics::MINIMUM_CONFIDENCE = 0.319; // 25%
 const double ShenandoahAdaptiveHeuristics::MAXIMUM_CONFIDENCE = 3.291; // 99.9%
 
+// The phases that make up a concurrent cycle, from the start of the cycle
+// to the point where the collection set is reclaimed. Pauses are counted
+// with their gross times, which include the safepoint synchronization.
+static const ShenandoahPhaseTimings::Phase CYCLE_PHASES[] = {
+  ShenandoahPhaseTimings::conc_reset,
+  ShenandoahPhaseTimings::init_mark_gross,
+  ShenandoahPhaseTimings::conc_mark_roots,
+  ShenandoahPhaseTimings::conc_mark,
+  ShenandoahPhaseTimings::final_mark_gross,
+  ShenandoahPhaseTimings::conc_thread_roots,
+  ShenandoahPhaseTimings::conc_weak_refs,
+  ShenandoahPhaseTimings::conc_weak_roots,
+  ShenandoahPhaseTimings::conc_cleanup_early,
+  ShenandoahPhaseTimings::conc_class_unload,
+  ShenandoahPhaseTimings::conc_strong_roots,
+  ShenandoahPhaseTimings::conc_evac,
+  ShenandoahPhaseTimings::init_update_refs_gross,
+  ShenandoahPhaseTimings::conc_update_refs,
+  ShenandoahPhaseTimings::conc_update_thread_roots,
+  ShenandoahPhaseTimings::final_update_refs_gross,
+};
+
 ShenandoahAdaptiveHeuristics::ShenandoahAdaptiveHeuristics() :
   ShenandoahHeuristics(),
   _margin_of_error_sd(ShenandoahAdaptiveInitialConfidence),
@@ -195,6 +221,67 @@ static double saturate(double value, double min, double max) {
   return MAX2(MIN2(value, max), min);
 }
 
+double ShenandoahAdaptiveHeuristics::normal_cdf(double z) {
+  return 0.5 * erfc(-z / sqrt(2.0));
+}
+
+double ShenandoahAdaptiveHeuristics::normal_quantile(double p) {
+  assert(p > 0.0 && p < 1.0, "Probability out of range: %.3f", p);
+  // Rational approximation from Abramowitz and Stegun, 26.2.23.
+  // The absolute error is below 4.5e-4, plenty for a trigger threshold.
+  double q = (p < 0.5) ? p : (1.0 - p);
+  double t = sqrt(-2.0 * log(q));
+  double x = t - (2.515517 + 0.802853 * t + 0.010328 * t * t) /
+                 (1.0 + 1.432788 * t + 0.189269 * t * t + 0.001308 * t * t * t);
+  return (p < 0.5) ? -x : x;
+}
+
+void ShenandoahAdaptiveHeuristics::predict_cycle_time(double* avg, double* sd) const {
+  ShenandoahPhaseTimings* timings = ShenandoahHeap::heap()->phase_timings();
+
+  // Phase times are treated as independent, so their variances add up.
+  double sum = 0.0;
+  double variance = 0.0;
+  for (size_t i = 0; i < ARRAY_SIZE(CYCLE_PHASES); i++) {
+    const TruncatedSeq& seq = timings->recent(CYCLE_PHASES[i]);
+    if (seq.num() > 0) {
+      sum += seq.davg();
+      variance += seq.dvariance();
+    }
+  }
+
+  // Phase timings do not cover the gaps between phases, so never predict
+  // less than the cycle time measured from end to end.
+  if (sum >= _gc_time_history->davg()) {
+    *avg = sum;
+    *sd = sqrt(variance);
+  } else {
+    *avg = _gc_time_history->davg();
+    *sd = MAX2(sqrt(variance), _gc_time_history->dsd());
+  }
+}
+
+void ShenandoahAdaptiveHeuristics::send_trigger_event(const char* trigger, bool triggered,
+                                                      size_t available, size_t headroom,
+                                                      double rate_avg, double rate_sd,
+                                                      double cycle_avg, double cycle_sd,
+                                                      double confidence, double required_confidence) const {
+  EventShenandoahTriggerDecision event;
+  if (event.should_commit()) {
+    event.set_trigger(trigger);
+    event.set_triggered(triggered);
+    event.set_available(available);
+    event.set_headroom(headroom);
+    event.set_allocationRate(rate_avg);
+    event.set_allocationRateDeviation(rate_sd);
+    event.set_cycleTime(cycle_avg * MILLIUNITS);
+    event.set_cycleTimeDeviation(cycle_sd * MILLIUNITS);
+    event.set_confidence(confidence);
+    event.set_requiredConfidence(required_confidence);
+    event.commit();
+  }
+}
+
 bool ShenandoahAdaptiveHeuristics::should_start_gc() {
   ShenandoahHeap* heap = ShenandoahHeap::heap();
   size_t max_capacity = heap->max_capacity();
@@ -210,11 +297,51 @@ bool ShenandoahAdaptiveHeuristics::should_start_gc() {
   double rate = _allocation_rate.sample(allocated);
   _last_trigger = OTHER;
 
+  // Check if allocation headroom is still okay. This also factors in:
+  //   1. Some space to absorb allocation spikes
+  //   2. Accumulated penalties from Degenerated and Full GC
+  size_t allocation_headroom = available;
+
+  size_t spike_headroom = capacity / 100 * ShenandoahAllocSpikeFactor;
+  size_t penalties      = capacity / 100 * _gc_time_penalties;
+
+  allocation_headroom -= MIN2(allocation_headroom, spike_headroom);
+  allocation_headroom -= MIN2(allocation_headroom, penalties);
+
+  double rate_avg, rate_sd;
+  _allocation_rate.predict(&rate_avg, &rate_sd);
+
+  double cycle_avg, cycle_sd;
+  predict_cycle_time(&cycle_avg, &cycle_sd);
+
+  // The memory allocated during a cycle started now is the product of the
+  // cycle time and the allocation rate. Treating both as independent normal
+  // estimates, the first order approximation of its deviation is below.
+  // The confidence is then the probability that the headroom covers it.
+  double demand = cycle_avg * rate_avg;
+  double demand_sd = sqrt(cycle_avg * cycle_avg * rate_sd * rate_sd +
+                          rate_avg * rate_avg * cycle_sd * cycle_sd);
+  double confidence;
+  if (demand_sd > 0) {
+    confidence = normal_cdf((allocation_headroom - demand) / demand_sd);
+  } else {
+    confidence = (allocation_headroom >= demand) ? 1.0 : 0.0;
+  }
+
+  // Degenerated and Full GCs shift the configured confidence level through
+  // the learned margin of error, successful cycles shift it back.
+  double required_sd = saturate(normal_quantile(ShenandoahAdaptiveTriggerConfidence / 100) +
+                                _margin_of_error_sd - ShenandoahAdaptiveInitialConfidence,
+                                MINIMUM_CONFIDENCE, MAXIMUM_CONFIDENCE);
+  double required_confidence = normal_cdf(required_sd);
+
   size_t min_threshold = capacity / 100 * ShenandoahMinFreeThreshold;
   if (available < min_threshold) {
     log_info(gc)("Trigger: Free (" SIZE_FORMAT "%s) is below minimum threshold (" SIZE_FORMAT "%s)",
                  byte_size_in_proper_unit(available),     proper_unit_for_byte_size(available),
                  byte_size_in_proper_unit(min_threshold), proper_unit_for_byte_size(min_threshold));
+    send_trigger_event("Free", true, available, allocation_headroom, rate_avg, rate_sd,
+                       cycle_avg, cycle_sd, confidence, required_confidence);
     return true;
   }
 
@@ -226,29 +353,20 @@ bool ShenandoahAdaptiveHeuristics::should_start_gc() {
                    _gc_times_learned + 1, max_learn,
                    byte_size_in_proper_unit(available),      proper_unit_for_byte_size(available),
                    byte_size_in_proper_unit(init_threshold), proper_unit_for_byte_size(init_threshold));
+      send_trigger_event("Learning", true, available, allocation_headroom, rate_avg, rate_sd,
+                         cycle_avg, cycle_sd, confidence, required_confidence);
       return true;
     }
   }
 
-  // Check if allocation headroom is still okay. This also factors in:
-  //   1. Some space to absorb allocation spikes
-  //   2. Accumulated penalties from Degenerated and Full GC
-  size_t allocation_headroom = available;
-
-  size_t spike_headroom = capacity / 100 * ShenandoahAllocSpikeFactor;
-  size_t penalties      = capacity / 100 * _gc_time_penalties;
-
-  allocation_headroom -= MIN2(allocation_headroom, spike_headroom);
-  allocation_headroom -= MIN2(allocation_headroom, penalties);
-
-  double avg_cycle_time = _gc_time_history->davg() + (_margin_of_error_sd * _gc_time_history->dsd());
-  double avg_alloc_rate = _allocation_rate.upper_bound(_margin_of_error_sd);
-  if (avg_cycle_time > allocation_headroom / avg_alloc_rate) {
-    log_info(gc)("Trigger: Average GC time (%.2f ms) is above the time for average allocation rate (%.0f %sB/s) to deplete free headroom (" SIZE_FORMAT "%s) (margin of error = %.2f)",
-                 avg_cycle_time * 1000,
-                 byte_size_in_proper_unit(avg_alloc_rate), proper_unit_for_byte_size(avg_alloc_rate),
+  if (confidence < required_confidence) {
+    log_info(gc)("Trigger: Free headroom (" SIZE_FORMAT "%s) lasts until the end of the cycle with %.1f%% confidence, below %.1f%% "
+                 "(cycle time %.2f ms +/- %.2f ms, allocation rate %.0f %sB/s +/- %.0f %sB/s)",
                  byte_size_in_proper_unit(allocation_headroom), proper_unit_for_byte_size(allocation_headroom),
-                 _margin_of_error_sd);
+                 confidence * 100, required_confidence * 100,
+                 cycle_avg * 1000, cycle_sd * 1000,
+                 byte_size_in_proper_unit(rate_avg), proper_unit_for_byte_size(rate_avg),
+                 byte_size_in_proper_unit(rate_sd),  proper_unit_for_byte_size(rate_sd));
 
     log_info(gc, ergo)("Free headroom: " SIZE_FORMAT "%s (free) - " SIZE_FORMAT "%s (spike) - " SIZE_FORMAT "%s (penalties) = " SIZE_FORMAT "%s",
                        byte_size_in_proper_unit(available),           proper_unit_for_byte_size(available),
@@ -256,22 +374,36 @@ bool ShenandoahAdaptiveHeuristics::should_start_gc() {
                        byte_size_in_proper_unit(penalties),           proper_unit_for_byte_size(penalties),
                        byte_size_in_proper_unit(allocation_headroom), proper_unit_for_byte_size(allocation_headroom));
 
+    send_trigger_event("Rate", true, available, allocation_headroom, rate_avg, rate_sd,
+                       cycle_avg, cycle_sd, confidence, required_confidence);
     _last_trigger = RATE;
     return true;
   }
 
+  double cycle_time = cycle_avg + required_sd * cycle_sd;
   bool is_spiking = _allocation_rate.is_spiking(rate, _spike_threshold_sd);
-  if (is_spiking && avg_cycle_time > allocation_headroom / rate) {
-    log_info(gc)("Trigger: Average GC time (%.2f ms) is above the time for instantaneous allocation rate (%.0f %sB/s) to deplete free headroom (" SIZE_FORMAT "%s) (spike threshold = %.2f)",
-                 avg_cycle_time * 1000,
+  if (is_spiking && cycle_time > allocation_headroom / rate) {
+    log_info(gc)("Trigger: Predicted GC time (%.2f ms) is above the time for instantaneous allocation rate (%.0f %sB/s) to deplete free headroom (" SIZE_FORMAT "%s) (spike threshold = %.2f)",
+                 cycle_time * 1000,
                  byte_size_in_proper_unit(rate), proper_unit_for_byte_size(rate),
                  byte_size_in_proper_unit(allocation_headroom), proper_unit_for_byte_size(allocation_headroom),
                  _spike_threshold_sd);
+    send_trigger_event("Spike", true, available, allocation_headroom, rate, rate_sd,
+                       cycle_avg, cycle_sd, confidence, required_confidence);
     _last_trigger = SPIKE;
     return true;
   }
 
-  return ShenandoahHeuristics::should_start_gc();
+  bool should_start = ShenandoahHeuristics::should_start_gc();
+
+  // Decisions not to start a cycle are only reported when the allocation
+  // rate was sampled, to keep the event rate independent of the control
+  // thread polling interval.
+  if (should_start || rate > 0.0) {
+    send_trigger_event(should_start ? "Other" : "None", should_start, available, allocation_headroom,
+                       rate_avg, rate_sd, cycle_avg, cycle_sd, confidence, required_confidence);
+  }
+  return should_start;
 }
 
 void ShenandoahAdaptiveHeuristics::adjust_last_trigger_parameters(double amount) {
@@ -305,7 +437,8 @@ ShenandoahAllocationRate::ShenandoahAllocationRate() :
   _last_sample_value(0),
   _interval_sec(1.0 / ShenandoahAdaptiveSampleFrequencyHz),
   _rate(int(ShenandoahAdaptiveSampleSizeSeconds * ShenandoahAdaptiveSampleFrequencyHz), ShenandoahAdaptiveDecayFactor),
-  _rate_avg(int(ShenandoahAdaptiveSampleSizeSeconds * ShenandoahAdaptiveSampleFrequencyHz), ShenandoahAdaptiveDecayFactor) {
+  _rate_avg(int(ShenandoahAdaptiveSampleSizeSeconds * ShenandoahAdaptiveSampleFrequencyHz), ShenandoahAdaptiveDecayFactor),
+  _rate_short(int(ShenandoahAdaptiveSampleFrequencyHz), ShenandoahAdaptiveDecayFactor) {
 }
 
 double ShenandoahAllocationRate::sample(size_t allocated) {
@@ -316,6 +449,7 @@ double ShenandoahAllocationRate::sample(size_t allocated) {
       rate = instantaneous_rate(now, allocated);
       _rate.add(rate);
       _rate_avg.add(_rate.avg());
+      _rate_short.add(rate);
     }
 
     _last_sample_time = now;
@@ -325,11 +459,27 @@ double ShenandoahAllocationRate::sample(size_t allocated) {
 }
 
 double ShenandoahAllocationRate::upper_bound(double sds) const {
-  // Here we are using the standard deviation of the computed running
-  // average, rather than the standard deviation of the samples that went
-  // into the moving average. This is a much more stable value and is tied
-  // to the actual statistic in use (moving average over samples of averages).
-  return _rate.davg() + (sds * _rate_avg.dsd());
+  double avg, sd;
+  predict(&avg, &sd);
+  return avg + (sds * sd);
+}
+
+void ShenandoahAllocationRate::predict(double* avg, double* sd) const {
+  if (_rate_short.avg() > _rate.davg()) {
+    // Allocation burst: the plain average over the short window reacts to
+    // it before the decaying averages do, which are fed the same samples.
+    // The short window has too few samples for a stable average, so use
+    // the deviation of its samples.
+    *avg = _rate_short.avg();
+    *sd = _rate_short.sd();
+  } else {
+    // Here we are using the standard deviation of the computed running
+    // average, rather than the standard deviation of the samples that went
+    // into the moving average. This is a much more stable value and is tied
+    // to the actual statistic in use (moving average over samples of averages).
+    *avg = _rate.davg();
+    *sd = _rate_avg.dsd();
+  }
 }
 
 void ShenandoahAllocationRate::allocation_counter_reset() {
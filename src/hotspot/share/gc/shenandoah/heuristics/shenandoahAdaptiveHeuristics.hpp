@@ -40,6 +40,10 @@ class ShenandoahAllocationRate : public CHeapObj<mtGC> {
   double upper_bound(double sds) const;
   bool is_spiking(double rate, double threshold) const;
 
+  // Predicts the allocation rate from the time scale that currently
+  // expects the highest rate, so that bursts are not averaged away.
+  void predict(double* avg, double* sd) const;
+
  private:
 
   double instantaneous_rate(double time, size_t allocated) const;
@@ -49,6 +53,10 @@ class ShenandoahAllocationRate : public CHeapObj<mtGC> {
   double _interval_sec;
   TruncatedSeq _rate;
   TruncatedSeq _rate_avg;
+
+  // Samples over the last second only, to catch allocation bursts
+  // before they show up in the longer moving average.
+  TruncatedSeq _rate_short;
 };
 
 class ShenandoahAdaptiveHeuristics : public ShenandoahHeuristics {
@@ -95,6 +103,19 @@ public:
     SPIKE, RATE, OTHER
   };
 
+  static double normal_cdf(double z);
+  static double normal_quantile(double p);
+
+  // Predicts the duration of a concurrent cycle started now, from the
+  // recent history of the cycle phases.
+  void predict_cycle_time(double* avg, double* sd) const;
+
+  void send_trigger_event(const char* trigger, bool triggered,
+                          size_t available, size_t headroom,
+                          double rate_avg, double rate_sd,
+                          double cycle_avg, double cycle_sd,
+                          double confidence, double required_confidence) const;
+
   void adjust_last_trigger_parameters(double amount);
   void adjust_margin_of_error(double amount);
   void adjust_spike_threshold(double amount);
@@ -105,7 +126,8 @@ public:
   // average cycle time and allocation rate. As this value increases we
   // tend to over estimate the rate at which mutators will deplete the
   // heap. In other words, erring on the side of caution will trigger more
-  // concurrent GCs.
+  // concurrent GCs. The learned offset from its initial value is applied
+  // on top of ShenandoahAdaptiveTriggerConfidence.
   double _margin_of_error_sd;
 
   // The allocation spike threshold is expressed in standard deviations.
@@ -94,6 +94,11 @@ void ShenandoahHeuristics::choose_collection_set(ShenandoahCollectionSet* collec
 
   ShenandoahMarkingContext* const ctx = heap->complete_marking_context();
 
+  // Tenured regions hold objects that survived several cycles, and are expected to
+  // stay mostly live. They are only worth evacuating when they have accumulated a
+  // lot of garbage.
+  const size_t tenured_garbage_threshold = ShenandoahHeapRegion::region_size_bytes() * ShenandoahTenuredRegionGarbageThreshold / 100;
+
   for (size_t i = 0; i < num_regions; i++) {
     ShenandoahHeapRegion* region = heap->get_region(i);
 
@@ -109,6 +114,8 @@ void ShenandoahHeuristics::choose_collection_set(ShenandoahCollectionSet* collec
         immediate_regions++;
         immediate_garbage += garbage;
         region->make_trash_immediate();
+      } else if (ShenandoahRegionAging && region->is_tenured() && garbage <= tenured_garbage_threshold) {
+        // Not worth collecting yet.
       } else {
         // This is our candidate for later consideration.
         candidates[cand_idx]._region = region;
@@ -172,6 +179,35 @@ void ShenandoahHeuristics::choose_collection_set(ShenandoahCollectionSet* collec
                      byte_size_in_proper_unit(collection_set->garbage()),
                      proper_unit_for_byte_size(collection_set->garbage()),
                      cset_percent);
+
+  if (ShenandoahRegionAging) {
+    age_regions(collection_set);
+  }
+}
+
+void ShenandoahHeuristics::age_regions(ShenandoahCollectionSet* collection_set) {
+  ShenandoahHeap* heap = ShenandoahHeap::heap();
+
+  size_t aged_regions = 0;
+  size_t tenured_regions = 0;
+
+  for (size_t i = 0; i < heap->num_regions(); i++) {
+    ShenandoahHeapRegion* region = heap->get_region(i);
+    if (!region->is_regular() || collection_set->is_in(region)) {
+      // Evacuated regions are recycled. Their survivors are aged when they
+      // are evacuated, see ShenandoahFreeSet::try_allocate_in().
+      continue;
+    }
+    const bool was_tenured = region->is_tenured();
+    region->increment_age();
+    aged_regions++;
+    if (!was_tenured && region->is_tenured()) {
+      tenured_regions++;
+    }
+  }
+
+  log_info(gc, ergo)("Region Ages: " SIZE_FORMAT " regions aged, " SIZE_FORMAT " newly tenured, "
+                     "survivors evacuated at age %u", aged_regions, tenured_regions, collection_set->survivor_age());
 }
 
 void ShenandoahHeuristics::record_cycle_start() {
@@ -92,6 +92,10 @@ protected:
 
   void adjust_penalty(intx step);
 
+  // Ages the regions that survived the cycle outside of the collection
+  // set. Only used with ShenandoahRegionAging.
+  void age_regions(ShenandoahCollectionSet* collection_set);
+
 public:
   ShenandoahHeuristics();
   virtual ~ShenandoahHeuristics();
@@ -43,6 +43,7 @@ ShenandoahCollectionSet::ShenandoahCollectionSet(ShenandoahHeap* heap, ReservedS
   _garbage(0),
   _used(0),
   _region_count(0),
+  _min_age(0),
   _current_index(0) {
 
   // The collection set map is reserved to cover the entire heap *and* zero addresses.
@@ -87,6 +88,7 @@ void ShenandoahCollectionSet::add_region(ShenandoahHeapRegion* r) {
   _region_count++;
   _garbage += r->garbage();
   _used += r->used();
+  _min_age = (_region_count == 1) ? r->age() : MIN2(_min_age, r->age());
 
   // Update the region status too. State transition would be checked internally.
   r->make_cset();
@@ -106,6 +108,7 @@ void ShenandoahCollectionSet::clear() {
   _used = 0;
 
   _region_count = 0;
+  _min_age = 0;
   _current_index = 0;
 }
 
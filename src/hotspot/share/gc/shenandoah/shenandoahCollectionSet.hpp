@@ -46,6 +46,7 @@ private:
   size_t                _garbage;
   size_t                _used;
   size_t                _region_count;
+  uint                  _min_age;
 
   shenandoah_padding(0);
   volatile size_t       _current_index;
@@ -79,6 +80,10 @@ public:
 
   size_t used()      const { return _used; }
   size_t garbage()   const { return _garbage;   }
+
+  // Age of the objects evacuated from the collection set. They survived
+  // one more cycle than the youngest region they could have come from.
+  uint survivor_age() const { return MIN2(_min_age + 1, (uint)ShenandoahTenuredRegionAge); }
   void clear();
 
 private:
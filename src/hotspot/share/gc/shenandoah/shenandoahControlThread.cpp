@@ -45,6 +45,8 @@
 #include "memory/universe.hpp"
 #include "runtime/atomic.hpp"
 
+#include <math.h>
+
 ShenandoahControlThread::ShenandoahControlThread() :
   ConcurrentGCThread(),
   _alloc_failure_waiters_lock(Mutex::leaf, "ShenandoahAllocFailureGC_lock", true, Monitor::_safepoint_check_always),
@@ -52,7 +54,10 @@ ShenandoahControlThread::ShenandoahControlThread() :
   _periodic_task(this),
   _requested_gc_cause(GCCause::_no_cause_specified),
   _degen_point(ShenandoahGC::_degenerated_outside_cycle),
-  _allocs_seen(0) {
+  _allocs_seen(0),
+  _last_alloc_sample_time(os::elapsedTime()),
+  _last_alloc_sample(0),
+  _alloc_rate_peak(0.0) {
   set_name("Shenandoah Control Thread");
   reset_gc_id();
   create_and_start();
@@ -85,6 +90,7 @@ void ShenandoahControlThread::run_service() {
 
   double last_shrink_time = os::elapsedTime();
   double last_sleep_adjust_time = os::elapsedTime();
+  bool uncommit_pending = false;
 
   // Shrink period avoids constantly polling regions for shrinking.
   // Having a period 10x lower than the delay would mean we hit the
@@ -292,10 +298,15 @@ void ShenandoahControlThread::run_service() {
 
     double current = os::elapsedTime();
 
-    if (ShenandoahUncommit && (explicit_gc_requested || soft_max_changed || (current - last_shrink_time > shrink_period))) {
+    // Rate limited uncommit continues once enough time has passed to uncommit another region
+    bool uncommit_continue = uncommit_pending &&
+      (current - last_shrink_time) * ShenandoahUncommitRate * M >= ShenandoahHeapRegion::region_size_bytes();
+
+    if (ShenandoahUncommit && (explicit_gc_requested || soft_max_changed || uncommit_continue || (current - last_shrink_time > shrink_period))) {
       // Explicit GC tries to uncommit everything down to min capacity.
       // Soft max change tries to uncommit everything down to target capacity.
-      // Periodic uncommit tries to uncommit suitable regions down to min capacity.
+      // Periodic uncommit tries to uncommit suitable regions down to min capacity,
+      // keeping the memory that would be committed ahead, at a limited rate.
 
       double shrink_before = (explicit_gc_requested || soft_max_changed) ?
                              current :
@@ -305,11 +316,23 @@ void ShenandoahControlThread::run_service() {
                              heap->soft_max_capacity() :
                              heap->min_capacity();
 
-      service_uncommit(shrink_before, shrink_until);
+      size_t max_bytes = SIZE_MAX;
+      if (!explicit_gc_requested && !soft_max_changed) {
+        shrink_until = MAX2(shrink_until, MIN2(heap->used() + commit_ahead_bytes(), heap->soft_max_capacity()));
+        if (ShenandoahUncommitRate > 0) {
+          max_bytes = (size_t)((current - last_shrink_time) * ShenandoahUncommitRate * M);
+        }
+      }
+
+      uncommit_pending = service_uncommit(shrink_before, shrink_until, max_bytes);
       heap->phase_timings()->flush_cycle_to_global();
       last_shrink_time = current;
     }
 
+    if (ShenandoahCommitAheadTime > 0) {
+      service_commit(current);
+    }
+
     // Wait before performing the next action. If allocation happened during this wait,
     // we exit sooner, to let heuristics re-evaluate new conditions. If we are at idle,
     // back off exponentially.
@@ -446,14 +469,14 @@ void ShenandoahControlThread::service_stw_degenerated_cycle(GCCause::Cause cause
   heap->shenandoah_policy()->record_success_degenerated();
 }
 
-void ShenandoahControlThread::service_uncommit(double shrink_before, size_t shrink_until) {
+bool ShenandoahControlThread::service_uncommit(double shrink_before, size_t shrink_until, size_t max_bytes) {
   ShenandoahHeap* heap = ShenandoahHeap::heap();
 
   // Determine if there is work to do. This avoids taking heap lock if there is
   // no work available, avoids spamming logs with superfluous logging messages,
   // and minimises the amount of work while locks are taken.
 
-  if (heap->committed() <= shrink_until) return;
+  if (heap->committed() <= shrink_until) return false;
 
   bool has_work = false;
   for (size_t i = 0; i < heap->num_regions(); i++) {
@@ -465,10 +488,38 @@ void ShenandoahControlThread::service_uncommit(double shrink_before, size_t shri
   }
 
   if (has_work) {
-    heap->entry_uncommit(shrink_before, shrink_until);
+    return heap->entry_uncommit(shrink_before, shrink_until, max_bytes);
+  }
+  return false;
+}
+
+void ShenandoahControlThread::service_commit(double current) {
+  // Sample the allocation rate a few times per second. The peak rate decays with
+  // the half-life of ShenandoahUncommitDelay, so that the memory needed before an
+  // idle period is still ready when allocations resume.
+  double elapsed = current - _last_alloc_sample_time;
+  if (elapsed < 0.1) {
+    return;
+  }
+
+  ShenandoahHeap* heap = ShenandoahHeap::heap();
+  size_t allocated = heap->bytes_allocated_since_gc_start();
+  size_t delta = (allocated >= _last_alloc_sample) ? (allocated - _last_alloc_sample) : allocated;
+  double decay = pow(0.5, elapsed * 1000 / MAX2<uintx>(ShenandoahUncommitDelay, 1));
+  _alloc_rate_peak = MAX2(delta / elapsed, _alloc_rate_peak * decay);
+  _last_alloc_sample_time = current;
+  _last_alloc_sample = allocated;
+
+  size_t ready_bytes = commit_ahead_bytes();
+  if (ready_bytes > 0) {
+    heap->commit_ahead(ready_bytes);
   }
 }
 
+size_t ShenandoahControlThread::commit_ahead_bytes() const {
+  return (size_t)(_alloc_rate_peak * ShenandoahCommitAheadTime / 1000);
+}
+
 bool ShenandoahControlThread::is_explicit_gc(GCCause::Cause cause) const {
   return GCCause::is_user_requested_gc(cause) ||
          GCCause::is_serviceability_requested_gc(cause);
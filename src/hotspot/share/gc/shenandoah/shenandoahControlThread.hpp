@@ -92,11 +92,18 @@ private:
   volatile size_t _gc_id;
   shenandoah_padding(2);
 
+  // Allocation rate tracking for committing ahead
+  double _last_alloc_sample_time;
+  size_t _last_alloc_sample;
+  double _alloc_rate_peak;
+
   bool check_cancellation_or_degen(ShenandoahGC::ShenandoahDegenPoint point);
   void service_concurrent_normal_cycle(GCCause::Cause cause);
   void service_stw_full_cycle(GCCause::Cause cause);
   void service_stw_degenerated_cycle(GCCause::Cause cause, ShenandoahGC::ShenandoahDegenPoint point);
-  void service_uncommit(double shrink_before, size_t shrink_until);
+  bool service_uncommit(double shrink_before, size_t shrink_until, size_t max_bytes);
+  void service_commit(double current);
+  size_t commit_ahead_bytes() const;
 
   bool try_set_alloc_failure_gc();
   void notify_alloc_failure_waiters();
@@ -78,16 +78,31 @@ HeapWord* ShenandoahFreeSet::allocate_single(ShenandoahAllocRequest& req, bool&
     case ShenandoahAllocRequest::_alloc_tlab:
     case ShenandoahAllocRequest::_alloc_shared: {
 
-      // Try to allocate in the mutator view
+      // Try to allocate in the mutator view. Uncommitted regions are only used when
+      // no committed region fits, so that the allocation path avoids committing memory.
+      // An empty region fits any request, so remembering the first uncommitted one
+      // is enough.
+      ShenandoahHeapRegion* uncommitted = NULL;
       for (size_t idx = _mutator_leftmost; idx <= _mutator_rightmost; idx++) {
         if (is_mutator_free(idx)) {
-          HeapWord* result = try_allocate_in(_heap->get_region(idx), req, in_new_region);
+          ShenandoahHeapRegion* r = _heap->get_region(idx);
+          if (r->is_empty_uncommitted()) {
+            if (uncommitted == NULL) {
+              uncommitted = r;
+            }
+            continue;
+          }
+          HeapWord* result = try_allocate_in(r, req, in_new_region);
           if (result != NULL) {
             return result;
           }
         }
       }
 
+      if (uncommitted != NULL) {
+        return try_allocate_in(uncommitted, req, in_new_region);
+      }
+
       // There is no recovery. Mutator does not touch collector view at all.
       break;
     }
@@ -179,6 +194,13 @@ HeapWord* ShenandoahFreeSet::try_allocate_in(ShenandoahHeapRegion* r, Shenandoah
     if (req.is_gc_alloc()) {
       r->set_update_watermark(r->top());
     }
+
+    if (ShenandoahRegionAging) {
+      // New objects have age 0, and evacuated objects carry the age of the
+      // collection set. The region is as old as the youngest objects in it.
+      const uint age = req.is_gc_alloc() ? _heap->collection_set()->survivor_age() : 0;
+      r->set_age(in_new_region ? age : MIN2(r->age(), age));
+    }
   }
 
   if (result == NULL || has_no_alloc_capacity(r)) {
@@ -386,6 +408,36 @@ void ShenandoahFreeSet::flip_to_gc(ShenandoahHeapRegion* r) {
   assert_bounds();
 }
 
+bool ShenandoahFreeSet::take_for_commit(ShenandoahHeapRegion* r) {
+  shenandoah_assert_heaplocked();
+  size_t idx = r->index();
+  if (!is_mutator_free(idx) || !r->is_empty_uncommitted()) {
+    return false;
+  }
+
+  _mutator_free_bitmap.clear_bit(idx);
+  _capacity -= alloc_capacity(r);
+
+  if (touches_bounds(idx)) {
+    adjust_bounds();
+  }
+  assert_bounds();
+  return true;
+}
+
+void ShenandoahFreeSet::return_after_commit(ShenandoahHeapRegion* r) {
+  shenandoah_assert_heaplocked();
+  size_t idx = r->index();
+  assert(!is_mutator_free(idx) && !is_collector_free(idx), "Should be taken out of the free set");
+  assert(r->is_empty_committed() || r->is_empty_uncommitted(), "Should be empty");
+
+  _mutator_free_bitmap.set_bit(idx);
+  _mutator_leftmost = MIN2(idx, _mutator_leftmost);
+  _mutator_rightmost = MAX2(idx, _mutator_rightmost);
+  _capacity += alloc_capacity(r);
+  assert_bounds();
+}
+
 void ShenandoahFreeSet::clear() {
   shenandoah_assert_heaplocked();
   clear_internal();
@@ -88,6 +88,12 @@ public:
   }
 
   HeapWord* allocate(ShenandoahAllocRequest& req, bool& in_new_region);
+
+  // Commit ahead support: uncommitted regions are taken out of the mutator
+  // view while their memory is committed, and returned afterwards, also
+  // when committing failed.
+  bool take_for_commit(ShenandoahHeapRegion* r);
+  void return_after_commit(ShenandoahHeapRegion* r);
   size_t unsafe_peek_free() const;
 
   double internal_fragmentation();
@@ -921,6 +921,11 @@ public:
       r->recycle();
     }
 
+    // Compaction mixes objects of all ages
+    if (ShenandoahRegionAging) {
+      r->set_age(0);
+    }
+
     r->set_live_data(live);
     r->reset_alloc_metadata();
     _live += live;
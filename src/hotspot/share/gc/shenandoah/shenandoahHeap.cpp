@@ -715,7 +715,7 @@ bool ShenandoahHeap::is_in(const void* p) const {
   return p >= heap_base && p < last_region_end;
 }
 
-void ShenandoahHeap::op_uncommit(double shrink_before, size_t shrink_until) {
+bool ShenandoahHeap::op_uncommit(double shrink_before, size_t shrink_until, size_t max_bytes) {
   assert (ShenandoahUncommit, "should be enabled");
 
   // Application allocates from the beginning of the heap, and GC allocates at
@@ -724,9 +724,14 @@ void ShenandoahHeap::op_uncommit(double shrink_before, size_t shrink_until) {
   // and therefore can accept the committing costs.
 
   size_t count = 0;
+  bool limited = false;
   for (size_t i = num_regions(); i > 0; i--) { // care about size_t underflow
     ShenandoahHeapRegion* r = get_region(i - 1);
     if (r->is_empty_committed() && (r->empty_time() < shrink_before)) {
+      if ((count + 1) * ShenandoahHeapRegion::region_size_bytes() > max_bytes) {
+        limited = true;
+        break;
+      }
       ShenandoahHeapLocker locker(lock());
       if (r->is_empty_committed()) {
         if (committed() < shrink_until + ShenandoahHeapRegion::region_size_bytes()) {
@@ -743,6 +748,54 @@ void ShenandoahHeap::op_uncommit(double shrink_before, size_t shrink_until) {
   if (count > 0) {
     control_thread()->notify_heap_changed();
   }
+  return limited;
+}
+
+void ShenandoahHeap::commit_ahead(size_t ready_bytes) {
+  assert (ShenandoahCommitAheadTime > 0, "should be enabled");
+
+  // Application allocates from the beginning of the heap, and uncommit works from
+  // the end of it. Commit from the beginning, where the allocations will go next.
+
+  size_t ready = 0;
+  size_t count = 0;
+  for (size_t i = 0; i < num_regions() && ready < ready_bytes; i++) {
+    ShenandoahHeapRegion* r = get_region(i);
+    if (r->is_empty_committed()) {
+      ready += ShenandoahHeapRegion::region_size_bytes();
+    } else if (r->is_empty_uncommitted()) {
+      {
+        ShenandoahHeapLocker locker(lock());
+        if (committed() + ShenandoahHeapRegion::region_size_bytes() > soft_max_capacity()) {
+          break;
+        }
+        if (!_free_set->take_for_commit(r)) {
+          continue;
+        }
+      }
+
+      bool committed = r->precommit();
+
+      {
+        ShenandoahHeapLocker locker(lock());
+        committed = committed && r->make_precommitted();
+        _free_set->return_after_commit(r);
+      }
+
+      if (!committed) {
+        // Out of memory for now, leave the rest to the allocation path
+        log_debug(gc)("Failed to commit region " SIZE_FORMAT " ahead", r->index());
+        break;
+      }
+      ready += ShenandoahHeapRegion::region_size_bytes();
+      count++;
+    }
+  }
+
+  if (count > 0) {
+    log_debug(gc)("Committed ahead " SIZE_FORMAT " regions, " SIZE_FORMAT "%s ready for allocation",
+                  count, byte_size_in_proper_unit(ready), proper_unit_for_byte_size(ready));
+  }
 }
 
 HeapWord* ShenandoahHeap::allocate_from_gclab_slow(Thread* thread, size_t size) {
@@ -2010,9 +2063,9 @@ template<bool CONCURRENT>
 class ShenandoahUpdateHeapRefsTask : public AbstractGangTask {
 private:
   ShenandoahHeap* _heap;
-  ShenandoahRegionIterator* _regions;
+  ShenandoahRegionChunkIterator* _regions;
 public:
-  ShenandoahUpdateHeapRefsTask(ShenandoahRegionIterator* regions) :
+  ShenandoahUpdateHeapRefsTask(ShenandoahRegionChunkIterator* regions) :
     AbstractGangTask("Shenandoah Update References"),
     _heap(ShenandoahHeap::heap()),
     _regions(regions) {
@@ -2033,21 +2086,35 @@ private:
   template<class T>
   void do_work() {
     T cl;
-    ShenandoahHeapRegion* r = _regions->next();
     ShenandoahMarkingContext* const ctx = _heap->complete_marking_context();
-    while (r != NULL) {
+    ShenandoahRegionChunk chunk;
+    while (_regions->next(&chunk)) {
+      ShenandoahHeapRegion* r = chunk._r;
       HeapWord* update_watermark = r->get_update_watermark();
       assert (update_watermark >= r->bottom(), "sanity");
-      if (r->is_active() && !r->is_cset()) {
-        _heap->marked_object_oop_iterate(r, &cl, update_watermark);
+
+      HeapWord* start = r->bottom() + chunk._chunk_offset;
+      HeapWord* end = start + chunk._chunk_size;
+      if (start < update_watermark && r->is_active() && !r->is_cset()) {
+        if (r->is_humongous()) {
+          // Large object arrays are updated chunk by chunk
+          _heap->marked_object_oop_iterate(r, &cl, start, MIN2(end, update_watermark));
+        } else {
+          // Chunks own the objects that start in them. Objects above TAMS can only
+          // be found by walking from TAMS, which the chunk holding TAMS does.
+          HeapWord* tams = ctx->top_at_mark_start(r);
+          if (start <= tams) {
+            HeapWord* limit = (tams < end) ? update_watermark : MIN2(end, update_watermark);
+            _heap->marked_object_oop_iterate(r, &cl, start, limit);
+          }
+        }
       }
-      if (ShenandoahPacing) {
-        _heap->pacer()->report_updaterefs(pointer_delta(update_watermark, r->bottom()));
+      if (ShenandoahPacing && start < update_watermark) {
+        _heap->pacer()->report_updaterefs(pointer_delta(MIN2(end, update_watermark), start));
       }
       if (_heap->check_cancelled_gc_and_yield(CONCURRENT)) {
         return;
       }
-      r = _regions->next();
     }
   }
 };
@@ -2214,12 +2281,12 @@ void ShenandoahHeap::safepoint_synchronize_end() {
   }
 }
 
-void ShenandoahHeap::entry_uncommit(double shrink_before, size_t shrink_until) {
+bool ShenandoahHeap::entry_uncommit(double shrink_before, size_t shrink_until, size_t max_bytes) {
   static const char *msg = "Concurrent uncommit";
   ShenandoahConcurrentPhase gc_phase(msg, ShenandoahPhaseTimings::conc_uncommit, true /* log_heap_usage */);
   EventMark em("%s", msg);
 
-  op_uncommit(shrink_before, shrink_until);
+  return op_uncommit(shrink_before, shrink_until, max_bytes);
 }
 
 void ShenandoahHeap::try_inject_alloc_failure() {
@@ -2275,6 +2342,38 @@ bool ShenandoahRegionIterator::has_next() const {
   return _index < _heap->num_regions();
 }
 
+ShenandoahRegionChunkIterator::ShenandoahRegionChunkIterator(ShenandoahHeap* heap) :
+  _heap(heap),
+  _total_chunks(0),
+  _num_groups(0),
+  _index(0) {}
+
+void ShenandoahRegionChunkIterator::reset() {
+  // Group g takes half of the regions left by the previous groups, and splits
+  // each of them into 2^g chunks. The last group takes all remaining regions.
+  size_t num_regions = _heap->num_regions();
+  size_t max_groups = MIN2(_maximum_groups, (size_t) log2i_exact(ShenandoahHeapRegion::region_size_words()) + 1);
+  size_t first_region = 0;
+  size_t first_chunk = 0;
+  size_t group = 0;
+  while (first_region < num_regions && group < max_groups) {
+    size_t regions = (group + 1 < max_groups) ? MAX2<size_t>((num_regions - first_region) / 2, 1)
+                                              : (num_regions - first_region);
+    _group_first_region[group] = first_region;
+    _group_first_chunk[group] = first_chunk;
+    first_region += regions;
+    first_chunk += regions << group;
+    group++;
+  }
+  _num_groups = group;
+  _total_chunks = first_chunk;
+  _index = 0;
+}
+
+bool ShenandoahRegionChunkIterator::has_next() const {
+  return _index < _total_chunks;
+}
+
 char ShenandoahHeap::gc_state() const {
   return _gc_state.raw_value();
 }
@@ -101,6 +101,50 @@ public:
   bool has_next() const;
 };
 
+// A part of a heap region, handed out by ShenandoahRegionChunkIterator.
+struct ShenandoahRegionChunk {
+  ShenandoahHeapRegion* _r;
+  size_t _chunk_offset;          // in HeapWords
+  size_t _chunk_size;            // in HeapWords
+};
+
+// Hands out chunks of heap regions, so that workers can share the work
+// within a region. Chunks are handed out in groups of decreasing size:
+// the large chunks first keep the claiming overhead low, and the small
+// chunks last make sure the workers finish at about the same time.
+class ShenandoahRegionChunkIterator : public StackObj {
+private:
+  static const size_t _maximum_groups = 6;
+
+  ShenandoahHeap* _heap;
+
+  size_t _total_chunks;
+  size_t _num_groups;
+  size_t _group_first_chunk[_maximum_groups];
+  size_t _group_first_region[_maximum_groups];
+
+  shenandoah_padding(0);
+  volatile size_t _index;
+  shenandoah_padding(1);
+
+  // No implicit copying: iterators should be passed by reference to capture the state
+  NONCOPYABLE(ShenandoahRegionChunkIterator);
+
+public:
+  ShenandoahRegionChunkIterator(ShenandoahHeap* heap);
+
+  // Reset iterator to default state, sizing the groups for the current heap
+  void reset();
+
+  // Fills in the next chunk, or returns false if there are no more chunks.
+  // This is multi-thread-safe.
+  inline bool next(ShenandoahRegionChunk* chunk);
+
+  // This is *not* MT safe. However, in the absence of multithreaded access, it
+  // can be used to determine if there is more work to do.
+  bool has_next() const;
+};
+
 class ShenandoahHeapRegionClosure : public StackObj {
 public:
   virtual void heap_region_do(ShenandoahHeapRegion* r) = 0;
@@ -226,7 +270,7 @@ private:
   bool      _heap_region_special;
   size_t    _num_regions;
   ShenandoahHeapRegion** _regions;
-  ShenandoahRegionIterator _update_refs_iterator;
+  ShenandoahRegionChunkIterator _update_refs_iterator;
 
 public:
 
@@ -344,8 +388,11 @@ public:
 
 public:
   // Elastic heap support
-  void entry_uncommit(double shrink_before, size_t shrink_until);
-  void op_uncommit(double shrink_before, size_t shrink_until);
+  bool entry_uncommit(double shrink_before, size_t shrink_until, size_t max_bytes);
+  bool op_uncommit(double shrink_before, size_t shrink_until, size_t max_bytes);
+
+  // Commits and pretouches empty regions until this many bytes are ready for allocation
+  void commit_ahead(size_t ready_bytes);
 
 private:
   // GC support
@@ -577,9 +624,19 @@ public:
   template<class T>
   inline void marked_object_iterate(ShenandoahHeapRegion* region, T* cl, HeapWord* limit);
 
+  // Visits the marked objects that start in [start, limit). Objects above TAMS
+  // can only be found by walking from TAMS, and are visited only when start
+  // is not above TAMS.
+  template<class T>
+  inline void marked_object_iterate(ShenandoahHeapRegion* region, T* cl, HeapWord* start, HeapWord* limit);
+
   template<class T>
   inline void marked_object_oop_iterate(ShenandoahHeapRegion* region, T* cl, HeapWord* limit);
 
+  // As above, but for humongous regions only visits the oops in [start, limit).
+  template<class T>
+  inline void marked_object_oop_iterate(ShenandoahHeapRegion* region, T* cl, HeapWord* start, HeapWord* limit);
+
   void reset_mark_bitmap();
 
   // SATB barriers hooks
@@ -60,6 +60,26 @@ inline ShenandoahHeapRegion* ShenandoahRegionIterator::next() {
   return _heap->get_region(new_index - 1);
 }
 
+inline bool ShenandoahRegionChunkIterator::next(ShenandoahRegionChunk* chunk) {
+  size_t index = Atomic::add(&_index, (size_t) 1, memory_order_relaxed) - 1;
+  if (index >= _total_chunks) {
+    return false;
+  }
+
+  // Group g splits each of its regions into 2^g chunks
+  size_t group = 0;
+  while (group + 1 < _num_groups && index >= _group_first_chunk[group + 1]) {
+    group++;
+  }
+  size_t group_index = index - _group_first_chunk[group];
+  size_t chunk_size = ShenandoahHeapRegion::region_size_words() >> group;
+
+  chunk->_r = _heap->get_region(_group_first_region[group] + (group_index >> group));
+  chunk->_chunk_offset = (group_index & right_n_bits(group)) * chunk_size;
+  chunk->_chunk_size = chunk_size;
+  return true;
+}
+
 inline bool ShenandoahHeap::has_forwarded_objects() const {
   return _gc_state.is_set(HAS_FORWARDED);
 }
@@ -419,7 +439,13 @@ inline void ShenandoahHeap::marked_object_iterate(ShenandoahHeapRegion* region,
 
 template<class T>
 inline void ShenandoahHeap::marked_object_iterate(ShenandoahHeapRegion* region, T* cl, HeapWord* limit) {
+  marked_object_iterate(region, cl, region->bottom(), limit);
+}
+
+template<class T>
+inline void ShenandoahHeap::marked_object_iterate(ShenandoahHeapRegion* region, T* cl, HeapWord* start, HeapWord* limit) {
   assert(! region->is_humongous_continuation(), "no humongous continuation regions here");
+  assert(region->bottom() <= start && start <= region->end(), "start within the region");
 
   ShenandoahMarkingContext* const ctx = complete_marking_context();
   assert(ctx->is_complete(), "sanity");
@@ -427,7 +453,6 @@ inline void ShenandoahHeap::marked_object_iterate(ShenandoahHeapRegion* region,
   HeapWord* tams = ctx->top_at_mark_start(region);
 
   size_t skip_bitmap_delta = 1;
-  HeapWord* start = region->bottom();
   HeapWord* end = MIN2(tams, region->end());
 
   // Step 1. Scan below the TAMS based on bitmap data.
@@ -435,7 +460,7 @@ inline void ShenandoahHeap::marked_object_iterate(ShenandoahHeapRegion* region,
 
   // Try to scan the initial candidate. If the candidate is above the TAMS, it would
   // fail the subsequent "< limit_bitmap" checks, and fall through to Step 2.
-  HeapWord* cb = ctx->get_next_marked_addr(start, end);
+  HeapWord* cb = (start < end) ? ctx->get_next_marked_addr(start, end) : end;
 
   intx dist = ShenandoahMarkScanPrefetch;
   if (dist > 0) {
@@ -493,7 +518,7 @@ inline void ShenandoahHeap::marked_object_iterate(ShenandoahHeapRegion* region,
   // Step 2. Accurate size-based traversal, happens past the TAMS.
   // This restarts the scan at TAMS, which makes sure we traverse all objects,
   // regardless of what happened at Step 1.
-  HeapWord* cs = tams;
+  HeapWord* cs = (start <= tams) ? tams : limit;
   while (cs < limit) {
     assert (cs >= tams, "only objects past TAMS here: "   PTR_FORMAT " (" PTR_FORMAT ")", p2i(cs), p2i(tams));
     assert (cs < limit, "only objects below limit here: " PTR_FORMAT " (" PTR_FORMAT ")", p2i(cs), p2i(limit));
@@ -532,16 +557,20 @@ public:
 
 template<class T>
 inline void ShenandoahHeap::marked_object_oop_iterate(ShenandoahHeapRegion* region, T* cl, HeapWord* top) {
+  marked_object_oop_iterate(region, cl, region->bottom(), top);
+}
+
+template<class T>
+inline void ShenandoahHeap::marked_object_oop_iterate(ShenandoahHeapRegion* region, T* cl, HeapWord* start, HeapWord* top) {
   if (region->is_humongous()) {
-    HeapWord* bottom = region->bottom();
-    if (top > bottom) {
+    if (top > start) {
       region = region->humongous_start_region();
-      ShenandoahObjectToOopBoundedClosure<T> objs(cl, bottom, top);
+      ShenandoahObjectToOopBoundedClosure<T> objs(cl, start, top);
       marked_object_iterate(region, &objs);
     }
   } else {
     ShenandoahObjectToOopClosure<T> objs(cl);
-    marked_object_iterate(region, &objs, top);
+    marked_object_iterate(region, &objs, start, top);
   }
 }
 
@@ -29,6 +29,7 @@
 #include "gc/shenandoah/shenandoahHeap.inline.hpp"
 #include "gc/shenandoah/shenandoahHeapRegion.hpp"
 #include "gc/shenandoah/shenandoahMarkingContext.inline.hpp"
+#include "gc/shenandoah/shenandoahUtils.hpp"
 #include "jfr/jfrEvents.hpp"
 #include "memory/allocation.hpp"
 #include "memory/iterator.inline.hpp"
@@ -62,6 +63,7 @@ ShenandoahHeapRegion::ShenandoahHeapRegion(HeapWord* start, size_t index, bool c
   _new_top(NULL),
   _empty_time(os::elapsedTime()),
   _state(committed ? _empty_committed : _empty_uncommitted),
+  _age(0),
   _top(start),
   _tlab_allocs(0),
   _gclab_allocs(0),
@@ -302,6 +304,45 @@ void ShenandoahHeapRegion::make_committed_bypass() {
   }
 }
 
+bool ShenandoahHeapRegion::precommit() {
+  shenandoah_assert_not_heaplocked();
+  assert(is_empty_uncommitted(), "Only uncommitted regions: " SIZE_FORMAT, index());
+
+  // Committing ahead is speculative. Failing to commit is not an error, the
+  // allocation path commits the region when it is actually needed.
+  ShenandoahHeap* heap = ShenandoahHeap::heap();
+  if (!heap->is_heap_region_special() && !os::commit_memory((char *) bottom(), RegionSizeBytes, false)) {
+    return false;
+  }
+  // Take the page faults here, rather than on the allocation path
+  os::pretouch_memory(bottom(), end(), AlwaysPreTouch ? heap->pretouch_heap_page_size() : os::vm_page_size());
+  return true;
+}
+
+bool ShenandoahHeapRegion::make_precommitted() {
+  shenandoah_assert_heaplocked();
+
+  switch (_state) {
+    case _empty_uncommitted: {
+      ShenandoahHeap* heap = ShenandoahHeap::heap();
+      if (!heap->commit_bitmap_slice(this)) {
+        // Leave the region uncommitted
+        if (!heap->is_heap_region_special()) {
+          os::uncommit_memory((char *) bottom(), RegionSizeBytes);
+        }
+        return false;
+      }
+      heap->increase_committed(ShenandoahHeapRegion::region_size_bytes());
+      set_state(_empty_committed);
+      _empty_time = os::elapsedTime();
+      return true;
+    }
+    default:
+      report_illegal_transition("precommit");
+      return false;
+  }
+}
+
 void ShenandoahHeapRegion::reset_alloc_metadata() {
   _tlab_allocs = 0;
   _gclab_allocs = 0;
@@ -374,6 +415,9 @@ void ShenandoahHeapRegion::print_on(outputStream* st) const {
   st->print("|S " SIZE_FORMAT_W(5) "%1s", byte_size_in_proper_unit(get_shared_allocs()),   proper_unit_for_byte_size(get_shared_allocs()));
   st->print("|L " SIZE_FORMAT_W(5) "%1s", byte_size_in_proper_unit(get_live_data_bytes()), proper_unit_for_byte_size(get_live_data_bytes()));
   st->print("|CP " SIZE_FORMAT_W(3), pin_count());
+  if (ShenandoahRegionAging) {
+    st->print("|AGE " UINT32_FORMAT_W(2), _age);
+  }
   st->cr();
 }
 
@@ -656,6 +700,19 @@ void ShenandoahHeapRegion::do_uncommit() {
   heap->decrease_committed(ShenandoahHeapRegion::region_size_bytes());
 }
 
+void ShenandoahHeapRegion::set_age(uint age) {
+  shenandoah_assert_heaplocked();
+  assert(age <= ShenandoahTenuredRegionAge, "Invalid age: %u", age);
+  _age = age;
+}
+
+void ShenandoahHeapRegion::increment_age() {
+  shenandoah_assert_safepoint();
+  if (_age < ShenandoahTenuredRegionAge) {
+    _age++;
+  }
+}
+
 void ShenandoahHeapRegion::set_state(RegionState to) {
   EventShenandoahHeapRegionStateChange evt;
   if (evt.should_commit()){
@@ -666,6 +723,12 @@ void ShenandoahHeapRegion::set_state(RegionState to) {
     evt.set_to(to);
     evt.commit();
   }
+
+  // Empty regions hold no objects, and start over at age 0
+  if (to == _empty_committed || to == _empty_uncommitted) {
+    _age = 0;
+  }
+
   _state = to;
 }
 
@@ -183,6 +183,12 @@ public:
   void make_uncommitted();
   void make_committed_bypass();
 
+  // Commit ahead support: the memory is committed and pretouched without
+  // holding the heap lock, while the region is kept out of the free set.
+  // Both return false if committing failed, leaving the region uncommitted.
+  bool precommit();
+  bool make_precommitted();
+
   // Individual states:
   bool is_empty_uncommitted()      const { return _state == _empty_uncommitted; }
   bool is_empty_committed()        const { return _state == _empty_committed; }
@@ -210,6 +216,14 @@ public:
   void record_unpin();
   size_t pin_count() const;
 
+  // Region ages. The age of a region is the number of GC cycles that the
+  // youngest objects in it survived, up to ShenandoahTenuredRegionAge.
+  // Only maintained with ShenandoahRegionAging.
+  uint age()                       const { return _age; }
+  bool is_tenured()                const { return _age >= ShenandoahTenuredRegionAge; }
+  void set_age(uint age);
+  void increment_age();
+
 private:
   static size_t RegionCount;
   static size_t RegionSizeBytes;
@@ -234,6 +248,7 @@ private:
 
   // Seldom updated fields
   RegionState _state;
+  uint _age;
 
   // Frequently updated fields
   HeapWord* _top;
@@ -214,9 +214,17 @@ void ShenandoahPhaseTimings::flush_par_workers_to_cycle() {
 }
 
 void ShenandoahPhaseTimings::flush_cycle_to_global() {
+  // Degenerated and Full GCs cut the concurrent phases short, do not let
+  // them skew the history of concurrent cycles.
+  bool concurrent = _cycle_data[degen_gc_gross] == uninitialized() &&
+                    _cycle_data[full_gc_gross] == uninitialized();
+
   for (uint i = 0; i < _num_phases; i++) {
     if (_cycle_data[i] != uninitialized()) {
       _global_data[i].add(_cycle_data[i]);
+      if (concurrent) {
+        _recent_data[i].add(_cycle_data[i]);
+      }
       _cycle_data[i] = uninitialized();
     }
     if (_worker_data[i] != NULL) {
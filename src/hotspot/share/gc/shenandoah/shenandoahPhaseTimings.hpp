@@ -29,6 +29,7 @@
 #include "gc/shenandoah/shenandoahNumberSeq.hpp"
 #include "gc/shared/workerDataArray.hpp"
 #include "memory/allocation.hpp"
+#include "utilities/numberSeq.hpp"
 
 class ShenandoahCollectorPolicy;
 class outputStream;
@@ -205,6 +206,7 @@ private:
   uint                _max_workers;
   double              _cycle_data[_num_phases];
   HdrSeq              _global_data[_num_phases];
+  TruncatedSeq        _recent_data[_num_phases];
   static const char*  _phase_names[_num_phases];
 
   ShenandoahWorkerData* _worker_data[_num_phases];
@@ -230,6 +232,13 @@ public:
   void flush_par_workers_to_cycle();
   void flush_cycle_to_global();
 
+  // Decaying history of phase times over the last concurrent cycles,
+  // used by heuristics to predict how long a cycle will take.
+  const TruncatedSeq& recent(Phase phase) const {
+    assert(phase >= 0 && phase < _num_phases, "Out of bound");
+    return _recent_data[phase];
+  }
+
   static const char* phase_name(Phase phase) {
     assert(phase >= 0 && phase < _num_phases, "Out of bound");
     return _phase_names[phase];
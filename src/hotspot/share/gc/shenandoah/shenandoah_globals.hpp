@@ -89,6 +89,24 @@
           "collector accepts. In percents of heap region size.")            \
           range(0,100)                                                      \
                                                                             \
+  product(bool, ShenandoahRegionAging, false, EXPERIMENTAL,                 \
+          "Count the GC cycles that the objects in each region survived. "  \
+          "Regions that reached ShenandoahTenuredRegionAge are expected "   \
+          "to stay mostly live, and are only taken for collection when "    \
+          "they have accumulated more garbage. Works with all modes and "   \
+          "heuristics.")                                                    \
+                                                                            \
+  product(uintx, ShenandoahTenuredRegionAge, 4, EXPERIMENTAL,               \
+          "With ShenandoahRegionAging, how many GC cycles the objects in "  \
+          "a region have to survive before the region is tenured.")         \
+          range(1,16)                                                       \
+                                                                            \
+  product(uintx, ShenandoahTenuredRegionGarbageThreshold, 50, EXPERIMENTAL, \
+          "With ShenandoahRegionAging, how much garbage a tenured region "  \
+          "has to contain before it would be taken for collection. In "     \
+          "percents of heap region size.")                                  \
+          range(0,100)                                                      \
+                                                                            \
   product(uintx, ShenandoahInitFreeThreshold, 70, EXPERIMENTAL,             \
           "How much heap should be free before some heuristics trigger the "\
           "initial (learning) cycles. Affects cycle frequency on startup "  \
@@ -149,6 +167,14 @@
           "the heuristic is to allocation spikes. Decreasing this number "  \
           "increases the sensitivity. ")                                    \
                                                                             \
+  product(double, ShenandoahAdaptiveTriggerConfidence, 96.4, EXPERIMENTAL,  \
+          "A cycle is started when the probability that free headroom "     \
+          "lasts until the end of the cycle falls below this level. "       \
+          "Degenerated and Full GCs temporarily raise the level. "          \
+          "Increasing this value will cause the heuristic to initiate "     \
+          "more concurrent cycles. In percents.")                           \
+          range(50.0,99.9)                                                  \
+                                                                            \
   product(double, ShenandoahAdaptiveDecayFactor, 0.5, EXPERIMENTAL,         \
           "The decay factor (alpha) used for values in the weighted "       \
           "moving average of cycle time and allocation rate. "              \
@@ -181,6 +207,20 @@
           "milliseconds. Setting this delay to 0 effectively uncommits "    \
           "regions almost immediately after they become unused.")           \
                                                                             \
+  product(uintx, ShenandoahUncommitRate, 256, EXPERIMENTAL,                 \
+          "Periodic uncommit returns memory at most at this rate, to "      \
+          "spread out the cost of uncommit, and of committing memory back " \
+          "when allocations resume. Explicit GCs and changes of the soft "  \
+          "max heap size are not limited. In megabytes per second. "        \
+          "Setting this to 0 removes the limit.")                           \
+                                                                            \
+  product(uintx, ShenandoahCommitAheadTime, 200, EXPERIMENTAL,              \
+          "Keep enough empty regions committed and pretouched to absorb "   \
+          "this much time of allocations at the recent peak allocation "    \
+          "rate, so that allocations do not have to commit memory. Time "   \
+          "is in milliseconds. Setting this to 0 disables committing "      \
+          "ahead.")                                                         \
+                                                                            \
   product(bool, ShenandoahRegionSampling, false, EXPERIMENTAL,              \
           "Provide heap region sampling data via jvmstat.")                 \
                                                                             \
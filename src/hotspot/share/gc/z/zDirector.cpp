@@ -28,11 +28,16 @@
 #include "gc/z/zHeap.inline.hpp"
 #include "gc/z/zHeuristics.hpp"
 #include "gc/z/zStat.hpp"
+#include "jfr/jfrEvents.hpp"
 #include "logging/log.hpp"
 
 constexpr double one_in_1000 = 3.290527;
 constexpr double sample_interval = 1.0 / ZStatAllocRate::sample_hz;
 
+// Number of CPUs available to the GC workers, refreshed once per second
+static double available_cpus = 0.0;
+static uint64_t available_cpus_ticks = 0;
+
 ZDirector::ZDirector(ZDriver* driver) :
     _driver(driver),
     _metronome(ZStatAllocRate::sample_hz) {
@@ -52,6 +57,20 @@ static void sample_allocation_rate() {
                        ZStatAllocRate::sd() / M);
 }
 
+static void sample_available_cpus() {
+  // Sample the number of available CPUs. Reading the container CPU quota
+  // is not free, so this is only done once per second.
+  if (available_cpus_ticks++ % ZStatAllocRate::sample_hz != 0) {
+    return;
+  }
+
+  const double cpus = ZHeuristics::available_cpus();
+  if (cpus != available_cpus) {
+    log_debug(gc, director)("Available CPUs: %.2f", cpus);
+    available_cpus = cpus;
+  }
+}
+
 static ZDriverRequest rule_allocation_stall() {
   // Perform GC if we've observed at least one allocation stall since
   // the last GC started.
@@ -113,14 +132,80 @@ static double estimated_gc_workers(double serial_gc_time, double parallelizable_
   return parallelizable_gc_time / parallelizable_time_until_deadline;
 }
 
+static uint max_gc_workers() {
+  // Workers in excess of the available CPUs would only be throttled, and
+  // cause CPU bursts without shortening the GC cycle.
+  return clamp<uint>(ceil(available_cpus), 1, ConcGCThreads);
+}
+
 static uint discrete_gc_workers(double gc_workers) {
-  return clamp<uint>(ceil(gc_workers), 1, ConcGCThreads);
+  return clamp<uint>(ceil(gc_workers), 1, max_gc_workers());
+}
+
+static double effective_gc_workers(uint gc_workers) {
+  return MIN2((double)gc_workers, available_cpus);
+}
+
+static double conservative_throughput(const AbsSeq& seq) {
+  // Moving average minus ~3.3 sigma, but never less than half the average
+  return MAX2(seq.davg() - (seq.dsd() * one_in_1000), seq.davg() * 0.5);
+}
+
+static double predict_parallelizable_gc_time() {
+  // The parallelizable time is CPU time, independent of the number of
+  // workers. The times are moving averages, we add ~3.3 sigma to account
+  // for the variance.
+  const double parallelizable_gc_time = ZStatCycle::parallelizable_time().davg() + (ZStatCycle::parallelizable_time().dsd() * one_in_1000);
+  if (!ZStatCycle::is_throughput_trustable()) {
+    return parallelizable_gc_time;
+  }
+
+  // Predict the time needed to mark and relocate from the measured throughput
+  // and the amount of live and relocated memory in the last GC cycle. This
+  // follows changes in the live set size immediately, instead of slowly
+  // through the moving average of the parallelizable time.
+  const double mark_throughput = conservative_throughput(ZStatCycle::mark_throughput());
+  const double relocate_throughput = conservative_throughput(ZStatCycle::relocate_throughput());
+  const double mark_time = ZStatHeap::live_at_mark_end() / (mark_throughput + 1.0);
+  const double relocate_time = ZStatRelocation::relocate() / (relocate_throughput + 1.0);
+  const double other_time = ZStatCycle::other_parallelizable_time().davg() + (ZStatCycle::other_parallelizable_time().dsd() * one_in_1000);
+
+  log_debug(gc, director)("Predicted Parallelizable GC Time, "
+                          "MarkThroughput: %.1fMB/s, RelocateThroughput: %.1fMB/s, "
+                          "MarkTime: %.3fs, RelocateTime: %.3fs, OtherTime: %.3fs",
+                          mark_throughput / M, relocate_throughput / M,
+                          mark_time, relocate_time, other_time);
+
+  return mark_time + relocate_time + other_time;
+}
+
+static void send_director_decision_event(GCCause::Cause cause,
+                                         uint gc_workers,
+                                         uint last_gc_workers,
+                                         double alloc_rate,
+                                         size_t free,
+                                         double gc_duration,
+                                         double time_until_gc) {
+  EventZDirectorDecision event;
+  if (event.should_commit()) {
+    event.set_cause(cause);
+    event.set_workers(gc_workers);
+    event.set_lastWorkers(last_gc_workers);
+    event.set_availableCPUs(available_cpus);
+    event.set_markThroughput(ZStatCycle::mark_throughput().davg());
+    event.set_relocateThroughput(ZStatCycle::relocate_throughput().davg());
+    event.set_allocationRate(alloc_rate);
+    event.set_free(free);
+    event.set_gcDuration(gc_duration * MILLIUNITS);
+    event.set_timeUntilGC(time_until_gc * MILLIUNITS);
+    event.commit();
+  }
 }
 
 static double select_gc_workers(double serial_gc_time, double parallelizable_gc_time, double alloc_rate_sd_percent, double time_until_oom) {
   // Use all workers until we're warm
   if (!ZStatCycle::is_warm()) {
-    const double not_warm_gc_workers = ConcGCThreads;
+    const double not_warm_gc_workers = max_gc_workers();
     log_debug(gc, director)("Select GC Workers (Not Warm), GCWorkers: %.3f", not_warm_gc_workers);
     return not_warm_gc_workers;
   }
@@ -135,7 +220,7 @@ static double select_gc_workers(double serial_gc_time, double parallelizable_gc_
 
   // More than 15% division from the average is considered unsteady
   if (alloc_rate_sd_percent >= 0.15) {
-    const double half_gc_workers = ConcGCThreads / 2.0;
+    const double half_gc_workers = max_gc_workers() / 2.0;
     const double unsteady_gc_workers = MAX3<double>(gc_workers, last_gc_workers, half_gc_workers);
     log_debug(gc, director)("Select GC Workers (Unsteady), "
                             "AvoidLongGCWorkers: %.3f, AvoidOOMGCWorkers: %.3f, LastGCWorkers: %.3f, HalfGCWorkers: %.3f, GCWorkers: %.3f",
@@ -147,7 +232,8 @@ static double select_gc_workers(double serial_gc_time, double parallelizable_gc_
     // Before decreasing number of GC workers compared to the previous GC cycle, check if the
     // next GC cycle will need to increase it again. If so, use the same number of GC workers
     // that will be needed in the next cycle.
-    const double gc_duration_delta = (parallelizable_gc_time / actual_gc_workers) - (parallelizable_gc_time / last_gc_workers);
+    const double gc_duration_delta = (parallelizable_gc_time / effective_gc_workers(actual_gc_workers)) -
+                                     (parallelizable_gc_time / effective_gc_workers(last_gc_workers));
     const double additional_time_for_allocations = ZStatCycle::time_since_last() - gc_duration_delta - sample_interval;
     const double next_time_until_oom = time_until_oom + additional_time_for_allocations;
     const double next_avoid_oom_gc_workers = estimated_gc_workers(serial_gc_time, parallelizable_gc_time, next_time_until_oom);
@@ -194,19 +280,21 @@ ZDriverRequest rule_allocation_rate_dynamic() {
   const double alloc_rate = (MAX2(alloc_rate_predict, alloc_rate_avg) * ZAllocationSpikeTolerance) + (alloc_rate_sd * one_in_1000) + 1.0;
   const double time_until_oom = (free / alloc_rate) / (1.0 + alloc_rate_sd_percent);
 
-  // Calculate max serial/parallel times of a GC cycle. The times are
-  // moving averages, we add ~3.3 sigma to account for the variance.
+  // Calculate max serial/parallel times of a GC cycle. The serial time is a
+  // moving average, we add ~3.3 sigma to account for the variance.
   const double serial_gc_time = ZStatCycle::serial_time().davg() + (ZStatCycle::serial_time().dsd() * one_in_1000);
-  const double parallelizable_gc_time = ZStatCycle::parallelizable_time().davg() + (ZStatCycle::parallelizable_time().dsd() * one_in_1000);
+  const double parallelizable_gc_time = predict_parallelizable_gc_time();
 
   // Calculate number of GC workers needed to avoid OOM.
   const double gc_workers = select_gc_workers(serial_gc_time, parallelizable_gc_time, alloc_rate_sd_percent, time_until_oom);
 
-  // Convert to a discrete number of GC workers within limits.
+  // Convert to a discrete number of GC workers within limits. If the number
+  // of workers is limited by the available CPUs, the GC cycle will take
+  // longer and is started earlier instead.
   const uint actual_gc_workers = discrete_gc_workers(gc_workers);
 
   // Calculate GC duration given number of GC workers needed.
-  const double actual_gc_duration = serial_gc_time + (parallelizable_gc_time / actual_gc_workers);
+  const double actual_gc_duration = serial_gc_time + (parallelizable_gc_time / effective_gc_workers(actual_gc_workers));
   const uint last_gc_workers = ZStatCycle::last_active_workers();
 
   // Calculate time until GC given the time until OOM and GC duration.
@@ -221,17 +309,20 @@ ZDriverRequest rule_allocation_rate_dynamic() {
                           alloc_rate_sd_percent * 100,
                           free / M,
                           serial_gc_time + parallelizable_gc_time,
-                          serial_gc_time + (parallelizable_gc_time / actual_gc_workers),
+                          actual_gc_duration,
                           time_until_oom,
                           time_until_gc,
                           last_gc_workers,
                           actual_gc_workers);
 
-  if (actual_gc_workers <= last_gc_workers && time_until_gc > 0) {
-    return ZDriverRequest(GCCause::_no_gc, actual_gc_workers);
-  }
+  const GCCause::Cause cause = (actual_gc_workers <= last_gc_workers && time_until_gc > 0)
+                               ? GCCause::_no_gc
+                               : GCCause::_z_allocation_rate;
+
+  send_director_decision_event(cause, actual_gc_workers, last_gc_workers, alloc_rate,
+                               free, actual_gc_duration, time_until_gc);
 
-  return ZDriverRequest(GCCause::_z_allocation_rate, actual_gc_workers);
+  return ZDriverRequest(cause, actual_gc_workers);
 }
 
 static ZDriverRequest rule_allocation_rate_static() {
@@ -392,6 +483,7 @@ void ZDirector::run_service() {
   // Main loop
   while (_metronome.wait_for_tick()) {
     sample_allocation_rate();
+    sample_available_cpus();
     if (!_driver->is_busy()) {
       const ZDriverRequest request = make_gc_decision();
       if (request.cause() != GCCause::_no_gc) {
@@ -449,6 +449,7 @@ void ZDriver::gc(const ZDriverRequest& request) {
   pause_mark_start();
 
   // Phase 2: Concurrent Mark
+  ZStatCycle::at_mark_start();
   concurrent(mark);
 
   // Phase 3: Pause Mark End
@@ -456,6 +457,7 @@ void ZDriver::gc(const ZDriverRequest& request) {
     // Phase 3.5: Concurrent Mark Continue
     concurrent(mark_continue);
   }
+  ZStatCycle::at_mark_end();
 
   // Phase 4: Concurrent Mark Free
   concurrent(mark_free);
@@ -476,7 +478,9 @@ void ZDriver::gc(const ZDriverRequest& request) {
   pause_relocate_start();
 
   // Phase 10: Concurrent Relocate
+  ZStatCycle::at_relocate_start();
   concurrent(relocate);
+  ZStatCycle::at_relocate_end();
 }
 
 void ZDriver::run_service() {
@@ -67,6 +67,14 @@ inline uint8_t ZForwarding::type() const {
   return _page->type();
 }
 
+inline uint8_t ZForwarding::age() const {
+  return _page->age();
+}
+
+inline bool ZForwarding::is_old() const {
+  return _page->is_old();
+}
+
 inline uintptr_t ZForwarding::start() const {
   return _virtual.start();
 }
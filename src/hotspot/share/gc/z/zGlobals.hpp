@@ -56,6 +56,9 @@ const uint8_t     ZPageTypeSmall                = 0;
 const uint8_t     ZPageTypeMedium               = 1;
 const uint8_t     ZPageTypeLarge                = 2;
 
+// Page age, the number of GC cycles a page has survived
+const uint8_t     ZPageAgeMax                   = 15;
+
 // Page size shifts
 const size_t      ZPageSizeSmallShift           = ZGranuleSizeShift;
 extern size_t     ZPageSizeMediumShift;
@@ -361,6 +361,9 @@ void ZHeap::select_relocation_set() {
     }
 
     if (page->is_marked()) {
+      // Page survived this cycle
+      page->inc_age();
+
       // Register live page
       selector.register_live_page(page);
     } else {
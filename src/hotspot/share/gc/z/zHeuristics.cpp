@@ -28,9 +28,13 @@
 #include "gc/z/zGlobals.hpp"
 #include "gc/z/zHeuristics.hpp"
 #include "runtime/globals.hpp"
+#include "runtime/globals_extension.hpp"
 #include "runtime/os.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/powerOfTwo.hpp"
+#ifdef LINUX
+#include "osContainer_linux.hpp"
+#endif
 
 void ZHeuristics::set_medium_page_size() {
   // Set ZPageSizeMedium so that a medium page occupies at most 3.125% of the
@@ -102,3 +106,22 @@ uint ZHeuristics::nconcurrent_workers() {
   //  When in non-dynamic mode, use 12.5% of the active processors.
   return nworkers(UseDynamicNumberOfGCThreads ? 25.0 : 12.5);
 }
+
+double ZHeuristics::available_cpus() {
+  // The amount of CPU time available to the JVM, in number of CPUs. When
+  // running in a container with a CPU quota, this is the quota, which can
+  // be a fraction and is then less than the active processor count. Worker
+  // threads in excess of the quota are throttled rather than running in
+  // parallel.
+  const double ncpus = os::active_processor_count();
+#ifdef LINUX
+  if (FLAG_IS_DEFAULT(ActiveProcessorCount) && OSContainer::is_containerized()) {
+    const int quota = OSContainer::cpu_quota();
+    const int period = OSContainer::cpu_period();
+    if (quota > 0 && period > 0) {
+      return clamp((double)quota / (double)period, 1.0, ncpus);
+    }
+  }
+#endif
+  return ncpus;
+}
@@ -34,6 +34,7 @@
 #include "gc/z/zNMethod.hpp"
 #include "gc/z/zNMethodData.hpp"
 #include "gc/z/zNMethodTable.hpp"
+#include "gc/z/zStat.hpp"
 #include "gc/z/zTask.hpp"
 #include "gc/z/zWorkers.hpp"
 #include "logging/log.hpp"
@@ -45,6 +46,9 @@
 #include "runtime/atomic.hpp"
 #include "utilities/debug.hpp"
 
+static const ZStatSubPhase ZSubPhaseConcurrentClassesUnlinkNMethods("Concurrent Classes Unlink NMethods");
+static const ZStatSubPhase ZSubPhaseConcurrentClassesPurgeNMethods("Concurrent Classes Purge NMethods");
+
 static ZNMethodData* gc_data(const nmethod* nm) {
   return nm->gc_data<ZNMethodData>();
 }
@@ -363,6 +367,7 @@ public:
   }
 
   virtual void work() {
+    ZStatTimer timer(ZSubPhaseConcurrentClassesUnlinkNMethods);
     ICRefillVerifierMark mark(_verifier);
     ZNMethodTable::nmethods_do(&_cl);
   }
@@ -417,6 +422,7 @@ public:
   }
 
   virtual void work() {
+    ZStatTimer timer(ZSubPhaseConcurrentClassesPurgeNMethods);
     ZNMethodTable::nmethods_do(&_cl);
   }
 };
@@ -48,6 +48,7 @@ ZNMethodTableEntry* ZNMethodTable::_table = NULL;
 size_t ZNMethodTable::_size = 0;
 size_t ZNMethodTable::_nregistered = 0;
 size_t ZNMethodTable::_nunregistered = 0;
+size_t ZNMethodTable::_noops = 0;
 ZNMethodTableIteration ZNMethodTable::_iteration;
 ZSafeDeleteNoLock<ZNMethodTableEntry[]> ZNMethodTable::_safe_delete;
 
@@ -186,6 +187,7 @@ void ZNMethodTable::register_nmethod(nmethod* nm) {
     // false the nmethod was already in the table so we do not want
     // to increase number of registered entries in that case.
     _nregistered++;
+    _noops += nm->oops_count();
   }
 }
 
@@ -204,6 +206,7 @@ void ZNMethodTable::unregister_nmethod(nmethod* nm) {
   unregister_entry(_table, _size, nm);
   _nunregistered++;
   _nregistered--;
+  _noops -= nm->oops_count();
 }
 
 void ZNMethodTable::nmethods_do_begin() {
@@ -213,7 +216,7 @@ void ZNMethodTable::nmethods_do_begin() {
   _safe_delete.enable_deferred_delete();
 
   // Prepare iteration
-  _iteration.nmethods_do_begin(_table, _size);
+  _iteration.nmethods_do_begin(_table, _size, _nregistered, _noops);
 }
 
 void ZNMethodTable::nmethods_do_end() {
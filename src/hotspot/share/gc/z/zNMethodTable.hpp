@@ -39,6 +39,7 @@ private:
   static size_t                                  _size;
   static size_t                                  _nregistered;
   static size_t                                  _nunregistered;
+  static size_t                                  _noops;
   static ZNMethodTableIteration                  _iteration;
   static ZSafeDeleteNoLock<ZNMethodTableEntry[]> _safe_delete;
 
@@ -24,53 +24,136 @@
 #include "precompiled.hpp"
 #include "gc/z/zNMethodTableEntry.hpp"
 #include "gc/z/zNMethodTableIteration.hpp"
+#include "gc/z/zThread.inline.hpp"
 #include "memory/iterator.hpp"
 #include "runtime/atomic.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/globalDefinitions.hpp"
 
+ZNMethodTableIterationStripe::ZNMethodTableIterationStripe() :
+    _end(0),
+    _claimed(0) {}
+
+void ZNMethodTableIterationStripe::reset(size_t start, size_t end) {
+  _end = end;
+  _claimed = start;
+}
+
+bool ZNMethodTableIterationStripe::is_claimed() const {
+  return Atomic::load(&_claimed) >= _end;
+}
+
+bool ZNMethodTableIterationStripe::claim(size_t* chunk) {
+  if (is_claimed()) {
+    // Avoid contending on exhausted stripes
+    return false;
+  }
+
+  const size_t claimed = Atomic::fetch_and_add(&_claimed, (size_t)1);
+  if (claimed >= _end) {
+    return false;
+  }
+
+  *chunk = claimed;
+  return true;
+}
+
 ZNMethodTableIteration::ZNMethodTableIteration() :
     _table(NULL),
     _size(0),
-    _claimed(0) {}
+    _chunk_size(0),
+    _nchunks(0),
+    _nstripes(0),
+    _stripes() {}
 
 bool ZNMethodTableIteration::in_progress() const {
   return _table != NULL;
 }
 
-void ZNMethodTableIteration::nmethods_do_begin(ZNMethodTableEntry* table, size_t size) {
+size_t ZNMethodTableIteration::chunk_size(size_t nregistered, size_t noops) const {
+  // Chunks are never smaller than two cache lines, to avoid having
+  // workers share cache lines of the table while iterating.
+  const size_t min_chunk_size = (ZCacheLineSize * 2) / sizeof(ZNMethodTableEntry);
+  if (nregistered == 0 || _size <= min_chunk_size) {
+    return MAX2(_size, min_chunk_size);
+  }
+
+  // Size chunks so that each contains roughly the same amount of work.
+  // Visiting an nmethod (locking, checking and disarming the entry barrier,
+  // etc) is estimated to cost about as much as processing 16 of its oops.
+  // The chunk size in table entries is then derived from the current
+  // table occupancy, since unused entries are cheap to skip.
+  const double nmethod_cost = 16.0;
+  const double chunk_cost = 512.0;
+  const double cost_per_nmethod = nmethod_cost + ((double)noops / nregistered);
+  const double nmethods_per_chunk = MAX2(chunk_cost / cost_per_nmethod, 1.0);
+  const double entries_per_nmethod = (double)_size / nregistered;
+  const size_t chunk_size = (size_t)ceil(nmethods_per_chunk * entries_per_nmethod);
+
+  return clamp(chunk_size, min_chunk_size, _size);
+}
+
+void ZNMethodTableIteration::nmethods_do_begin(ZNMethodTableEntry* table, size_t size, size_t nregistered, size_t noops) {
   assert(!in_progress(), "precondition");
 
   _table = table;
   _size = size;
-  _claimed = 0;
+  _chunk_size = chunk_size(nregistered, noops);
+  _nchunks = (_size + _chunk_size - 1) / _chunk_size;
+  _nstripes = clamp(_nchunks, (size_t)1, nstripes_max);
+
+  // Distribute chunks evenly over the stripes
+  for (size_t i = 0; i < _nstripes; i++) {
+    const size_t start = (_nchunks * i) / _nstripes;
+    const size_t end = (_nchunks * (i + 1)) / _nstripes;
+    _stripes[i].reset(start, end);
+  }
 }
 
 void ZNMethodTableIteration::nmethods_do_end() {
-  assert(_claimed >= _size, "Failed to claim all table entries");
+#ifdef ASSERT
+  for (size_t i = 0; i < _nstripes; i++) {
+    assert(_stripes[i].is_claimed(), "Failed to claim all table entries");
+  }
+#endif
 
   // Finish iteration
   _table = NULL;
 }
 
-void ZNMethodTableIteration::nmethods_do(NMethodClosure* cl) {
-  for (;;) {
-    // Claim table partition. Each partition is currently sized to span
-    // two cache lines. This number is just a guess, but seems to work well.
-    const size_t partition_size = (ZCacheLineSize * 2) / sizeof(ZNMethodTableEntry);
-    const size_t partition_start = MIN2(Atomic::fetch_and_add(&_claimed, partition_size), _size);
-    const size_t partition_end = MIN2(partition_start + partition_size, _size);
-    if (partition_start == partition_end) {
-      // End of table
-      break;
+size_t ZNMethodTableIteration::first_stripe() const {
+  // Workers start in different stripes, to keep them working on
+  // separate parts of the table for as long as possible
+  if (ZThread::has_worker_id()) {
+    return ZThread::worker_id() % _nstripes;
+  }
+
+  return 0;
+}
+
+void ZNMethodTableIteration::chunk_do(size_t chunk, NMethodClosure* cl) {
+  const size_t start = chunk * _chunk_size;
+  const size_t end = MIN2(start + _chunk_size, _size);
+
+  for (size_t i = start; i < end; i++) {
+    const ZNMethodTableEntry entry = _table[i];
+    if (entry.registered()) {
+      cl->do_nmethod(entry.method());
     }
+  }
+}
+
+void ZNMethodTableIteration::nmethods_do(NMethodClosure* cl) {
+  const size_t first = first_stripe();
+
+  for (size_t i = 0; i < _nstripes; i++) {
+    // Claim chunks from our own stripe first, and then
+    // steal chunks from the other stripes
+    ZNMethodTableIterationStripe* const stripe = &_stripes[(first + i) % _nstripes];
 
-    // Process table partition
-    for (size_t i = partition_start; i < partition_end; i++) {
-      const ZNMethodTableEntry entry = _table[i];
-      if (entry.registered()) {
-        cl->do_nmethod(entry.method());
-      }
+    size_t chunk;
+    while (stripe->claim(&chunk)) {
+      chunk_do(chunk, cl);
     }
   }
 }
@@ -29,18 +29,41 @@
 class NMethodClosure;
 class ZNMethodTableEntry;
 
-class ZNMethodTableIteration {
+class ZNMethodTableIterationStripe {
 private:
-  ZNMethodTableEntry*            _table;
-  size_t                         _size;
+  size_t                         _end;
   ZCACHE_ALIGNED volatile size_t _claimed;
 
+public:
+  ZNMethodTableIterationStripe();
+
+  void reset(size_t start, size_t end);
+  bool is_claimed() const;
+  bool claim(size_t* chunk);
+};
+
+class ZNMethodTableIteration {
+private:
+  static const size_t          nstripes_max = 16;
+
+  ZNMethodTableEntry*          _table;
+  size_t                       _size;
+  size_t                       _chunk_size;
+  size_t                       _nchunks;
+  size_t                       _nstripes;
+  ZNMethodTableIterationStripe _stripes[nstripes_max];
+
+  size_t chunk_size(size_t nregistered, size_t noops) const;
+  size_t first_stripe() const;
+
+  void chunk_do(size_t chunk, NMethodClosure* cl);
+
 public:
   ZNMethodTableIteration();
 
   bool in_progress() const;
 
-  void nmethods_do_begin(ZNMethodTableEntry* table, size_t size);
+  void nmethods_do_begin(ZNMethodTableEntry* table, size_t size, size_t nregistered, size_t noops);
   void nmethods_do_end();
   void nmethods_do(NMethodClosure* cl);
 };
@@ -35,6 +35,8 @@ ZPage::ZPage(const ZVirtualMemory& vmem, const ZPhysicalMemory& pmem) :
 ZPage::ZPage(uint8_t type, const ZVirtualMemory& vmem, const ZPhysicalMemory& pmem) :
     _type(type),
     _numa_id((uint8_t)-1),
+    _age(0),
+    _huge(false),
     _seqnum(0),
     _virtual(vmem),
     _top(start()),
@@ -58,6 +60,7 @@ void ZPage::assert_initialized() const {
 }
 
 void ZPage::reset() {
+  _age = 0;
   _seqnum = ZGlobalSeqNum;
   _top = start();
   _livemap.reset();
@@ -90,8 +93,9 @@ ZPage* ZPage::split(uint8_t type, size_t size) {
   _top = start();
   _livemap.resize(object_max_count());
 
-  // Create new page, inherit _seqnum and _last_used
+  // Create new page, inherit _huge, _seqnum and _last_used
   ZPage* const page = new ZPage(type, vmem, pmem);
+  page->_huge = _huge;
   page->_seqnum = _seqnum;
   page->_last_used = _last_used;
   return page;
@@ -119,8 +123,8 @@ ZPage* ZPage::split_committed() {
 }
 
 void ZPage::print_on(outputStream* out) const {
-  out->print_cr(" %-6s  " PTR_FORMAT " " PTR_FORMAT " " PTR_FORMAT " %s%s",
-                type_to_string(), start(), top(), end(),
+  out->print_cr(" %-6s  " PTR_FORMAT " " PTR_FORMAT " " PTR_FORMAT " Age %2u%s%s",
+                type_to_string(), start(), top(), end(), _age,
                 is_allocating()  ? " Allocating"  : "",
                 is_relocatable() ? " Relocatable" : "");
 }
@@ -26,6 +26,7 @@
 
 #include "gc/z/zPage.hpp"
 
+#include "gc/shared/gc_globals.hpp"
 #include "gc/z/zAddress.inline.hpp"
 #include "gc/z/zGlobals.hpp"
 #include "gc/z/zLiveMap.inline.hpp"
@@ -145,6 +146,44 @@ inline uint8_t ZPage::numa_id() {
   return _numa_id;
 }
 
+inline uint8_t ZPage::age() const {
+  return _age;
+}
+
+inline void ZPage::set_age(uint8_t age) {
+  _age = MIN2(age, ZPageAgeMax);
+}
+
+inline void ZPage::lower_age(uint8_t age) {
+  // Relocation target pages can be shared by several worker threads
+  uint8_t prev_age = Atomic::load(&_age);
+  while (age < prev_age) {
+    const uint8_t result = Atomic::cmpxchg(&_age, prev_age, age);
+    if (result == prev_age) {
+      return;
+    }
+    prev_age = result;
+  }
+}
+
+inline void ZPage::inc_age() {
+  if (_age < ZPageAgeMax) {
+    _age++;
+  }
+}
+
+inline bool ZPage::is_old() const {
+  return ZTenuringThreshold > 0 && _age >= ZTenuringThreshold;
+}
+
+inline bool ZPage::is_huge() const {
+  return _huge;
+}
+
+inline void ZPage::set_huge(bool huge) {
+  _huge = huge;
+}
+
 inline bool ZPage::is_allocating() const {
   return _seqnum == ZGlobalSeqNum;
 }
@@ -32,11 +32,13 @@
 #include "gc/z/zPage.inline.hpp"
 #include "gc/z/zPageAllocator.inline.hpp"
 #include "gc/z/zPageCache.hpp"
+#include "gc/z/zPageMagazine.inline.hpp"
 #include "gc/z/zSafeDelete.inline.hpp"
 #include "gc/z/zStat.hpp"
 #include "gc/z/zTask.hpp"
 #include "gc/z/zUncommitter.hpp"
 #include "gc/z/zUnmapper.hpp"
+#include "gc/z/zValue.inline.hpp"
 #include "gc/z/zWorkers.hpp"
 #include "jfr/jfrEvents.hpp"
 #include "logging/log.hpp"
@@ -48,6 +50,7 @@
 
 static const ZStatCounter       ZCounterAllocationRate("Memory", "Allocation Rate", ZStatUnitBytesPerSecond);
 static const ZStatCounter       ZCounterPageCacheFlush("Memory", "Page Cache Flush", ZStatUnitBytesPerSecond);
+static const ZStatCounter       ZCounterPageMagazineHit("Memory", "Page Magazine Hit", ZStatUnitOpsPerSecond);
 static const ZStatCriticalPhase ZCriticalPhaseAllocationStall("Allocation Stall");
 
 enum ZPageAllocationStall {
@@ -133,6 +136,8 @@ ZPageAllocator::ZPageAllocator(ZWorkers* workers,
                                size_t max_capacity) :
     _lock(),
     _cache(),
+    _magazines(),
+    _magazined(0),
     _virtual(max_capacity),
     _physical(max_capacity),
     _min_capacity(min_capacity),
@@ -145,6 +150,7 @@ ZPageAllocator::ZPageAllocator(ZWorkers* workers,
     _used_low(0),
     _reclaimed(0),
     _stalled(),
+    _stalling(false),
     _nstalled(0),
     _satisfied(),
     _unmapper(new ZUnmapper(this)),
@@ -322,16 +328,22 @@ void ZPageAllocator::decrease_capacity(size_t size, bool set_max_capacity) {
 }
 
 void ZPageAllocator::increase_used(size_t size, bool worker_relocation) {
+  // Statistics are updated atomically, since pages are also
+  // allocated and freed through the magazines without the lock.
   if (worker_relocation) {
     // Allocating a page for the purpose of worker relocation has
     // a negative contribution to the number of reclaimed bytes.
-    _reclaimed -= size;
+    Atomic::sub(&_reclaimed, (ssize_t)size);
   }
 
   // Update atomically since we have concurrent readers
   const size_t used = Atomic::add(&_used, size);
-  if (used > _used_high) {
-    _used_high = used;
+  for (size_t used_high = Atomic::load(&_used_high); used > used_high;) {
+    const size_t prev_used_high = Atomic::cmpxchg(&_used_high, used_high, used);
+    if (prev_used_high == used_high) {
+      break;
+    }
+    used_high = prev_used_high;
   }
 }
 
@@ -341,13 +353,17 @@ void ZPageAllocator::decrease_used(size_t size, bool reclaimed) {
   // a page after relocation, and is false when we release a page
   // to undo an allocation.
   if (reclaimed) {
-    _reclaimed += size;
+    Atomic::add(&_reclaimed, (ssize_t)size);
   }
 
   // Update atomically since we have concurrent readers
   const size_t used = Atomic::sub(&_used, size);
-  if (used < _used_low) {
-    _used_low = used;
+  for (size_t used_low = Atomic::load(&_used_low); used < used_low;) {
+    const size_t prev_used_low = Atomic::cmpxchg(&_used_low, used_low, used);
+    if (prev_used_low == used_low) {
+      break;
+    }
+    used_low = prev_used_low;
   }
 }
 
@@ -387,8 +403,104 @@ void ZPageAllocator::destroy_page(ZPage* page) {
 }
 
 bool ZPageAllocator::is_alloc_allowed(size_t size) const {
-  const size_t available = _current_max_capacity - _used - _claimed;
-  return available >= size;
+  // Memory cached in the magazines is not available until the magazines
+  // have been flushed. Pages moving in or out of a magazine are briefly
+  // accounted as both used and magazined, so the sum can temporarily
+  // exceed the current max capacity.
+  const size_t unavailable = Atomic::load(&_used) + Atomic::load(&_claimed) + Atomic::load(&_magazined);
+  return _current_max_capacity >= unavailable &&
+         _current_max_capacity - unavailable >= size;
+}
+
+size_t ZPageAllocator::flush_magazines() {
+  ZList<ZPage> pages;
+  size_t flushed = 0;
+
+  // Flush magazines
+  ZPerCPUIterator<ZPageMagazine> iter(&_magazines);
+  for (ZPageMagazine* magazine; iter.next(&magazine);) {
+    flushed += magazine->flush(&pages);
+  }
+
+  // Cache pages
+  ZListRemoveIterator<ZPage> iter_pages(&pages);
+  for (ZPage* page; iter_pages.next(&page);) {
+    _cache.free_page(page);
+  }
+
+  // Make flushed memory available to allocations
+  Atomic::sub(&_magazined, flushed);
+
+  return flushed;
+}
+
+ZPage* ZPageAllocator::alloc_page_magazine(uint8_t type, ZAllocationFlags flags) {
+  if (ZPageMagazineSize == 0) {
+    // Magazines disabled
+    return NULL;
+  }
+
+  if (type != ZPageTypeSmall || Atomic::load(&_stalling)) {
+    // Only small pages are cached in the magazines, and stalled
+    // allocations should be satisfied before new allocations.
+    return NULL;
+  }
+
+  ZPage* const page = _magazines.addr()->alloc_page();
+  if (page == NULL) {
+    // Magazine empty
+    return NULL;
+  }
+
+  // Update used statistics before releasing the magazined
+  // memory, so that it's never accounted as available.
+  increase_used(page->size(), flags.worker_relocation());
+  Atomic::sub(&_magazined, page->size());
+
+  ZStatInc(ZCounterPageMagazineHit);
+
+  return page;
+}
+
+bool ZPageAllocator::free_page_magazine(ZPage* page, bool reclaimed) {
+  if (ZPageMagazineSize == 0) {
+    // Magazines disabled, avoid touching the shared magazined counter
+    return false;
+  }
+
+  if (page->type() != ZPageTypeSmall || Atomic::load(&_stalling)) {
+    // Only small pages are cached in the magazines, and freed
+    // memory is needed to satisfy stalled allocations.
+    return false;
+  }
+
+  // Set time when last used
+  page->set_last_used();
+
+  // Account the page as magazined before it's inserted into
+  // the magazine, so that it's never accounted as available.
+  Atomic::add(&_magazined, page->size());
+
+  if (!_magazines.addr()->free_page(page)) {
+    // Magazine full
+    Atomic::sub(&_magazined, page->size());
+    return false;
+  }
+
+  // Update used statistics
+  decrease_used(page->size(), reclaimed);
+
+  // An allocation might have stalled after the check above, before it
+  // could see the page in the magazine. Both this thread and the stalling
+  // thread publish their update with a full fence before looking for the
+  // other's update, so at least one of them will find the page.
+  if (Atomic::load(&_stalling)) {
+    ZLocker<ZLock> locker(&_lock);
+    flush_magazines();
+    satisfy_stalled();
+  }
+
+  return true;
 }
 
 bool ZPageAllocator::alloc_page_common_inner(uint8_t type, size_t size, ZList<ZPage>* pages) {
@@ -494,6 +606,13 @@ bool ZPageAllocator::alloc_page_or_stall(ZPageAllocation* allocation) {
       return true;
     }
 
+    // Pages cached in the magazines are not available to the
+    // allocation until they have been flushed into the page cache.
+    if (flush_magazines() > 0 && alloc_page_common(allocation)) {
+      // Success
+      return true;
+    }
+
     // Failed
     if (allocation->flags().non_blocking()) {
       // Don't stall
@@ -502,6 +621,13 @@ bool ZPageAllocator::alloc_page_or_stall(ZPageAllocation* allocation) {
 
     // Enqueue allocation request
     _stalled.insert_last(allocation);
+    update_stalling();
+
+    // Flush any pages freed into the magazines before
+    // the stall became visible, and try satisfy it.
+    if (flush_magazines() > 0) {
+      satisfy_stalled();
+    }
   }
 
   // Stall
@@ -584,6 +710,7 @@ ZPage* ZPageAllocator::alloc_page_finalize(ZPageAllocation* allocation) {
   if (commit_page(page)) {
     // Success
     map_page(page);
+    page->set_huge(_physical.is_huge(page->physical_memory()));
     return page;
   }
 
@@ -595,6 +722,7 @@ ZPage* ZPageAllocator::alloc_page_finalize(ZPageAllocation* allocation) {
 
   if (committed_page != NULL) {
     map_page(committed_page);
+    committed_page->set_huge(_physical.is_huge(committed_page->physical_memory()));
     allocation->pages()->insert_last(committed_page);
   }
 
@@ -624,26 +752,35 @@ void ZPageAllocator::alloc_page_failed(ZPageAllocation* allocation) {
 
 ZPage* ZPageAllocator::alloc_page(uint8_t type, size_t size, ZAllocationFlags flags) {
   EventZPageAllocation event;
+  size_t flushed = 0;
+  size_t committed = 0;
+
+  // Try allocate from the magazine of the current CPU, without taking the lock
+  ZPage* page = alloc_page_magazine(type, flags);
+
+  while (page == NULL) {
+    ZPageAllocation allocation(type, size, flags);
+
+    // Allocate one or more pages from the page cache. If the allocation
+    // succeeds but the returned pages don't cover the complete allocation,
+    // then finalize phase is allowed to allocate the remaining memory
+    // directly from the physical memory manager. Note that this call might
+    // block in a safepoint if the non-blocking flag is not set.
+    if (!alloc_page_or_stall(&allocation)) {
+      // Out of memory
+      return NULL;
+    }
 
-retry:
-  ZPageAllocation allocation(type, size, flags);
-
-  // Allocate one or more pages from the page cache. If the allocation
-  // succeeds but the returned pages don't cover the complete allocation,
-  // then finalize phase is allowed to allocate the remaining memory
-  // directly from the physical memory manager. Note that this call might
-  // block in a safepoint if the non-blocking flag is not set.
-  if (!alloc_page_or_stall(&allocation)) {
-    // Out of memory
-    return NULL;
-  }
+    page = alloc_page_finalize(&allocation);
+    if (page == NULL) {
+      // Failed to commit or map. Clean up and retry, in the hope that
+      // we can still allocate by flushing the page cache (more aggressively).
+      alloc_page_failed(&allocation);
+      continue;
+    }
 
-  ZPage* const page = alloc_page_finalize(&allocation);
-  if (page == NULL) {
-    // Failed to commit or map. Clean up and retry, in the hope that
-    // we can still allocate by flushing the page cache (more aggressively).
-    alloc_page_failed(&allocation);
-    goto retry;
+    flushed = allocation.flushed();
+    committed = allocation.committed();
   }
 
   // Reset page. This updates the page's sequence number and must
@@ -662,7 +799,7 @@ retry:
   }
 
   // Send event
-  event.commit(type, size, allocation.flushed(), allocation.committed(),
+  event.commit(type, size, flushed, committed,
                page->physical_memory().nsegments(), flags.non_blocking());
 
   return page;
@@ -673,6 +810,7 @@ void ZPageAllocator::satisfy_stalled() {
     ZPageAllocation* const allocation = _stalled.first();
     if (allocation == NULL) {
       // Allocation queue is empty
+      update_stalling();
       return;
     }
 
@@ -701,7 +839,18 @@ void ZPageAllocator::free_page_inner(ZPage* page, bool reclaimed) {
   _cache.free_page(page);
 }
 
+void ZPageAllocator::update_stalling() {
+  // The store is followed by a full fence, which pairs with
+  // the fence taken when freeing a page into a magazine.
+  Atomic::release_store_fence(&_stalling, !_stalled.is_empty());
+}
+
 void ZPageAllocator::free_page(ZPage* page, bool reclaimed) {
+  // Try free into the magazine of the current CPU, without taking the lock
+  if (free_page_magazine(page, reclaimed)) {
+    return;
+  }
+
   ZLocker<ZLock> locker(&_lock);
 
   // Free page
@@ -738,6 +887,11 @@ size_t ZPageAllocator::uncommit(uint64_t* timeout) {
     SuspendibleThreadSetJoiner joiner(!ZVerifyViews);
     ZLocker<ZLock> locker(&_lock);
 
+    // Pages cached in the magazines are never uncommitted directly.
+    // Flush them into the page cache, where they expire like any
+    // other cached page.
+    flush_magazines();
+
     // Never uncommit below min capacity. We flush out and uncommit chunks at
     // a time (~0.8% of the max capacity, but at least one granule and at most
     // 256M), in case demand for memory increases while we are uncommitting.
@@ -806,6 +960,11 @@ void ZPageAllocator::pages_do(ZPageClosure* cl) const {
     }
   }
 
+  ZPerCPUConstIterator<ZPageMagazine> iter_magazines(&_magazines);
+  for (const ZPageMagazine* magazine; iter_magazines.next(&magazine);) {
+    magazine->pages_do(cl);
+  }
+
   _cache.pages_do(cl);
 }
 
@@ -830,6 +989,8 @@ void ZPageAllocator::check_out_of_memory() {
     _satisfied.insert_last(allocation);
     allocation->satisfy(ZPageAllocationStallFailed);
   }
+
+  update_stalling();
 }
 
 void ZPageAllocator::threads_do(ThreadClosure* tc) const {
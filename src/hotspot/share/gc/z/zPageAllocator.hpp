@@ -29,8 +29,10 @@
 #include "gc/z/zList.hpp"
 #include "gc/z/zLock.hpp"
 #include "gc/z/zPageCache.hpp"
+#include "gc/z/zPageMagazine.hpp"
 #include "gc/z/zPhysicalMemory.hpp"
 #include "gc/z/zSafeDelete.hpp"
+#include "gc/z/zValue.hpp"
 #include "gc/z/zVirtualMemory.hpp"
 
 class ThreadClosure;
@@ -48,6 +50,8 @@ class ZPageAllocator {
 private:
   mutable ZLock              _lock;
   ZPageCache                 _cache;
+  ZPerCPU<ZPageMagazine>     _magazines;
+  volatile size_t            _magazined;
   ZVirtualMemoryManager      _virtual;
   ZPhysicalMemoryManager     _physical;
   const size_t               _min_capacity;
@@ -56,10 +60,11 @@ private:
   volatile size_t            _capacity;
   volatile size_t            _claimed;
   volatile size_t            _used;
-  size_t                     _used_high;
-  size_t                     _used_low;
-  ssize_t                    _reclaimed;
+  volatile size_t            _used_high;
+  volatile size_t            _used_low;
+  volatile ssize_t           _reclaimed;
   ZList<ZPageAllocation>     _stalled;
+  volatile bool              _stalling;
   volatile uint64_t          _nstalled;
   ZList<ZPageAllocation>     _satisfied;
   ZUnmapper*                 _unmapper;
@@ -85,6 +90,10 @@ private:
 
   bool is_alloc_allowed(size_t size) const;
 
+  size_t flush_magazines();
+  ZPage* alloc_page_magazine(uint8_t type, ZAllocationFlags flags);
+  bool free_page_magazine(ZPage* page, bool reclaimed);
+
   bool alloc_page_common_inner(uint8_t type, size_t size, ZList<ZPage>* pages);
   bool alloc_page_common(ZPageAllocation* allocation);
   bool alloc_page_stall(ZPageAllocation* allocation);
@@ -94,6 +103,7 @@ private:
   void alloc_page_failed(ZPageAllocation* allocation);
 
   void satisfy_stalled();
+  void update_stalling();
 
   void free_page_inner(ZPage* page, bool reclaimed);
 
@@ -23,6 +23,7 @@
 
 #include "precompiled.hpp"
 #include "gc/z/zGlobals.hpp"
+#include "gc/z/zLargePages.inline.hpp"
 #include "gc/z/zList.inline.hpp"
 #include "gc/z/zNUMA.hpp"
 #include "gc/z/zPage.inline.hpp"
@@ -60,12 +61,32 @@ ZPageCache::ZPageCache() :
     _large(),
     _last_commit(0) {}
 
+ZPage* ZPageCache::remove_small_page(ZList<ZPage>* list) {
+  if (ZLargePages::is_transparent()) {
+    // Small pages are the most frequently accessed, so prefer one backed
+    // by transparent huge pages. Only the most recently used pages are
+    // considered, to bound the search and to keep using hot pages.
+    const size_t max_search = 8;
+    size_t searched = 0;
+
+    ZListIterator<ZPage> iter(list);
+    for (ZPage* page; searched < max_search && iter.next(&page); searched++) {
+      if (page->is_huge()) {
+        list->remove(page);
+        return page;
+      }
+    }
+  }
+
+  return list->remove_first();
+}
+
 ZPage* ZPageCache::alloc_small_page() {
   const uint32_t numa_id = ZNUMA::id();
   const uint32_t numa_count = ZNUMA::count();
 
   // Try NUMA local page cache
-  ZPage* const l1_page = _small.get(numa_id).remove_first();
+  ZPage* const l1_page = remove_small_page(_small.addr(numa_id));
   if (l1_page != NULL) {
     ZStatInc(ZCounterPageCacheHitL1);
     return l1_page;
@@ -79,7 +100,7 @@ ZPage* ZPageCache::alloc_small_page() {
       remote_numa_id = 0;
     }
 
-    ZPage* const l2_page = _small.get(remote_numa_id).remove_first();
+    ZPage* const l2_page = remove_small_page(_small.addr(remote_numa_id));
     if (l2_page != NULL) {
       ZStatInc(ZCounterPageCacheHitL2);
       return l2_page;
@@ -37,6 +37,7 @@ private:
   ZList<ZPage>            _large;
   uint64_t                _last_commit;
 
+  ZPage* remove_small_page(ZList<ZPage>* list);
   ZPage* alloc_small_page();
   ZPage* alloc_medium_page();
   ZPage* alloc_large_page(size_t size);
@@ -0,0 +1,62 @@
+/*
+ * Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/z/zList.inline.hpp"
+#include "gc/z/zPage.inline.hpp"
+#include "gc/z/zPageMagazine.inline.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/safepoint.hpp"
+#include "utilities/debug.hpp"
+
+ZPageMagazine::ZPageMagazine() {
+  for (size_t i = 0; i < size_max; i++) {
+    _pages[i] = NULL;
+  }
+}
+
+size_t ZPageMagazine::flush(ZList<ZPage>* to) {
+  size_t flushed = 0;
+
+  for (size_t i = 0; i < size_max; i++) {
+    ZPage* const page = Atomic::xchg(&_pages[i], (ZPage*)NULL);
+    if (page != NULL) {
+      flushed += page->size();
+      to->insert_last(page);
+    }
+  }
+
+  return flushed;
+}
+
+void ZPageMagazine::pages_do(ZPageClosure* cl) const {
+  assert(SafepointSynchronize::is_at_safepoint(), "Should be at safepoint");
+
+  for (size_t i = 0; i < size_max; i++) {
+    ZPage* const page = Atomic::load(&_pages[i]);
+    if (page != NULL) {
+      cl->do_page(page);
+    }
+  }
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_GC_Z_ZPAGEMAGAZINE_HPP
+#define SHARE_GC_Z_ZPAGEMAGAZINE_HPP
+
+#include "gc/z/zList.hpp"
+
+class ZPage;
+class ZPageClosure;
+
+//
+// A page magazine holds a small number of free small pages, and sits in
+// front of the page cache. There is one magazine per CPU. Pages are
+// allocated from, and freed into, a magazine without taking the page
+// allocator lock. Each slot is claimed with an atomic exchange, so any
+// thread can safely flush the magazine of any CPU.
+//
+class ZPageMagazine {
+public:
+  // Upper bound of ZPageMagazineSize
+  static const size_t size_max = 8;
+
+private:
+  ZPage* volatile _pages[size_max];
+
+public:
+  ZPageMagazine();
+
+  ZPage* alloc_page();
+  bool free_page(ZPage* page);
+
+  size_t flush(ZList<ZPage>* to);
+
+  void pages_do(ZPageClosure* cl) const;
+};
+
+#endif // SHARE_GC_Z_ZPAGEMAGAZINE_HPP
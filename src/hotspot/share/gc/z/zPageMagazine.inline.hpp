@@ -0,0 +1,70 @@
+/*
+ * Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_GC_Z_ZPAGEMAGAZINE_INLINE_HPP
+#define SHARE_GC_Z_ZPAGEMAGAZINE_INLINE_HPP
+
+#include "gc/z/zPageMagazine.hpp"
+
+#include "gc/z/zGlobals.hpp"
+#include "gc/z/zPage.inline.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/globals.hpp"
+
+inline ZPage* ZPageMagazine::alloc_page() {
+  for (size_t i = 0; i < ZPageMagazineSize; i++) {
+    if (Atomic::load(&_pages[i]) == NULL) {
+      continue;
+    }
+
+    // Claim page. Can fail if another thread claimed it first.
+    ZPage* const page = Atomic::xchg(&_pages[i], (ZPage*)NULL);
+    if (page != NULL) {
+      return page;
+    }
+  }
+
+  // Magazine empty
+  return NULL;
+}
+
+inline bool ZPageMagazine::free_page(ZPage* page) {
+  assert(page->type() == ZPageTypeSmall, "Invalid page type");
+
+  for (size_t i = 0; i < ZPageMagazineSize; i++) {
+    if (Atomic::load(&_pages[i]) != NULL) {
+      continue;
+    }
+
+    // Install page. Can fail if another thread installed a page first.
+    if (Atomic::cmpxchg(&_pages[i], (ZPage*)NULL, page) == NULL) {
+      return true;
+    }
+  }
+
+  // Magazine full
+  return false;
+}
+
+#endif // SHARE_GC_Z_ZPAGEMAGAZINE_INLINE_HPP
@@ -376,6 +376,17 @@ void ZPhysicalMemoryManager::map_view(uintptr_t addr, const ZPhysicalMemory& pme
   }
 }
 
+void ZPhysicalMemoryManager::collapse_view(uintptr_t addr, const ZPhysicalMemory& pmem) const {
+  size_t size = 0;
+
+  // Collapse segments
+  for (int i = 0; i < pmem.nsegments(); i++) {
+    const ZPhysicalMemorySegment& segment = pmem.segment(i);
+    _backing.collapse(addr + size, segment.size(), segment.start());
+    size += segment.size();
+  }
+}
+
 void ZPhysicalMemoryManager::unmap_view(uintptr_t addr, size_t size) const {
   _backing.unmap(addr, size);
 }
@@ -405,6 +416,12 @@ void ZPhysicalMemoryManager::map(uintptr_t offset, const ZPhysicalMemory& pmem)
     map_view(ZAddress::remapped(offset), pmem);
   }
 
+  if (ZLargePages::is_transparent()) {
+    // Collapse through the good view only, since all views
+    // share the same physical memory
+    collapse_view(ZAddress::good(offset), pmem);
+  }
+
   nmt_commit(offset, size);
 }
 
@@ -422,6 +439,17 @@ void ZPhysicalMemoryManager::unmap(uintptr_t offset, size_t size) const {
   }
 }
 
+bool ZPhysicalMemoryManager::is_huge(const ZPhysicalMemory& pmem) const {
+  for (int i = 0; i < pmem.nsegments(); i++) {
+    const ZPhysicalMemorySegment& segment = pmem.segment(i);
+    if (!_backing.is_huge(segment.start(), segment.size())) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 void ZPhysicalMemoryManager::debug_map(uintptr_t offset, const ZPhysicalMemory& pmem) const {
   // Map good view
   assert(ZVerifyViews, "Should be enabled");
@@ -88,6 +88,7 @@ private:
 
   void pretouch_view(uintptr_t addr, size_t size) const;
   void map_view(uintptr_t addr, const ZPhysicalMemory& pmem) const;
+  void collapse_view(uintptr_t addr, const ZPhysicalMemory& pmem) const;
   void unmap_view(uintptr_t addr, size_t size) const;
 
 public:
@@ -109,6 +110,8 @@ public:
   void map(uintptr_t offset, const ZPhysicalMemory& pmem) const;
   void unmap(uintptr_t offset, size_t size) const;
 
+  bool is_huge(const ZPhysicalMemory& pmem) const;
+
   void debug_map(uintptr_t offset, const ZPhysicalMemory& pmem) const;
   void debug_unmap(uintptr_t offset, size_t size) const;
 };
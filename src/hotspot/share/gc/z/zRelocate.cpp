@@ -132,10 +132,32 @@ static ZPage* alloc_page(const ZForwarding* forwarding) {
     return NULL;
   }
 
+  // Objects in large pages are consolidated into medium pages
+  const bool is_large = forwarding->type() == ZPageTypeLarge;
+  const uint8_t type = is_large ? ZPageTypeMedium : forwarding->type();
+  const size_t size = is_large ? ZPageSizeMedium : forwarding->size();
+
   ZAllocationFlags flags;
   flags.set_non_blocking();
   flags.set_worker_relocation();
-  return ZHeap::heap()->alloc_page(forwarding->type(), forwarding->size(), flags);
+  ZPage* const page = ZHeap::heap()->alloc_page(type, size, flags);
+  if (page != NULL) {
+    // Objects relocated by worker threads keep the age of the page they
+    // were relocated from. The age of a target page is lowered to that of
+    // any other page relocated into it, see ZRelocateClosure.
+    page->set_age(forwarding->age());
+  }
+
+  return page;
+}
+
+// Old and young pages are relocated into separate target pages, so that
+// long-lived objects are compacted together. Objects relocated by mutator
+// threads end up in regular allocation pages, whose age is 0.
+static const uint ZRelocateAgeClasses = 2;
+
+static uint age_class(const ZForwarding* forwarding) {
+  return forwarding->is_old() ? 1 : 0;
 }
 
 static void free_page(ZPage* page) {
@@ -167,7 +189,7 @@ public:
     return page;
   }
 
-  void share_target_page(ZPage* page) {
+  void share_target_page(ZForwarding* forwarding, ZPage* page) {
     // Does nothing
   }
 
@@ -197,55 +219,68 @@ public:
 class ZRelocateMediumAllocator {
 private:
   ZConditionLock      _lock;
-  ZPage*              _shared;
-  bool                _in_place;
+  ZPage*              _shared[ZRelocateAgeClasses];
+  bool                _in_place[ZRelocateAgeClasses];
   volatile size_t     _in_place_count;
+  volatile size_t     _large_in_place_count;
 
 public:
   ZRelocateMediumAllocator() :
       _lock(),
-      _shared(NULL),
-      _in_place(false),
-      _in_place_count(0) {}
+      _shared(),
+      _in_place(),
+      _in_place_count(0),
+      _large_in_place_count(0) {}
 
   ~ZRelocateMediumAllocator() {
-    if (should_free_target_page(_shared)) {
-      free_page(_shared);
+    for (uint i = 0; i < ZRelocateAgeClasses; i++) {
+      if (should_free_target_page(_shared[i])) {
+        free_page(_shared[i]);
+      }
     }
   }
 
   ZPage* alloc_target_page(ZForwarding* forwarding, ZPage* target) {
     ZLocker<ZConditionLock> locker(&_lock);
+    const uint i = age_class(forwarding);
 
     // Wait for any ongoing in-place relocation to complete
-    while (_in_place) {
+    while (_in_place[i]) {
       _lock.wait();
     }
 
     // Allocate a new page only if the shared page is the same as the
-    // current target page. The shared page will be different from the
-    // current target page if another thread shared a page, or allocated
-    // a new page.
-    if (_shared == target) {
-      _shared = alloc_page(forwarding);
-      if (_shared == NULL) {
-        Atomic::inc(&_in_place_count);
-        _in_place = true;
+    // current target page, or if there is no shared page. The shared page
+    // will be different from the current target page if another thread
+    // shared a page, or allocated a new page.
+    if (_shared[i] == target || _shared[i] == NULL) {
+      _shared[i] = alloc_page(forwarding);
+      if (_shared[i] == NULL) {
+        // Large pages consolidated into medium pages are accounted separately
+        if (forwarding->type() == ZPageTypeLarge) {
+          Atomic::inc(&_large_in_place_count);
+        } else {
+          Atomic::inc(&_in_place_count);
+        }
+        _in_place[i] = true;
       }
     }
 
-    return _shared;
+    return _shared[i];
   }
 
-  void share_target_page(ZPage* page) {
+  void share_target_page(ZForwarding* forwarding, ZPage* page) {
     ZLocker<ZConditionLock> locker(&_lock);
+    const uint i = age_class(forwarding);
 
-    assert(_in_place, "Invalid state");
-    assert(_shared == NULL, "Invalid state");
-    assert(page != NULL, "Invalid page");
+    assert(_in_place[i], "Invalid state");
+    assert(_shared[i] == NULL, "Invalid state");
 
-    _shared = page;
-    _in_place = false;
+    // A large page relocated in-place only has room for its own object, and
+    // is not shared. Leaving the shared page NULL makes the next thread that
+    // needs a target page allocate a new one.
+    _shared[i] = page;
+    _in_place[i] = false;
 
     _lock.notify_all();
   }
@@ -269,6 +304,10 @@ public:
   const size_t in_place_count() const {
     return _in_place_count;
   }
+
+  const size_t large_in_place_count() const {
+    return _large_in_place_count;
+  }
 };
 
 template <typename Allocator>
@@ -276,6 +315,7 @@ class ZRelocateClosure : public ObjectClosure {
 private:
   Allocator* const _allocator;
   ZForwarding*     _forwarding;
+  ZPage*           _targets[ZRelocateAgeClasses];
   ZPage*           _target;
 
   bool relocate_object(uintptr_t from_addr) const {
@@ -322,6 +362,8 @@ private:
       // in-place.
       _target = _allocator->alloc_target_page(_forwarding, _target);
       if (_target != NULL) {
+        // The target page might be shared with objects of younger pages
+        _target->lower_age(_forwarding->age());
         continue;
       }
 
@@ -338,15 +380,31 @@ public:
   ZRelocateClosure(Allocator* allocator) :
       _allocator(allocator),
       _forwarding(NULL),
+      _targets(),
       _target(NULL) {}
 
   ~ZRelocateClosure() {
-    _allocator->free_target_page(_target);
+    for (uint i = 0; i < ZRelocateAgeClasses; i++) {
+      _allocator->free_target_page(_targets[i]);
+    }
   }
 
   void do_forwarding(ZForwarding* forwarding) {
     _forwarding = forwarding;
 
+    // Continue with the target page of the age class of this page
+    const uint age_class_index = age_class(forwarding);
+    _target = _targets[age_class_index];
+    if (_target != NULL) {
+      _target->lower_age(forwarding->age());
+    }
+
+    do_forwarding_inner();
+
+    _targets[age_class_index] = _target;
+  }
+
+  void do_forwarding_inner() {
     // Check if we should abort
     if (ZAbort::should_abort()) {
       _forwarding->abort_page();
@@ -365,10 +423,16 @@ public:
     _forwarding->release_page();
 
     if (_forwarding->in_place()) {
+      if (_forwarding->type() == ZPageTypeLarge) {
+        // A large page relocated in-place can not be used as target page
+        // for other objects, since it only has room for a single object.
+        _target = NULL;
+      }
+
       // The relocated page has been relocated in-place and should not
       // be freed. Keep it as target page until it is full, and offer to
       // share it with other worker threads.
-      _allocator->share_target_page(_target);
+      _allocator->share_target_page(_forwarding, _target);
     } else {
       // Detach and free relocated page
       ZPage* const page = _forwarding->detach_page();
@@ -396,7 +460,8 @@ public:
 
   ~ZRelocateTask() {
     ZStatRelocation::set_at_relocate_end(_small_allocator.in_place_count(),
-                                         _medium_allocator.in_place_count());
+                                         _medium_allocator.in_place_count(),
+                                         _medium_allocator.large_in_place_count());
   }
 
   virtual void work() {
@@ -40,6 +40,7 @@ private:
   const size_t                   _nforwardings;
   ZArrayParallelIterator<ZPage*> _small_iter;
   ZArrayParallelIterator<ZPage*> _medium_iter;
+  ZArrayParallelIterator<ZPage*> _large_iter;
   volatile size_t                _small_next;
   volatile size_t                _medium_next;
 
@@ -62,10 +63,11 @@ public:
       ZTask("ZRelocationSetInstallTask"),
       _allocator(allocator),
       _forwardings(NULL),
-      _nforwardings(selector->small()->length() + selector->medium()->length()),
+      _nforwardings(selector->small()->length() + selector->medium()->length() + selector->large()->length()),
       _small_iter(selector->small()),
       _medium_iter(selector->medium()),
-      _small_next(selector->medium()->length()),
+      _large_iter(selector->large()),
+      _small_next(selector->medium()->length() + selector->large()->length()),
       _medium_next(0) {
 
     // Reset the allocator to have room for the relocation
@@ -95,6 +97,13 @@ public:
       ZForwarding* const forwarding = ZForwarding::alloc(_allocator, page);
       install_medium(forwarding);
     }
+
+    // Allocate and install forwardings for large pages. These are relocated
+    // into medium pages, and are installed together with the medium pages.
+    for (ZPage* page; _large_iter.next(&page);) {
+      ZForwarding* const forwarding = ZForwarding::alloc(_allocator, page);
+      install_medium(forwarding);
+    }
   }
 
   ZForwarding** forwardings() const {
@@ -29,6 +29,8 @@
 #include "gc/z/zRelocationSetSelector.inline.hpp"
 #include "jfr/jfrEvents.hpp"
 #include "logging/log.hpp"
+#include "logging/logStream.hpp"
+#include "memory/resourceArea.hpp"
 #include "runtime/globals.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/powerOfTwo.hpp"
@@ -38,7 +40,9 @@ ZRelocationSetSelectorGroupStats::ZRelocationSetSelectorGroupStats() :
     _total(0),
     _live(0),
     _empty(0),
-    _relocate(0) {}
+    _relocate(0),
+    _old_npages(0),
+    _old_live(0) {}
 
 ZRelocationSetSelectorGroup::ZRelocationSetSelectorGroup(const char* name,
                                                          uint8_t page_type,
@@ -49,9 +53,11 @@ ZRelocationSetSelectorGroup::ZRelocationSetSelectorGroup(const char* name,
     _page_size(page_size),
     _object_size_limit(object_size_limit),
     _fragmentation_limit(page_size * (ZFragmentationLimit / 100)),
+    _old_fragmentation_limit(page_size * (ZOldFragmentationLimit / 100)),
     _live_pages(),
     _forwarding_entries(0),
-    _stats() {}
+    _stats(),
+    _live_histogram() {}
 
 bool ZRelocationSetSelectorGroup::is_disabled() {
   // Medium pages are disabled when their page size is zero
@@ -59,8 +65,24 @@ bool ZRelocationSetSelectorGroup::is_disabled() {
 }
 
 bool ZRelocationSetSelectorGroup::is_selectable() {
-  // Large pages are not selectable
-  return _page_type != ZPageTypeLarge;
+  // Large pages are only selectable if they should be consolidated
+  // into medium pages
+  return _page_type != ZPageTypeLarge || (ZCompactLargePages && ZPageSizeMedium != 0);
+}
+
+void ZRelocationSetSelectorGroup::print_live_histogram() const {
+  LogTarget(Debug, gc, reloc) lt;
+  if (!lt.is_enabled()) {
+    return;
+  }
+
+  ResourceMark rm;
+  LogStream ls(lt);
+  ls.print("%s Pages Live Histogram:", _name);
+  for (size_t i = 0; i < nhistogram_buckets; i++) {
+    ls.print(" " SIZE_FORMAT, _live_histogram[i]);
+  }
+  ls.cr();
 }
 
 void ZRelocationSetSelectorGroup::semi_sort() {
@@ -116,6 +138,17 @@ void ZRelocationSetSelectorGroup::select_inner() {
   size_t from_live_bytes = 0;
   size_t from_forwarding_entries = 0;
 
+  // The garbage in non-empty pages of this group, and how much of it may
+  // remain after relocation without exceeding the fragmentation limit.
+  const size_t total = _stats._total - _stats._empty;
+  const size_t garbage = total - _stats._live;
+  const size_t garbage_goal = total * (ZFragmentationLimit / 100);
+  bool goal_met = garbage <= garbage_goal;
+  int goal_from = 0;
+  int goal_to = 0;
+  size_t goal_live_bytes = 0;
+  size_t goal_forwarding_entries = 0;
+
   semi_sort();
 
   for (int from = 1; from <= npages; from++) {
@@ -130,6 +163,26 @@ void ZRelocationSetSelectorGroup::select_inner() {
     // of in which order the objects are relocated.
     const int to = ceil((double)(from_live_bytes) / (double)(_page_size - _object_size_limit));
 
+    // Since pages are sorted by live bytes, the smallest candidate relocation set
+    // that reclaims enough memory to bring the remaining garbage down to the goal
+    // is also the one with the lowest copying cost.
+    if (!goal_met && from > to) {
+      const size_t reclaimed = (size_t)(from - to) * _page_size;
+      if (garbage - MIN2(garbage, reclaimed) <= garbage_goal) {
+        goal_met = true;
+        goal_from = from;
+        goal_to = to;
+        goal_live_bytes = from_live_bytes;
+        goal_forwarding_entries = from_forwarding_entries;
+      }
+    }
+
+    // Only pages with more garbage than the fragmentation limit are
+    // relocated for their own sake.
+    if (_page_size - page->live_bytes() <= _fragmentation_limit) {
+      continue;
+    }
+
     // Calculate the relative difference in reclaimable space compared to our
     // currently selected final relocation set. If this number is larger than the
     // acceptable fragmentation limit, then the current candidate relocation set
@@ -150,6 +203,16 @@ void ZRelocationSetSelectorGroup::select_inner() {
                          (selected_from == from) ? "Selected" : "Rejected");
   }
 
+  if (goal_from > selected_from) {
+    // Extend the relocation set to meet the fragmentation goal
+    log_trace(gc, reloc)("Relocation Set (%s Pages): Extended from %d to %d pages to meet goal of "
+                         SIZE_FORMAT "M garbage", _name, selected_from, goal_from, garbage_goal / M);
+    selected_from = goal_from;
+    selected_to = goal_to;
+    selected_live_bytes = goal_live_bytes;
+    selected_forwarding_entries = goal_forwarding_entries;
+  }
+
   // Finalize selection
   _live_pages.trunc_to(selected_from);
   _forwarding_entries = selected_forwarding_entries;
@@ -159,6 +222,33 @@ void ZRelocationSetSelectorGroup::select_inner() {
 
   log_trace(gc, reloc)("Relocation Set (%s Pages): %d->%d, %d skipped, " SIZE_FORMAT " forwarding entries",
                        _name, selected_from, selected_to, npages - selected_from, selected_forwarding_entries);
+
+  if (ZTenuringThreshold > 0) {
+    log_debug(gc, reloc)("Old %s Pages: " SIZE_FORMAT " of " SIZE_FORMAT ", " SIZE_FORMAT "M live",
+                         _name, _stats._old_npages, _stats._npages, _stats._old_live / M);
+  }
+}
+
+void ZRelocationSetSelectorGroup::select_large() {
+  // Every candidate large page holds a single object which is small enough to
+  // be consolidated with other such objects into a medium page. Relocating it
+  // is worth it on its own, so select all candidates.
+  size_t selected_live_bytes = 0;
+  size_t selected_forwarding_entries = 0;
+
+  ZArrayIterator<ZPage*> iter(&_live_pages);
+  for (ZPage* page; iter.next(&page);) {
+    selected_live_bytes += page->live_bytes();
+    selected_forwarding_entries += ZForwarding::nentries(page);
+  }
+
+  _forwarding_entries = selected_forwarding_entries;
+
+  // Update statistics
+  _stats._relocate = selected_live_bytes;
+
+  log_trace(gc, reloc)("Relocation Set (%s Pages): %d, " SIZE_FORMAT " forwarding entries",
+                       _name, _live_pages.length(), selected_forwarding_entries);
 }
 
 void ZRelocationSetSelectorGroup::select() {
@@ -168,8 +258,14 @@ void ZRelocationSetSelectorGroup::select() {
 
   EventZRelocationSetGroup event;
 
+  print_live_histogram();
+
   if (is_selectable()) {
-    select_inner();
+    if (_page_type == ZPageTypeLarge) {
+      select_large();
+    } else {
+      select_inner();
+    }
   }
 
   // Send event
@@ -184,10 +280,11 @@ ZRelocationSetSelector::ZRelocationSetSelector() :
 
 void ZRelocationSetSelector::select() {
   // Select pages to relocate. The resulting relocation set will be
-  // sorted such that medium pages comes first, followed by small
-  // pages. Pages within each page group will be semi-sorted by live
-  // bytes in ascending order. Relocating pages in this order allows
-  // us to start reclaiming memory more quickly.
+  // sorted such that medium pages, and any large pages selected for
+  // consolidation, come first, followed by small pages. Pages within
+  // each page group will be semi-sorted by live bytes in ascending
+  // order. Relocating pages in this order allows us to start
+  // reclaiming memory more quickly.
 
   EventZRelocationSet event;
 
@@ -38,6 +38,8 @@ private:
   size_t _live;
   size_t _empty;
   size_t _relocate;
+  size_t _old_npages;
+  size_t _old_live;
 
 public:
   ZRelocationSetSelectorGroupStats();
@@ -47,6 +49,8 @@ public:
   size_t live() const;
   size_t empty() const;
   size_t relocate() const;
+  size_t old_npages() const;
+  size_t old_live() const;
 };
 
 class ZRelocationSetSelectorStats {
@@ -65,19 +69,27 @@ public:
 
 class ZRelocationSetSelectorGroup {
 private:
+  // Number of buckets in the live bytes histogram
+  static const size_t              nhistogram_buckets = 16;
+
   const char* const                _name;
   const uint8_t                    _page_type;
   const size_t                     _page_size;
   const size_t                     _object_size_limit;
   const size_t                     _fragmentation_limit;
+  const size_t                     _old_fragmentation_limit;
   ZArray<ZPage*>                   _live_pages;
   size_t                           _forwarding_entries;
   ZRelocationSetSelectorGroupStats _stats;
+  size_t                           _live_histogram[nhistogram_buckets];
 
   bool is_disabled();
   bool is_selectable();
+  bool is_candidate(const ZPage* page, size_t size, size_t live) const;
   void semi_sort();
   void select_inner();
+  void select_large();
+  void print_live_histogram() const;
 
 public:
   ZRelocationSetSelectorGroup(const char* name,
@@ -120,6 +132,7 @@ public:
 
   const ZArray<ZPage*>* small() const;
   const ZArray<ZPage*>* medium() const;
+  const ZArray<ZPage*>* large() const;
   size_t forwarding_entries() const;
 
   ZRelocationSetSelectorStats stats() const;
@@ -49,6 +49,14 @@ inline size_t ZRelocationSetSelectorGroupStats::relocate() const {
   return _relocate;
 }
 
+inline size_t ZRelocationSetSelectorGroupStats::old_npages() const {
+  return _old_npages;
+}
+
+inline size_t ZRelocationSetSelectorGroupStats::old_live() const {
+  return _old_live;
+}
+
 inline const ZRelocationSetSelectorGroupStats& ZRelocationSetSelectorStats::small() const {
   return _small;
 }
@@ -61,19 +69,50 @@ inline const ZRelocationSetSelectorGroupStats& ZRelocationSetSelectorStats::larg
   return _large;
 }
 
+inline bool ZRelocationSetSelectorGroup::is_candidate(const ZPage* page, size_t size, size_t live) const {
+  const size_t garbage = size - live;
+
+  if (_page_type == ZPageTypeLarge) {
+    // A large page holds a single object. Objects that leave a significant
+    // part of their page unused, and that are small enough to share a medium
+    // page with other such objects, can be consolidated into medium pages.
+    return ZCompactLargePages &&
+           ZPageSizeMedium != 0 &&
+           live <= ZPageSizeMedium / 4 &&
+           garbage > size * (ZFragmentationLimit / 100);
+  }
+
+  // Old pages contain long-lived objects that would most likely survive
+  // being relocated again, so they need to be more fragmented before it
+  // pays off to relocate them. Other pages with garbage are candidates,
+  // and whether they are selected is decided by select_inner().
+  if (page->is_old()) {
+    return garbage > _old_fragmentation_limit;
+  }
+
+  return garbage > 0;
+}
+
 inline void ZRelocationSetSelectorGroup::register_live_page(ZPage* page) {
-  const uint8_t type = page->type();
   const size_t size = page->size();
   const size_t live = page->live_bytes();
-  const size_t garbage = size - live;
 
-  if (garbage > _fragmentation_limit) {
+  if (is_candidate(page, size, live)) {
     _live_pages.append(page);
   }
 
+  // Update live bytes histogram
+  const size_t bucket = MIN2(live * nhistogram_buckets / size, nhistogram_buckets - 1);
+  _live_histogram[bucket]++;
+
   _stats._npages++;
   _stats._total += size;
   _stats._live += live;
+
+  if (page->is_old()) {
+    _stats._old_npages++;
+    _stats._old_live += live;
+  }
 }
 
 inline void ZRelocationSetSelectorGroup::register_empty_page(ZPage* page) {
@@ -154,8 +193,12 @@ inline const ZArray<ZPage*>* ZRelocationSetSelector::medium() const {
   return _medium.selected();
 }
 
+inline const ZArray<ZPage*>* ZRelocationSetSelector::large() const {
+  return _large.selected();
+}
+
 inline size_t ZRelocationSetSelector::forwarding_entries() const {
-  return _small.forwarding_entries() + _medium.forwarding_entries();
+  return _small.forwarding_entries() + _medium.forwarding_entries() + _large.forwarding_entries();
 }
 
 #endif // SHARE_GC_Z_ZRELOCATIONSETSELECTOR_INLINE_HPP
@@ -27,6 +27,7 @@
 #include "gc/z/zCollectedHeap.hpp"
 #include "gc/z/zCPU.inline.hpp"
 #include "gc/z/zGlobals.hpp"
+#include "gc/z/zHeuristics.hpp"
 #include "gc/z/zNMethodTable.hpp"
 #include "gc/z/zPageAllocator.inline.hpp"
 #include "gc/z/zRelocationSetSelector.inline.hpp"
@@ -1066,10 +1067,33 @@ Ticks     ZStatCycle::_start_of_last;
 Ticks     ZStatCycle::_end_of_last;
 NumberSeq ZStatCycle::_serial_time(0.7 /* alpha */);
 NumberSeq ZStatCycle::_parallelizable_time(0.7 /* alpha */);
+NumberSeq ZStatCycle::_mark_throughput(0.7 /* alpha */);
+NumberSeq ZStatCycle::_relocate_throughput(0.7 /* alpha */);
+NumberSeq ZStatCycle::_other_parallelizable_time(0.7 /* alpha */);
 uint      ZStatCycle::_last_active_workers = 0;
+double    ZStatCycle::_mark_workers_duration = 0.0;
+double    ZStatCycle::_relocate_workers_duration = 0.0;
 
 void ZStatCycle::at_start() {
   _start_of_last = Ticks::now();
+  _mark_workers_duration = 0.0;
+  _relocate_workers_duration = 0.0;
+}
+
+void ZStatCycle::at_mark_start() {
+  _mark_workers_duration = -ZStatWorkers::accumulated_duration();
+}
+
+void ZStatCycle::at_mark_end() {
+  _mark_workers_duration += ZStatWorkers::accumulated_duration();
+}
+
+void ZStatCycle::at_relocate_start() {
+  _relocate_workers_duration = -ZStatWorkers::accumulated_duration();
+}
+
+void ZStatCycle::at_relocate_end() {
+  _relocate_workers_duration += ZStatWorkers::accumulated_duration();
 }
 
 void ZStatCycle::at_end(GCCause::Cause cause, uint active_workers) {
@@ -1081,13 +1105,34 @@ void ZStatCycle::at_end(GCCause::Cause cause, uint active_workers) {
 
   _last_active_workers = active_workers;
 
-  // Calculate serial and parallelizable GC cycle times
+  // Calculate serial and parallelizable GC cycle times. Workers in excess
+  // of the available CPUs do not run in parallel, so the parallelizable time
+  // is measured in CPU time rather than worker time. This keeps throttling
+  // due to a container CPU quota from inflating the measured GC work.
   const double duration = (_end_of_last - _start_of_last).seconds();
   const double workers_duration = ZStatWorkers::get_and_reset_duration();
+  const double effective_workers = MIN2((double)active_workers, ZHeuristics::available_cpus());
   const double serial_time = duration - workers_duration;
-  const double parallelizable_time = workers_duration * active_workers;
+  const double parallelizable_time = workers_duration * effective_workers;
   _serial_time.add(serial_time);
   _parallelizable_time.add(parallelizable_time);
+
+  // Calculate mark and relocate throughput. Marking nothing, or an empty
+  // relocation set, still takes some time, but says nothing about the
+  // throughput. Sampling zero would make the predicted times explode.
+  const double mark_time = MAX2(_mark_workers_duration, 0.0) * effective_workers;
+  const double relocate_time = MAX2(_relocate_workers_duration, 0.0) * effective_workers;
+  const size_t marked = ZStatHeap::live_at_mark_end();
+  const size_t relocated = ZStatRelocation::relocate();
+  if (mark_time > 0.0 && marked > 0) {
+    _mark_throughput.add(marked / mark_time);
+  }
+  if (relocate_time > 0.0 && relocated > 0) {
+    _relocate_throughput.add(relocated / relocate_time);
+  }
+  if (mark_time > 0.0) {
+    _other_parallelizable_time.add(MAX2(parallelizable_time - mark_time - relocate_time, 0.0));
+  }
 }
 
 bool ZStatCycle::is_warm() {
@@ -1112,6 +1157,22 @@ const AbsSeq& ZStatCycle::parallelizable_time() {
   return _parallelizable_time;
 }
 
+bool ZStatCycle::is_throughput_trustable() {
+  return _mark_throughput.num() > 0 && _relocate_throughput.num() > 0;
+}
+
+const AbsSeq& ZStatCycle::mark_throughput() {
+  return _mark_throughput;
+}
+
+const AbsSeq& ZStatCycle::relocate_throughput() {
+  return _relocate_throughput;
+}
+
+const AbsSeq& ZStatCycle::other_parallelizable_time() {
+  return _other_parallelizable_time;
+}
+
 uint ZStatCycle::last_active_workers() {
   return _last_active_workers;
 }
@@ -1143,6 +1204,10 @@ void ZStatWorkers::at_end() {
   _accumulated_duration += duration;
 }
 
+double ZStatWorkers::accumulated_duration() {
+  return _accumulated_duration.seconds();
+}
+
 double ZStatWorkers::get_and_reset_duration() {
   const double duration = _accumulated_duration.seconds();
   const Ticks now = Ticks::now();
@@ -1210,6 +1275,7 @@ ZRelocationSetSelectorStats ZStatRelocation::_selector_stats;
 size_t                      ZStatRelocation::_forwarding_usage;
 size_t                      ZStatRelocation::_small_in_place_count;
 size_t                      ZStatRelocation::_medium_in_place_count;
+size_t                      ZStatRelocation::_large_in_place_count;
 
 void ZStatRelocation::set_at_select_relocation_set(const ZRelocationSetSelectorStats& selector_stats) {
   _selector_stats = selector_stats;
@@ -1219,9 +1285,16 @@ void ZStatRelocation::set_at_install_relocation_set(size_t forwarding_usage) {
   _forwarding_usage = forwarding_usage;
 }
 
-void ZStatRelocation::set_at_relocate_end(size_t small_in_place_count, size_t medium_in_place_count) {
+void ZStatRelocation::set_at_relocate_end(size_t small_in_place_count,
+                                          size_t medium_in_place_count,
+                                          size_t large_in_place_count) {
   _small_in_place_count = small_in_place_count;
   _medium_in_place_count = medium_in_place_count;
+  _large_in_place_count = large_in_place_count;
+}
+
+size_t ZStatRelocation::relocate() {
+  return _selector_stats.small().relocate() + _selector_stats.medium().relocate() + _selector_stats.large().relocate();
 }
 
 void ZStatRelocation::print(const char* name,
@@ -1242,7 +1315,7 @@ void ZStatRelocation::print() {
   if (ZPageSizeMedium != 0) {
     print("Medium", _selector_stats.medium(), _medium_in_place_count);
   }
-  print("Large", _selector_stats.large(), 0 /* in_place_count */);
+  print("Large", _selector_stats.large(), _large_in_place_count);
 
   log_info(gc, reloc)("Forwarding Usage: " SIZE_FORMAT "M", _forwarding_usage / M);
 }
@@ -1416,6 +1489,10 @@ size_t ZStatHeap::used_at_mark_start() {
   return _at_mark_start.used;
 }
 
+size_t ZStatHeap::live_at_mark_end() {
+  return _at_mark_end.live;
+}
+
 size_t ZStatHeap::used_at_relocate_end() {
   return _at_relocate_end.used;
 }
@@ -376,12 +376,23 @@ private:
   static Ticks     _end_of_last;
   static NumberSeq _serial_time;
   static NumberSeq _parallelizable_time;
+  static NumberSeq _mark_throughput;
+  static NumberSeq _relocate_throughput;
+  static NumberSeq _other_parallelizable_time;
   static uint      _last_active_workers;
+  static double    _mark_workers_duration;
+  static double    _relocate_workers_duration;
 
 public:
   static void at_start();
   static void at_end(GCCause::Cause cause, uint active_workers);
 
+  // Bracket the mark and relocate phases, to measure their throughput
+  static void at_mark_start();
+  static void at_mark_end();
+  static void at_relocate_start();
+  static void at_relocate_end();
+
   static bool is_warm();
   static uint64_t nwarmup_cycles();
 
@@ -389,6 +400,13 @@ public:
   static const AbsSeq& serial_time();
   static const AbsSeq& parallelizable_time();
 
+  // Bytes marked/relocated per second of CPU time, and the remaining
+  // parallelizable time of a GC cycle not spent marking or relocating
+  static bool is_throughput_trustable();
+  static const AbsSeq& mark_throughput();
+  static const AbsSeq& relocate_throughput();
+  static const AbsSeq& other_parallelizable_time();
+
   static uint last_active_workers();
 
   static double time_since_last();
@@ -406,6 +424,7 @@ public:
   static void at_start();
   static void at_end();
 
+  static double accumulated_duration();
   static double get_and_reset_duration();
 };
 
@@ -449,6 +468,7 @@ private:
   static size_t                      _forwarding_usage;
   static size_t                      _small_in_place_count;
   static size_t                      _medium_in_place_count;
+  static size_t                      _large_in_place_count;
 
   static void print(const char* name,
                     const ZRelocationSetSelectorGroupStats& selector_group,
@@ -457,7 +477,11 @@ private:
 public:
   static void set_at_select_relocation_set(const ZRelocationSetSelectorStats& selector_stats);
   static void set_at_install_relocation_set(size_t forwarding_usage);
-  static void set_at_relocate_end(size_t small_in_place_count, size_t medium_in_place_count);
+  static void set_at_relocate_end(size_t small_in_place_count,
+                                  size_t medium_in_place_count,
+                                  size_t large_in_place_count);
+
+  static size_t relocate();
 
   static void print();
 };
@@ -567,6 +591,7 @@ public:
 
   static size_t max_capacity();
   static size_t used_at_mark_start();
+  static size_t live_at_mark_end();
   static size_t used_at_relocate_end();
 
   static void print();
@@ -45,7 +45,6 @@ private:
 
   static void set_worker();
 
-  static bool has_worker_id();
   static void set_worker_id(uint worker_id);
   static void clear_worker_id();
 
@@ -55,6 +54,7 @@ public:
   static bool is_vm();
   static bool is_java();
   static bool is_worker();
+  static bool has_worker_id();
   static uint worker_id();
 };
 
@@ -38,6 +38,30 @@
   product(double, ZFragmentationLimit, 25.0,                                \
           "Maximum allowed heap fragmentation")                             \
                                                                             \
+  product(uint, ZTenuringThreshold, 0, EXPERIMENTAL,                        \
+          "Number of GC cycles a page must survive before it is treated "   \
+          "as old. Old pages are only relocated if their fragmentation "    \
+          "exceeds ZOldFragmentationLimit (0 = disabled)")                  \
+          range(0, 15)                                                      \
+                                                                            \
+  product(double, ZOldFragmentationLimit, 50.0, EXPERIMENTAL,               \
+          "Maximum allowed fragmentation of old pages")                     \
+          range(0.0, 100.0)                                                 \
+                                                                            \
+  product(bool, ZCompactLargePages, false, EXPERIMENTAL,                    \
+          "Relocate objects in under-filled large pages into medium pages") \
+                                                                            \
+  product(uint, ZPageMagazineSize, 0, EXPERIMENTAL,                         \
+          "Number of free small pages cached per CPU, allowing small "      \
+          "pages to be allocated and freed without taking the page "        \
+          "allocator lock (0 = disabled)")                                  \
+          range(0, 8)                                                       \
+                                                                            \
+  product(bool, ZHugePageCollapse, false, EXPERIMENTAL,                     \
+          "Collapse heap memory into transparent huge pages when it is "    \
+          "mapped, instead of leaving that to khugepaged. Only used with "  \
+          "-XX:+UseTransparentHugePages on Linux")                          \
+                                                                            \
   product(size_t, ZMarkStackSpaceLimit, 8*G,                                \
           "Maximum number of bytes allocated for mark stacks")              \
           range(32*M, 1024*G)                                               \
@@ -0,0 +1,104 @@
+/*
+ * Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "gc/z/zGlobals.hpp"
+#include "gc/z/zList.inline.hpp"
+#include "gc/z/zPage.inline.hpp"
+#include "gc/z/zPageMagazine.inline.hpp"
+#include "runtime/flags/flagSetting.hpp"
+#include "runtime/globals.hpp"
+#include "unittest.hpp"
+
+class ZPageMagazineTest : public ::testing::Test {
+protected:
+  static const size_t npages = ZPageMagazine::size_max + 1;
+
+  static ZPage* create_page(size_t index) {
+    const uintptr_t start = index * ZPageSizeSmall;
+    const ZVirtualMemory vmem(start, ZPageSizeSmall);
+    const ZPhysicalMemory pmem(ZPhysicalMemorySegment(start, ZPageSizeSmall, true));
+    return new ZPage(ZPageTypeSmall, vmem, pmem);
+  }
+
+  static void test(uint size) {
+    AutoSaveRestore<uint> FLAG_GUARD(ZPageMagazineSize);
+    ZPageMagazineSize = size;
+
+    ZPage* pages[npages];
+    for (size_t i = 0; i < npages; i++) {
+      pages[i] = create_page(i);
+    }
+
+    ZPageMagazine magazine;
+
+    // Empty magazine
+    ASSERT_EQ(magazine.alloc_page(), (ZPage*)NULL);
+
+    // Fill magazine, until full
+    for (size_t i = 0; i < npages; i++) {
+      ASSERT_EQ(magazine.free_page(pages[i]), i < size) << "size: " << size << " page: " << i;
+    }
+
+    // Allocate one page, it must be one of the freed pages
+    if (size > 0) {
+      ZPage* const page = magazine.alloc_page();
+      ASSERT_NE(page, (ZPage*)NULL);
+      ASSERT_LT(page->start() / ZPageSizeSmall, (uintptr_t)size);
+
+      // Put it back
+      ASSERT_TRUE(magazine.free_page(page));
+    }
+
+    // Flush the remaining pages
+    ZList<ZPage> list;
+    ASSERT_EQ(magazine.flush(&list), size * ZPageSizeSmall);
+    ASSERT_EQ(list.size(), (size_t)size);
+    ASSERT_EQ(magazine.alloc_page(), (ZPage*)NULL);
+
+    // Flushed magazine accepts pages again
+    if (size > 0) {
+      ZPage* const page = list.remove_first();
+      ASSERT_TRUE(magazine.free_page(page));
+      ASSERT_EQ(magazine.alloc_page(), page);
+      list.insert_last(page);
+    }
+
+    // Unlink pages before deleting them
+    while (list.remove_first() != NULL) {}
+
+    for (size_t i = 0; i < npages; i++) {
+      delete pages[i];
+    }
+  }
+};
+
+TEST_F(ZPageMagazineTest, disabled) {
+  test(0);
+}
+
+TEST_F(ZPageMagazineTest, sizes) {
+  for (uint size = 1; size <= ZPageMagazine::size_max; size++) {
+    test(size);
+  }
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+
+package gc.arguments;
+
+/*
+ * @test TestNUMASurvivorStripes
+ * @requires vm.gc.Parallel
+ * @summary Test scavenges that copy survivors into NUMA node-local survivor stripes
+ * @library /test/lib
+ * @run main/othervm -XX:+UseParallelGC -XX:+UseNUMA
+ *      -XX:+UnlockExperimentalVMOptions -XX:+UseNUMASurvivorStripes
+ *      -Xmx256m -Xmn64m -XX:-UseAdaptiveSizePolicy -XX:SurvivorRatio=4
+ *      -XX:+UnlockDiagnosticVMOptions -XX:+VerifyAfterGC
+ *      -Xlog:gc+heap=debug
+ *      gc.arguments.TestNUMASurvivorStripes
+ * @run main/othervm -XX:+UseParallelGC -XX:+UseNUMA
+ *      -XX:+UnlockExperimentalVMOptions -XX:+UseNUMASurvivorStripes
+ *      -Xmx256m -Xmn16m -XX:MaxTenuringThreshold=15
+ *      -XX:+UnlockDiagnosticVMOptions -XX:+VerifyAfterGC
+ *      gc.arguments.TestNUMASurvivorStripes
+ */
+
+public class TestNUMASurvivorStripes {
+    private static final int LIVE = 4096;
+    private static final int ROUNDS = 200_000;
+
+    public static void main(String[] args) {
+        // Keep a sliding window of live objects of varying size, allocated
+        // from several threads, so that objects survive a few scavenges
+        // and age in the survivor spaces.
+        Thread[] threads = new Thread[4];
+        for (int t = 0; t < threads.length; t++) {
+            threads[t] = new Thread(TestNUMASurvivorStripes::allocate);
+            threads[t].start();
+        }
+        for (Thread thread : threads) {
+            try {
+                thread.join();
+            } catch (InterruptedException e) {
+                throw new RuntimeException(e);
+            }
+        }
+    }
+
+    private static void allocate() {
+        byte[][] live = new byte[LIVE][];
+        for (int i = 0; i < ROUNDS; i++) {
+            int index = i % LIVE;
+            if (live[index] != null && live[index].length != 16 + (index % 64) * 8) {
+                throw new RuntimeException("Corrupt object at index " + index);
+            }
+            live[index] = new byte[16 + (index % 64) * 8];
+        }
+    }
+}
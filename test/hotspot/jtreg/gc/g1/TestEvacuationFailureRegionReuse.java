@@ -0,0 +1,73 @@
+/*
+ * Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package gc.g1;
+
+/*
+ * @test TestEvacuationFailureRegionReuse
+ * @summary Test that evacuation failure handling ignores stale prev bitmap marks
+ * in regions that were freed and reused after a concurrent marking.
+ * @key randomness
+ * @requires vm.gc.G1
+ * @requires vm.debug
+ * @library /test/lib
+ * @run main/othervm
+ *    -XX:+UseG1GC -Xmx64m -XX:G1HeapRegionSize=1m
+ *    -XX:InitiatingHeapOccupancyPercent=20 -XX:G1MixedGCLiveThresholdPercent=100
+ *    -XX:G1HeapWastePercent=0
+ *    -XX:+G1EvacuationFailureALot -XX:G1EvacuationFailureALotInterval=1
+ *    -XX:G1EvacuationFailureALotCount=100
+ *    -XX:+UnlockDiagnosticVMOptions -XX:+VerifyAfterGC
+ *    -Xlog:gc
+ *    gc.g1.TestEvacuationFailureRegionReuse
+ */
+
+import java.util.Random;
+
+import jdk.test.lib.Utils;
+
+public class TestEvacuationFailureRegionReuse {
+    private static final long MAX_MILLIS_FOR_RUN = 30 * 1000;
+
+    private static final int OLD_COUNT = 64 * 1024;
+
+    private static Object[] old = new Object[OLD_COUNT];
+
+    public static void main(String[] args) {
+        Random rng = Utils.getRandomInstance();
+        long start = System.currentTimeMillis();
+        Object[] young = new Object[1024];
+
+        // Keep replacing long-lived objects, so that old regions are marked,
+        // reclaimed by mixed collections, and reused as young regions, while
+        // evacuation failures are forced into the collection sets.
+        while (System.currentTimeMillis() - start < MAX_MILLIS_FOR_RUN) {
+            for (int i = 0; i < 1024 * 1024; i++) {
+                young[rng.nextInt(young.length)] = new int[rng.nextInt(16)];
+                if ((i & 0xf) == 0) {
+                    old[rng.nextInt(OLD_COUNT)] = new long[rng.nextInt(64)];
+                }
+            }
+        }
+    }
+}
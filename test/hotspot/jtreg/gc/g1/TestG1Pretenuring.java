@@ -0,0 +1,98 @@
+/*
+ * Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package gc.g1;
+
+/*
+ * @test TestG1Pretenuring
+ * @summary Test that G1UsePretenuring pretenures a class whose instances are
+ * all tenured, and stops pretenuring it once they die young.
+ * @requires vm.gc.G1
+ * @library /test/lib
+ * @build jdk.test.whitebox.WhiteBox
+ * @run driver jdk.test.lib.helpers.ClassFileInstaller jdk.test.whitebox.WhiteBox
+ * @run driver gc.g1.TestG1Pretenuring
+ */
+
+import java.util.ArrayList;
+import java.util.regex.Pattern;
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+import jdk.test.whitebox.WhiteBox;
+
+public class TestG1Pretenuring {
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder("-Xbootclasspath/a:.",
+                                                                  "-XX:+UseG1GC",
+                                                                  "-XX:+UnlockExperimentalVMOptions",
+                                                                  "-XX:+UnlockDiagnosticVMOptions",
+                                                                  "-XX:+WhiteBoxAPI",
+                                                                  "-XX:+G1UsePretenuring",
+                                                                  "-XX:G1PretenureThresholdPercent=80",
+                                                                  "-XX:MaxTenuringThreshold=2",
+                                                                  "-Xmx256m",
+                                                                  "-XX:+VerifyAfterGC",
+                                                                  "-Xlog:gc+ergo=debug",
+                                                                  GCTest.class.getName());
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        String name = Pattern.quote(Payload.class.getName());
+        output.shouldMatch("Pretenure " + name + " \\(");
+        output.shouldMatch("Stop pretenuring " + name + " \\(");
+    }
+
+    static class Payload {
+        long a;
+        long b;
+    }
+
+    public static class GCTest {
+        private static final int BATCH = 10_000;
+
+        public static ArrayList<Payload> longLived = new ArrayList<>();
+        public static Payload[] shortLived = new Payload[BATCH];
+
+        public static void main(String args[]) throws Exception {
+            WhiteBox wb = WhiteBox.getWhiteBox();
+
+            // Every instance lives forever and is eventually tenured.
+            for (int i = 0; i < 30; i++) {
+                for (int j = 0; j < BATCH; j++) {
+                    longLived.add(new Payload());
+                }
+                wb.youngGC();
+            }
+
+            // Every instance survives exactly one young collection and is
+            // never tenured.
+            longLived = null;
+            for (int i = 0; i < 100; i++) {
+                for (int j = 0; j < BATCH; j++) {
+                    shortLived[j] = new Payload();
+                }
+                wb.youngGC();
+            }
+        }
+    }
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package gc.g1;
+
+/*
+ * @test TestReduceHumongousWaste
+ * @summary Test that heap parsing and verification work with humongous objects
+ * whose tail memory has been released with G1ReduceHumongousWaste.
+ * @key randomness
+ * @requires vm.gc.G1
+ * @requires vm.bits == "64"
+ * @library /test/lib
+ * @run main/othervm -XX:+UseG1GC -Xmx256m -XX:G1HeapRegionSize=1m
+ *    -XX:+UnlockExperimentalVMOptions -XX:+G1ReduceHumongousWaste
+ *    -XX:+UnlockDiagnosticVMOptions -XX:+VerifyBeforeGC -XX:+VerifyAfterGC
+ *    -XX:+UseCompressedClassPointers
+ *    gc.g1.TestReduceHumongousWaste
+ * @run main/othervm -XX:+UseG1GC -Xmx256m -XX:G1HeapRegionSize=1m
+ *    -XX:+UnlockExperimentalVMOptions -XX:+G1ReduceHumongousWaste
+ *    -XX:+UnlockDiagnosticVMOptions -XX:+VerifyBeforeGC -XX:+VerifyAfterGC
+ *    -XX:-UseCompressedClassPointers
+ *    gc.g1.TestReduceHumongousWaste
+ * @run main/othervm -XX:+UseG1GC -Xmx256m -XX:G1HeapRegionSize=1m
+ *    -XX:+UnlockExperimentalVMOptions -XX:+G1ReduceHumongousWaste
+ *    -XX:+UnlockDiagnosticVMOptions -XX:+VerifyBeforeGC -XX:+VerifyAfterGC
+ *    -XX:AllocateHeapAt=.
+ *    gc.g1.TestReduceHumongousWaste
+ */
+
+import java.util.ArrayList;
+import java.util.Random;
+
+import jdk.test.lib.Utils;
+
+public class TestReduceHumongousWaste {
+    private static final int REGION_SIZE = 1024 * 1024;
+
+    public static ArrayList<byte[]> live = new ArrayList<>();
+
+    public static void main(String[] args) {
+        Random rng = Utils.getRandomInstance();
+        for (int i = 0; i < 500; i++) {
+            // Sizes just above a multiple of the region size leave large
+            // tails; vary the filler start within the page.
+            int regions = 1 + rng.nextInt(3);
+            int size = regions * REGION_SIZE + rng.nextInt(4096) + 8;
+            byte[] a = new byte[size];
+            a[size - 1] = 1;
+            live.add(a);
+            if (live.size() > 40) {
+                live.remove(rng.nextInt(live.size()));
+            }
+            if (i % 50 == 0) {
+                System.gc();
+            }
+        }
+        for (byte[] a : live) {
+            if (a[a.length - 1] != 1) {
+                throw new RuntimeException("Humongous object has been corrupted");
+            }
+        }
+    }
+}
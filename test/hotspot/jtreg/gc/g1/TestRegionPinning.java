@@ -0,0 +1,121 @@
+/*
+ * Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package gc.g1;
+
+/* @test
+ * @summary Test that young and full collections proceed while an object is
+ * pinned by a JNI critical section with G1UseRegionPinning, and that the
+ * pinned object stays in place.
+ * @key randomness
+ * @requires vm.gc.G1
+ * @library /test/lib
+ * @run main/othervm/native
+ *    -XX:+UseG1GC -Xmx128m -XX:G1HeapRegionSize=1m
+ *    -XX:+UnlockExperimentalVMOptions -XX:+G1UseRegionPinning
+ *    -XX:+UnlockDiagnosticVMOptions -XX:+VerifyBeforeGC -XX:+VerifyAfterGC
+ *    -Xlog:gc
+ *    gc.g1.TestRegionPinning
+ */
+
+import java.lang.management.GarbageCollectorMXBean;
+import java.lang.management.ManagementFactory;
+import java.util.Random;
+
+import jdk.test.lib.Utils;
+
+public class TestRegionPinning {
+    static { System.loadLibrary("TestRegionPinning"); }
+
+    private static final int OBJS_COUNT    = 1 << 10;
+    private static final int GARBAGE_COUNT = 1 << 20;
+
+    private static native long pin(int[] a);
+    private static native void unpin(int[] a);
+    private static native long address(int[] a);
+
+    private static Object[] objs;
+
+    private static long collectionCount() {
+        long count = 0;
+        for (GarbageCollectorMXBean bean : ManagementFactory.getGarbageCollectorMXBeans()) {
+            count += bean.getCollectionCount();
+        }
+        return count;
+    }
+
+    private static void test(Random rng, int length, boolean fullGC) {
+        objs = new Object[OBJS_COUNT];
+        for (int i = 0; i < OBJS_COUNT; i++) {
+            objs[i] = new Object[4];
+        }
+
+        int[] pinned = new int[length];
+        for (int i = 0; i < length; i++) {
+            pinned[i] = i;
+        }
+        int pinnedIdx = rng.nextInt(OBJS_COUNT);
+        objs[pinnedIdx] = pinned;
+
+        long addr = pin(pinned);
+        long collections = collectionCount();
+        try {
+            // Without pinning, allocating here would have to wait for the
+            // GCLocker to be released, i.e. either expand the heap or fail.
+            for (int i = 0; i < GARBAGE_COUNT; i++) {
+                int idx = rng.nextInt(OBJS_COUNT);
+                if (idx != pinnedIdx) {
+                    objs[idx] = new Object[4];
+                }
+            }
+            if (fullGC) {
+                System.gc();
+            }
+            if (collectionCount() == collections) {
+                throw new RuntimeException("No collection while the object was pinned");
+            }
+            if (address(pinned) != addr) {
+                throw new RuntimeException("Pinned object has been moved");
+            }
+        } finally {
+            unpin(pinned);
+        }
+
+        for (int i = 0; i < length; i++) {
+            if (pinned[i] != i) {
+                throw new RuntimeException("Pinned object has been corrupted at index " + i);
+            }
+        }
+    }
+
+    public static void main(String[] args) {
+        Random rng = Utils.getRandomInstance();
+        for (int i = 0; i < 10; i++) {
+            // A small array in a young region, and a humongous one.
+            test(rng, 16, false);
+            test(rng, 16, true);
+            test(rng, 1024 * 1024, false);
+            test(rng, 1024 * 1024, true);
+        }
+    }
+}
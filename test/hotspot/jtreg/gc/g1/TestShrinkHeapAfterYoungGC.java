@@ -0,0 +1,89 @@
+/*
+ * Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package gc.g1;
+
+/*
+ * @test TestShrinkHeapAfterYoungGC
+ * @summary Test that G1 shrinks the heap gradually after young collections
+ * if G1ShrinkByPercentOfCapacity is set, and does not if it is zero.
+ * @requires vm.gc.G1
+ * @library /test/lib
+ * @build jdk.test.whitebox.WhiteBox
+ * @run driver jdk.test.lib.helpers.ClassFileInstaller jdk.test.whitebox.WhiteBox
+ * @run driver gc.g1.TestShrinkHeapAfterYoungGC
+ */
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+import jdk.test.whitebox.WhiteBox;
+
+public class TestShrinkHeapAfterYoungGC {
+    private static OutputAnalyzer run(int shrinkPercent) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder("-Xbootclasspath/a:.",
+                                                                  "-XX:+UseG1GC",
+                                                                  "-XX:+UnlockExperimentalVMOptions",
+                                                                  "-XX:+UnlockDiagnosticVMOptions",
+                                                                  "-XX:+WhiteBoxAPI",
+                                                                  "-XX:G1ShrinkByPercentOfCapacity=" + shrinkPercent,
+                                                                  "-XX:MinHeapSize=16m",
+                                                                  "-XX:InitialHeapSize=256m",
+                                                                  "-Xmx256m",
+                                                                  "-XX:G1HeapRegionSize=1m",
+                                                                  "-XX:+VerifyAfterGC",
+                                                                  "-Xlog:gc+ergo+heap=debug,gc+phases=debug",
+                                                                  GCTest.class.getName());
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        return output;
+    }
+
+    public static void main(String[] args) throws Exception {
+        OutputAnalyzer output = run(10);
+        output.shouldContain("Heap shrinking:");
+        output.shouldContain("Shrink Heap After Collection");
+        output.shouldContain("Committed memory shrunk");
+
+        output = run(0);
+        output.shouldNotContain("Heap shrinking:");
+        output.shouldContain("Committed memory unchanged");
+    }
+
+    public static class GCTest {
+        public static void main(String args[]) throws Exception {
+            WhiteBox wb = WhiteBox.getWhiteBox();
+            long committed = Runtime.getRuntime().totalMemory();
+
+            // Cheap young collections with long mutator intervals keep the GC
+            // time ratio low; the mostly empty heap should shrink.
+            for (int i = 0; i < 30; i++) {
+                wb.youngGC();
+                Thread.sleep(100);
+            }
+
+            long committedAfter = Runtime.getRuntime().totalMemory();
+            System.out.println("Committed before: " + committed + " after: " + committedAfter);
+            System.out.println(committedAfter < committed ? "Committed memory shrunk" : "Committed memory unchanged");
+        }
+    }
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package gc.parallel;
+
+/*
+ * @test TestParallelDensePrefix
+ * @requires vm.gc.Parallel
+ * @summary Test Parallel full GCs that compute the summary and dense prefix with several workers
+ * @library /test/lib
+ * @run main/othervm -XX:+UseParallelGC -Xmx256m -XX:ParallelGCThreads=4
+ *      -XX:+UnlockDiagnosticVMOptions -XX:+VerifyBeforeGC -XX:+VerifyAfterGC
+ *      -XX:-UseMaximumCompactionOnSystemGC
+ *      gc.parallel.TestParallelDensePrefix
+ * @run main/othervm -XX:+UseParallelGC -Xmx256m -XX:ParallelGCThreads=8
+ *      -XX:+UnlockDiagnosticVMOptions -XX:+VerifyAfterGC
+ *      -XX:-UseMaximumCompactionOnSystemGC -XX:MarkSweepDeadRatio=50
+ *      gc.parallel.TestParallelDensePrefix
+ * @run main/othervm -XX:+UseParallelGC -Xmx256m -XX:ParallelGCThreads=1
+ *      -XX:+UnlockDiagnosticVMOptions -XX:+VerifyAfterGC
+ *      -XX:-UseMaximumCompactionOnSystemGC
+ *      gc.parallel.TestParallelDensePrefix
+ */
+
+public class TestParallelDensePrefix {
+    private static final int COUNT = 200_000;
+
+    public static void main(String[] args) {
+        // Fill the old generation with objects of varying size, and free
+        // different fractions of them, so that the density of the space
+        // varies and the dense prefix ends at different regions
+        Object[] objects = new Object[COUNT];
+        for (int i = 0; i < COUNT; i++) {
+            objects[i] = new byte[16 + (i % 32) * 16];
+        }
+        System.gc();
+
+        for (int round = 1; round <= 8; round++) {
+            for (int i = 0; i < COUNT; i++) {
+                if ((i / 1000) % 8 < round && i % (round + 1) == 0) {
+                    objects[i] = null;
+                }
+            }
+            System.gc();
+
+            for (int i = 0; i < COUNT; i += 3) {
+                if (objects[i] == null) {
+                    objects[i] = new byte[16 + (i % 32) * 16];
+                }
+            }
+            System.gc();
+        }
+
+        for (int i = 0; i < COUNT; i++) {
+            if (objects[i] != null && ((byte[]) objects[i]).length != 16 + (i % 32) * 16) {
+                throw new RuntimeException("Corrupt object at index " + i);
+            }
+        }
+    }
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/* @test id=default
+ * @summary Test Shenandoah adaptive heuristics with different trigger confidence levels
+ * @requires vm.gc.Shenandoah
+ * @library /test/lib
+ *
+ * @run main/othervm -XX:+UnlockDiagnosticVMOptions -XX:+UnlockExperimentalVMOptions -Xmx128m
+ *      -XX:+UseShenandoahGC -XX:ShenandoahGCHeuristics=adaptive
+ *      -XX:ShenandoahAdaptiveTriggerConfidence=50
+ *      TestAdaptiveTriggerConfidence
+ *
+ * @run main/othervm -XX:+UnlockDiagnosticVMOptions -XX:+UnlockExperimentalVMOptions -Xmx128m
+ *      -XX:+UseShenandoahGC -XX:ShenandoahGCHeuristics=adaptive
+ *      -XX:ShenandoahAdaptiveTriggerConfidence=99.9
+ *      TestAdaptiveTriggerConfidence
+ *
+ * @run main/othervm -XX:+UnlockDiagnosticVMOptions -XX:+UnlockExperimentalVMOptions -Xmx128m
+ *      -XX:+UseShenandoahGC -XX:ShenandoahGCHeuristics=adaptive
+ *      -XX:ShenandoahAdaptiveTriggerConfidence=99.9 -XX:+ShenandoahVerify
+ *      TestAdaptiveTriggerConfidence
+ */
+
+/* @test id=range
+ * @summary Test that out of range Shenandoah trigger confidence levels are rejected
+ * @requires vm.gc.Shenandoah
+ * @library /test/lib
+ *
+ * @run driver TestAdaptiveTriggerConfidence range
+ */
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestAdaptiveTriggerConfidence {
+    static final long TARGET_MB = Long.getLong("target", 2_000); // 2 Gb allocation
+    static final int WINDOW = 64 * 1024;
+
+    static Object[] retained = new Object[WINDOW];
+
+    private static OutputAnalyzer run(String confidence) throws Exception {
+        return new OutputAnalyzer(ProcessTools.createJavaProcessBuilder(
+                "-XX:+UnlockExperimentalVMOptions",
+                "-XX:+UseShenandoahGC",
+                "-XX:ShenandoahAdaptiveTriggerConfidence=" + confidence,
+                "-version").start());
+    }
+
+    public static void main(String[] args) throws Exception {
+        if (args.length > 0 && args[0].equals("range")) {
+            run("49.9").shouldNotHaveExitValue(0);
+            run("100").shouldNotHaveExitValue(0);
+            run("50").shouldHaveExitValue(0);
+            return;
+        }
+
+        // Allocate with a varying rate, and retain a sliding window of objects
+        long count = TARGET_MB * 1024 * 1024 / 16;
+        for (long c = 0; c < count; c++) {
+            retained[(int) (c % WINDOW)] = new Object();
+            if (c % 10_000_000 == 0) {
+                Thread.sleep(50);
+            }
+        }
+    }
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/* @test id=default
+ * @summary Test Shenandoah committing ahead and rate limited uncommit
+ * @requires vm.gc.Shenandoah
+ * @library /test/lib
+ *
+ * @run main/othervm -XX:+UnlockDiagnosticVMOptions -XX:+UnlockExperimentalVMOptions
+ *      -Xms16m -Xmx512m -XX:+UseShenandoahGC -XX:ShenandoahUncommitDelay=0
+ *      -XX:ShenandoahCommitAheadTime=0 -XX:ShenandoahUncommitRate=0
+ *      TestCommitAhead
+ *
+ * @run main/othervm -XX:+UnlockDiagnosticVMOptions -XX:+UnlockExperimentalVMOptions
+ *      -Xms16m -Xmx512m -XX:+UseShenandoahGC -XX:ShenandoahUncommitDelay=0
+ *      -XX:ShenandoahCommitAheadTime=200 -XX:ShenandoahUncommitRate=256
+ *      TestCommitAhead
+ *
+ * @run main/othervm -XX:+UnlockDiagnosticVMOptions -XX:+UnlockExperimentalVMOptions
+ *      -Xms16m -Xmx512m -XX:+UseShenandoahGC -XX:ShenandoahUncommitDelay=0
+ *      -XX:ShenandoahCommitAheadTime=5000 -XX:ShenandoahUncommitRate=1
+ *      -XX:+ShenandoahVerify
+ *      TestCommitAhead
+ *
+ * @run main/othervm -XX:+UnlockDiagnosticVMOptions -XX:+UnlockExperimentalVMOptions
+ *      -Xms16m -Xmx512m -XX:+UseShenandoahGC -XX:ShenandoahUncommitDelay=0
+ *      -XX:ShenandoahCommitAheadTime=1000 -XX:+AlwaysPreTouch
+ *      TestCommitAhead
+ */
+
+/* @test id=aggressive
+ * @summary Test Shenandoah committing ahead and rate limited uncommit
+ * @requires vm.gc.Shenandoah
+ * @library /test/lib
+ *
+ * @run main/othervm -XX:+UnlockDiagnosticVMOptions -XX:+UnlockExperimentalVMOptions
+ *      -Xms16m -Xmx512m -XX:+UseShenandoahGC -XX:ShenandoahGCHeuristics=aggressive
+ *      -XX:ShenandoahUncommitDelay=0 -XX:ShenandoahCommitAheadTime=1000
+ *      -XX:ShenandoahUncommitRate=16
+ *      TestCommitAhead
+ */
+
+/* @test id=logging
+ * @summary Test that Shenandoah commits regions ahead of allocation
+ * @requires vm.gc.Shenandoah
+ * @library /test/lib
+ *
+ * @run driver TestCommitAhead logging
+ */
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestCommitAhead {
+    static final int WINDOW = 32 * 1024;
+    static final int BURSTS = 10;
+
+    static Object[] retained = new Object[WINDOW];
+
+    public static void main(String[] args) throws Exception {
+        if (args.length > 0 && args[0].equals("logging")) {
+            OutputAnalyzer output = new OutputAnalyzer(ProcessTools.createJavaProcessBuilder(
+                    "-XX:+UnlockExperimentalVMOptions",
+                    "-Xms16m",
+                    "-Xmx512m",
+                    "-XX:+UseShenandoahGC",
+                    "-XX:ShenandoahUncommitDelay=0",
+                    "-XX:ShenandoahCommitAheadTime=5000",
+                    "-Xlog:gc=debug",
+                    TestCommitAhead.class.getName()).start());
+            output.shouldHaveExitValue(0);
+            output.shouldContain("Committed ahead");
+            return;
+        }
+
+        // Allocation bursts separated by idle periods, so that memory is
+        // uncommitted while idle, and committed ahead of the next burst
+        for (int burst = 0; burst < BURSTS; burst++) {
+            for (int i = 0; i < 2_000_000; i++) {
+                retained[i % WINDOW] = new byte[64];
+            }
+            Thread.sleep(500);
+        }
+    }
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/* @test id=passive
+ * @summary Test Shenandoah region aging
+ * @requires vm.gc.Shenandoah
+ * @library /test/lib
+ *
+ * @run main/othervm -XX:+UnlockDiagnosticVMOptions -XX:+UnlockExperimentalVMOptions -Xmx128m
+ *      -XX:+UseShenandoahGC -XX:ShenandoahGCMode=passive -XX:+ShenandoahRegionAging
+ *      -XX:+ShenandoahVerify -XX:+ShenandoahDegeneratedGC
+ *      TestRegionAging
+ *
+ * @run main/othervm -XX:+UnlockDiagnosticVMOptions -XX:+UnlockExperimentalVMOptions -Xmx128m
+ *      -XX:+UseShenandoahGC -XX:ShenandoahGCMode=passive -XX:+ShenandoahRegionAging
+ *      -XX:+ShenandoahVerify -XX:-ShenandoahDegeneratedGC
+ *      TestRegionAging
+ */
+
+/* @test id=aggressive
+ * @summary Test Shenandoah region aging
+ * @requires vm.gc.Shenandoah
+ * @library /test/lib
+ *
+ * @run main/othervm -XX:+UnlockDiagnosticVMOptions -XX:+UnlockExperimentalVMOptions -Xmx128m
+ *      -XX:+UseShenandoahGC -XX:ShenandoahGCHeuristics=aggressive -XX:+ShenandoahRegionAging
+ *      -XX:+ShenandoahVerify
+ *      TestRegionAging
+ *
+ * @run main/othervm -XX:+UnlockDiagnosticVMOptions -XX:+UnlockExperimentalVMOptions -Xmx128m
+ *      -XX:+UseShenandoahGC -XX:ShenandoahGCHeuristics=aggressive -XX:+ShenandoahRegionAging
+ *      -XX:ShenandoahTenuredRegionAge=1 -XX:ShenandoahTenuredRegionGarbageThreshold=0
+ *      TestRegionAging
+ */
+
+/* @test id=iu
+ * @summary Test Shenandoah region aging
+ * @requires vm.gc.Shenandoah
+ * @library /test/lib
+ *
+ * @run main/othervm -XX:+UnlockDiagnosticVMOptions -XX:+UnlockExperimentalVMOptions -Xmx128m
+ *      -XX:+UseShenandoahGC -XX:ShenandoahGCMode=iu -XX:+ShenandoahRegionAging
+ *      -XX:+ShenandoahVerify
+ *      TestRegionAging
+ */
+
+/* @test id=logging
+ * @summary Test that Shenandoah region aging tenures regions
+ * @requires vm.gc.Shenandoah
+ * @library /test/lib
+ *
+ * @run driver TestRegionAging logging
+ */
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestRegionAging {
+    static final int LONG_LIVED = 100_000;
+    static final int ITERS = 20;
+
+    static class Node {
+        final int value;
+        Node next;
+
+        Node(int value) {
+            this.value = value;
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        if (args.length > 0 && args[0].equals("logging")) {
+            OutputAnalyzer output = new OutputAnalyzer(ProcessTools.createJavaProcessBuilder(
+                    "-XX:+UnlockExperimentalVMOptions",
+                    "-Xmx128m",
+                    "-XX:+UseShenandoahGC",
+                    "-XX:ShenandoahGCHeuristics=aggressive",
+                    "-XX:+ShenandoahRegionAging",
+                    "-XX:ShenandoahTenuredRegionAge=2",
+                    "-Xlog:gc+ergo",
+                    TestRegionAging.class.getName()).start());
+            output.shouldHaveExitValue(0);
+            output.shouldMatch("Region Ages: [0-9]+ regions aged, [1-9][0-9]* newly tenured");
+
+            // Disabled by default
+            output = new OutputAnalyzer(ProcessTools.createJavaProcessBuilder(
+                    "-XX:+UnlockExperimentalVMOptions",
+                    "-Xmx128m",
+                    "-XX:+UseShenandoahGC",
+                    "-XX:ShenandoahGCHeuristics=aggressive",
+                    "-Xlog:gc+ergo",
+                    TestRegionAging.class.getName()).start());
+            output.shouldHaveExitValue(0);
+            output.shouldNotContain("Region Ages:");
+            return;
+        }
+
+        // Long-lived objects, interleaved with garbage
+        Node[] longLived = new Node[LONG_LIVED];
+        for (int i = 0; i < LONG_LIVED; i++) {
+            longLived[i] = new Node(i);
+            new Node(-1).next = longLived[i];
+        }
+
+        for (int iter = 0; iter < ITERS; iter++) {
+            // Short-lived data, and drop some long-lived objects to
+            // leave garbage behind in aged regions
+            Node young = null;
+            for (int i = 0; i < 200_000; i++) {
+                Node n = new Node(i);
+                n.next = young;
+                young = (i % 16 == 0) ? n : young;
+            }
+            for (int i = iter; i < LONG_LIVED; i += ITERS) {
+                longLived[i] = null;
+            }
+            System.gc();
+        }
+
+        for (int i = 0; i < LONG_LIVED; i++) {
+            if (longLived[i] != null && longLived[i].value != i) {
+                throw new RuntimeException("Corrupt object at index " + i);
+            }
+        }
+    }
+}
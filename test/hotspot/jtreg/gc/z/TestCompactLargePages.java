@@ -0,0 +1,95 @@
+/*
+ * Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package gc.z;
+
+/*
+ * @test TestCompactLargePages
+ * @requires vm.gc.Z
+ * @summary Test consolidation of under-filled large pages with ZCompactLargePages
+ * @library /test/lib
+ * @run driver gc.z.TestCompactLargePages
+ */
+
+import java.util.ArrayList;
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestCompactLargePages {
+    private static final String LARGE_RELOCATED = "Large Pages: [0-9]+ / [0-9]+M, Empty: [0-9]+M, Relocated: [1-9][0-9]*M";
+    private static final String LARGE_IN_PLACE = "Large Pages: .*, In-Place: [1-9][0-9]*";
+
+    private static OutputAnalyzer run(String... flags) throws Exception {
+        ArrayList<String> args = new ArrayList<>();
+        args.add("-XX:+UseZGC");
+        // Large enough heap to have medium pages
+        args.add("-Xmx1g");
+        args.add("-XX:+UnlockExperimentalVMOptions");
+        args.add("-XX:+UnlockDiagnosticVMOptions");
+        args.add("-XX:+ZVerifyForwarding");
+        args.add("-XX:+VerifyAfterGC");
+        args.add("-Xlog:gc+reloc=debug");
+        for (String flag : flags) {
+            args.add(flag);
+        }
+        args.add(Test.class.getName());
+        OutputAnalyzer output = new OutputAnalyzer(ProcessTools.createJavaProcessBuilder(args).start());
+        output.shouldHaveExitValue(0);
+        return output;
+    }
+
+    public static void main(String[] args) throws Exception {
+        // Disabled by default
+        run().shouldNotMatch(LARGE_RELOCATED);
+
+        run("-XX:+ZCompactLargePages").shouldMatch(LARGE_RELOCATED);
+        run("-XX:+ZCompactLargePages", "-XX:+ZStressRelocateInPlace").shouldMatch(LARGE_IN_PLACE);
+    }
+
+    public static class Test {
+        // Just above the medium object size limit, leaving about a third
+        // of each large page unused
+        private static final int SIZE = 4 * 1024 * 1024 + 1024;
+        private static final int COUNT = 16;
+
+        public static void main(String[] args) {
+            byte[][] arrays = new byte[COUNT][];
+            for (int i = 0; i < COUNT; i++) {
+                arrays[i] = new byte[SIZE];
+                arrays[i][0] = (byte)i;
+                arrays[i][SIZE - 1] = (byte)i;
+            }
+
+            for (int gc = 0; gc < 3; gc++) {
+                System.gc();
+            }
+
+            for (int i = 0; i < COUNT; i++) {
+                if (arrays[i][0] != (byte)i || arrays[i][SIZE - 1] != (byte)i) {
+                    throw new RuntimeException("Corrupt array at index " + i);
+                }
+            }
+        }
+    }
+}
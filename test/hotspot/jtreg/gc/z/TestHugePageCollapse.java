@@ -0,0 +1,82 @@
+/*
+ * Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package gc.z;
+
+/*
+ * @test TestHugePageCollapse
+ * @requires vm.gc.Z & os.family == "linux"
+ * @summary Test ZGC with transparent huge pages and ZHugePageCollapse
+ * @library /test/lib
+ * @run driver gc.z.TestHugePageCollapse
+ */
+
+import java.util.ArrayList;
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestHugePageCollapse {
+    private static OutputAnalyzer run(String... flags) throws Exception {
+        ArrayList<String> args = new ArrayList<>();
+        args.add("-XX:+UseZGC");
+        args.add("-Xms32M");
+        args.add("-Xmx128M");
+        args.add("-XX:+UseTransparentHugePages");
+        args.add("-XX:+UnlockExperimentalVMOptions");
+        args.add("-XX:+UnlockDiagnosticVMOptions");
+        args.add("-XX:ZUncommitDelay=1");
+        args.add("-Xlog:gc,gc+init");
+        for (String flag : flags) {
+            args.add(flag);
+        }
+        args.add(Test.class.getName());
+        OutputAnalyzer output = new OutputAnalyzer(ProcessTools.createJavaProcessBuilder(args).start());
+        output.shouldHaveExitValue(0);
+        return output;
+    }
+
+    public static void main(String[] args) throws Exception {
+        // Disabled by default
+        run("-XX:+PrintFlagsFinal").shouldMatch("bool ZHugePageCollapse += false");
+
+        run("-XX:+ZHugePageCollapse");
+        run("-XX:+ZHugePageCollapse", "-XX:+ZVerifyViews");
+    }
+
+    public static class Test {
+        public static void main(String[] args) throws Exception {
+            // Grow the heap, so that memory is committed and mapped, then
+            // let it be uncommitted and committed again
+            for (int round = 0; round < 2; round++) {
+                Object[] retained = new Object[64];
+                for (int i = 0; i < 64 * 1024; i++) {
+                    retained[i % retained.length] = new byte[16 * 1024];
+                }
+                System.gc();
+                Thread.sleep(2_000);
+                System.gc();
+            }
+        }
+    }
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package gc.z;
+
+/*
+ * @test TestPageMagazine
+ * @requires vm.gc.Z
+ * @summary Stress ZGC per-CPU page magazines with allocation stalls and uncommit
+ * @library /test/lib
+ * @run driver gc.z.TestPageMagazine
+ */
+
+import java.util.ArrayList;
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestPageMagazine {
+    private static void run(String... flags) throws Exception {
+        ArrayList<String> args = new ArrayList<>();
+        args.add("-XX:+UseZGC");
+        args.add("-Xms16M");
+        args.add("-Xmx32M");
+        args.add("-XX:+UnlockExperimentalVMOptions");
+        args.add("-XX:+UnlockDiagnosticVMOptions");
+        args.add("-XX:+ZVerifyViews");
+        args.add("-XX:ZUncommitDelay=1");
+        args.add("-XX:ZStatisticsInterval=1");
+        args.add("-Xlog:gc,gc+stats");
+        for (String flag : flags) {
+            args.add(flag);
+        }
+        args.add(Test.class.getName());
+        OutputAnalyzer output = new OutputAnalyzer(ProcessTools.createJavaProcessBuilder(args).start());
+        output.shouldHaveExitValue(0);
+    }
+
+    public static void main(String[] args) throws Exception {
+        run("-XX:ZPageMagazineSize=0");
+        run("-XX:ZPageMagazineSize=1");
+        run("-XX:ZPageMagazineSize=8");
+    }
+
+    public static class Test {
+        private static final int THREADS = 8;
+        private static final long DURATION_MS = 5_000;
+
+        private static void allocate() {
+            // Allocate quickly from many threads in a small heap, so that
+            // allocations stall, while most small pages become garbage and
+            // are freed again
+            Object[] retained = new Object[256];
+            long end = System.currentTimeMillis() + DURATION_MS;
+            int i = 0;
+            while (System.currentTimeMillis() < end) {
+                retained[i % retained.length] = new byte[1024 + (i % 8) * 1024];
+                i++;
+            }
+        }
+
+        public static void main(String[] args) throws Exception {
+            Thread[] threads = new Thread[THREADS];
+            for (int i = 0; i < THREADS; i++) {
+                threads[i] = new Thread(Test::allocate);
+                threads[i].start();
+            }
+            for (Thread thread : threads) {
+                thread.join();
+            }
+
+            // Let idle pages expire, including those held in magazines
+            Thread.sleep(3_000);
+            System.gc();
+        }
+    }
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package gc.z;
+
+/*
+ * @test TestZTenuringThreshold
+ * @requires vm.gc.Z
+ * @summary Test ZGC page ages with ZTenuringThreshold and ZOldFragmentationLimit
+ * @library /test/lib
+ * @run driver gc.z.TestZTenuringThreshold
+ */
+
+import java.util.ArrayList;
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestZTenuringThreshold {
+    private static OutputAnalyzer run(String... flags) throws Exception {
+        ArrayList<String> args = new ArrayList<>();
+        args.add("-XX:+UseZGC");
+        args.add("-Xmx256M");
+        args.add("-XX:+UnlockExperimentalVMOptions");
+        args.add("-XX:+UnlockDiagnosticVMOptions");
+        args.add("-XX:+ZVerifyForwarding");
+        args.add("-XX:+VerifyAfterGC");
+        args.add("-Xlog:gc+reloc=debug");
+        for (String flag : flags) {
+            args.add(flag);
+        }
+        args.add(Test.class.getName());
+        OutputAnalyzer output = new OutputAnalyzer(ProcessTools.createJavaProcessBuilder(args).start());
+        output.shouldHaveExitValue(0);
+        return output;
+    }
+
+    public static void main(String[] args) throws Exception {
+        // Disabled by default
+        run().shouldNotContain("Old Small Pages:");
+
+        run("-XX:ZTenuringThreshold=2").shouldMatch("Old Small Pages: [1-9][0-9]* of");
+        run("-XX:ZTenuringThreshold=2", "-XX:ZOldFragmentationLimit=0").shouldContain("Old Small Pages:");
+        run("-XX:ZTenuringThreshold=1", "-XX:+ZStressRelocateInPlace").shouldContain("Old Small Pages:");
+    }
+
+    static class Node {
+        final int value;
+        Node next;
+
+        Node(int value) {
+            this.value = value;
+        }
+    }
+
+    public static class Test {
+        private static final int LONG_LIVED = 200_000;
+
+        public static void main(String[] args) {
+            // Long-lived objects, interleaved with garbage so that their
+            // pages are fragmented and relocated
+            Node[] longLived = new Node[LONG_LIVED];
+            for (int i = 0; i < LONG_LIVED; i++) {
+                longLived[i] = new Node(i);
+                for (int j = 0; j < 4; j++) {
+                    new Node(-1).next = longLived[i];
+                }
+            }
+
+            for (int gc = 0; gc < 10; gc++) {
+                // Some short-lived data, and drop some long-lived objects to
+                // fragment the old pages
+                Node young = null;
+                for (int i = 0; i < 100_000; i++) {
+                    Node n = new Node(i);
+                    n.next = young;
+                    young = (i % 8 == 0) ? n : young;
+                }
+                for (int i = gc; i < LONG_LIVED; i += 10) {
+                    longLived[i] = null;
+                }
+                System.gc();
+            }
+
+            for (int i = 0; i < LONG_LIVED; i++) {
+                if (longLived[i] != null && longLived[i].value != i) {
+                    throw new RuntimeException("Corrupt object at index " + i);
+                }
+            }
+        }
+    }
+}
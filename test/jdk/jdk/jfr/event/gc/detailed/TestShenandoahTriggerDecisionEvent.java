@@ -0,0 +1,91 @@
+/*
+ * Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package jdk.jfr.event.gc.detailed;
+
+import java.util.List;
+
+import jdk.jfr.Recording;
+import jdk.jfr.consumer.RecordedEvent;
+import jdk.test.lib.Asserts;
+import jdk.test.lib.jfr.Events;
+
+/**
+ * @test TestShenandoahTriggerDecisionEvent
+ * @requires vm.hasJFR & vm.gc.Shenandoah
+ * @key jfr
+ * @library /test/lib /test/jdk /test/hotspot/jtreg
+ * @run main/othervm -XX:+UseShenandoahGC -XX:ShenandoahGCHeuristics=adaptive -Xmx64M
+ *      jdk.jfr.event.gc.detailed.TestShenandoahTriggerDecisionEvent
+ */
+
+public class TestShenandoahTriggerDecisionEvent {
+    private static final String EVENT_NAME = "jdk.ShenandoahTriggerDecision";
+
+    private static Object[] live = new Object[64 * 1024];
+
+    public static void main(String[] args) throws Exception {
+        try (Recording recording = new Recording()) {
+            recording.enable(EVENT_NAME);
+            recording.start();
+
+            // Alternate between allocation bursts and quiet phases, so that
+            // the heuristics both start cycles and decide not to.
+            long end = System.currentTimeMillis() + 10_000;
+            for (int phase = 0; System.currentTimeMillis() < end; phase++) {
+                if (phase % 2 == 0) {
+                    for (int i = 0; i < 2_000_000; i++) {
+                        Object o = new byte[64];
+                        if (i % 16 == 0) {
+                            live[(i / 16) % live.length] = o;
+                        }
+                    }
+                } else {
+                    Thread.sleep(200);
+                }
+            }
+
+            recording.stop();
+
+            List<RecordedEvent> events = Events.fromRecording(recording);
+            Events.hasEvents(events);
+            boolean triggered = false;
+            for (RecordedEvent event : events) {
+                System.out.println(event);
+                String trigger = event.getString("trigger");
+                Asserts.assertNotNull(trigger, "Must have a trigger");
+                Asserts.assertEquals(event.getBoolean("triggered"), !trigger.equals("None"), "Trigger must match decision");
+                triggered |= event.getBoolean("triggered");
+
+                Asserts.assertLessThanOrEqual(event.getLong("headroom"), event.getLong("available"), "Headroom exceeds available");
+                Asserts.assertGreaterThanOrEqual(event.getDouble("allocationRate"), 0.0, "Invalid allocation rate");
+                Asserts.assertGreaterThanOrEqual(event.getDouble("allocationRateDeviation"), 0.0, "Invalid allocation rate deviation");
+                Asserts.assertGreaterThanOrEqual(event.getFloat("confidence"), 0.0f, "Invalid confidence");
+                Asserts.assertLessThanOrEqual(event.getFloat("confidence"), 1.0f, "Invalid confidence");
+                Asserts.assertGreaterThanOrEqual(event.getFloat("requiredConfidence"), 0.5f, "Invalid required confidence");
+                Asserts.assertLessThanOrEqual(event.getFloat("requiredConfidence"), 1.0f, "Invalid required confidence");
+            }
+            Asserts.assertTrue(triggered, "Expected at least one triggered cycle");
+        }
+    }
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package jdk.jfr.event.gc.detailed;
+
+import java.util.List;
+
+import jdk.jfr.Recording;
+import jdk.jfr.consumer.RecordedEvent;
+import jdk.test.lib.Asserts;
+import jdk.test.lib.jfr.Events;
+
+/**
+ * @test TestZDirectorDecisionEvent
+ * @requires vm.hasJFR & vm.gc.Z
+ * @key jfr
+ * @library /test/lib /test/jdk /test/hotspot/jtreg
+ * @run main/othervm -XX:+UseZGC -Xmx64M -Xlog:gc*:gc.log::filecount=0 jdk.jfr.event.gc.detailed.TestZDirectorDecisionEvent
+ */
+
+public class TestZDirectorDecisionEvent {
+    private static final String EVENT_NAME = "jdk.ZDirectorDecision";
+
+    private static Object[] live = new Object[64 * 1024];
+
+    public static void main(String[] args) throws Exception {
+        try (Recording recording = new Recording()) {
+            recording.enable(EVENT_NAME);
+            recording.start();
+
+            // Alternate between phases that relocate fragmented pages and
+            // phases whose relocation sets are empty, while allocating fast
+            // enough for the director to take decisions.
+            long end = System.currentTimeMillis() + 10_000;
+            for (int phase = 0; System.currentTimeMillis() < end; phase++) {
+                for (int i = 0; i < 1_000_000; i++) {
+                    Object o = new byte[64];
+                    if (phase % 2 == 0 && i % 16 == 0) {
+                        live[(i / 16) % live.length] = o;
+                    }
+                }
+                if (phase % 2 != 0) {
+                    System.gc();
+                }
+            }
+
+            recording.stop();
+
+            List<RecordedEvent> events = Events.fromRecording(recording);
+            Events.hasEvents(events);
+            for (RecordedEvent event : events) {
+                System.out.println(event);
+                Asserts.assertGreaterThanOrEqual(event.getInt("workers"), 1, "Must select at least one worker");
+                Asserts.assertGreaterThan(event.getDouble("availableCPUs"), 0.0, "Must have available CPUs");
+                Asserts.assertGreaterThanOrEqual(event.getDouble("markThroughput"), 0.0, "Invalid mark throughput");
+                Asserts.assertGreaterThanOrEqual(event.getDouble("relocateThroughput"), 0.0, "Invalid relocate throughput");
+                // Empty relocation sets must not drive the throughput, and
+                // so the predicted GC duration, towards unbounded values.
+                Asserts.assertLessThan(event.getLong("gcDuration"), 60_000L, "GC duration prediction exploded");
+            }
+        }
+    }
+}